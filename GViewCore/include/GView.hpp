@@ -5,6 +5,9 @@
 
 #include <AppCUI/include/AppCUI.hpp>
 
+#include <array>
+#include <functional>
+
 using namespace AppCUI::Controls;
 using namespace AppCUI::Utils;
 using namespace AppCUI::Graphics;
@@ -114,8 +117,11 @@ namespace Utils
         uint64 fileSize, start, end, currentPos;
         uint8* cache;
         uint32 cacheSize;
+        void* sharedLock; // serializes the reads from fileObj once views are created over it
+        bool isView;
 
         bool CopyObject(void* buffer, uint64 offset, uint32 requestedSize);
+        bool ReadFromObject(uint64 offset, uint32 size);
 
       public:
         DataCache();
@@ -123,6 +129,9 @@ namespace Utils
         ~DataCache();
 
         bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize);
+        // a view has its own cache (same size) over the data object of 'source' => the source and its views can be used from
+        // different threads (views must be created from the thread that owns the source and must not outlive it)
+        bool InitView(DataCache& source);
         BufferView Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead);
         inline BufferView GetEntireFile()
         {
@@ -175,6 +184,16 @@ namespace Utils
     };
     CORE_EXPORT bool Demangle(std::string_view input, String& output, DemangleKind format = DemangleKind::Auto);
 
+    // number of worker threads used by ParallelFor
+    CORE_EXPORT uint32 GetWorkersCount();
+    /**
+     * \brief Runs task(index, workerIndex) for every index in [0, count) on min(GetWorkersCount(), count) worker threads.
+     * The calling thread waits for the workers and calls onWait periodically (e.g. to update a ProgressStatus).
+     * \return false if onWait returned false (the tasks not yet started are dropped), true otherwise
+     */
+    CORE_EXPORT bool ParallelFor(
+          uint32 count, const std::function<void(uint32 index, uint32 workerIndex)>& task, const std::function<bool()>& onWait = nullptr);
+
     struct CORE_EXPORT SelectionZoneInterface {
         virtual uint32 GetSelectionZonesCount() const                                    = 0;
         virtual GView::TypeInterface::SelectionZone GetSelectionZone(uint32 index) const = 0;
@@ -858,10 +877,12 @@ namespace Dissasembly
         uint8 groupsCount;
     };
 
+    class CapstoneHandle;
+
     class CORE_EXPORT DissasemblerIntel
     {
       private:
-        size_t handle{ 0 };
+        CapstoneHandle* capstone{ nullptr }; // borrowed from the handles pool of GViewCore
         Design design{ Design::Invalid };
         Architecture architecture{ Architecture ::Invalid };
         Endianess endianess{ Endianess::Invalid };
@@ -938,15 +959,131 @@ namespace Regex
         ~Matcher();
 
         bool Match(BufferView buffer, uint64& start, uint64& end);
+        // first match that starts at or after searchFrom (the bytes before it are still visible to the expression)
+        bool Match(BufferView buffer, uint64 searchFrom, uint64& start, uint64& end);
     };
 } // namespace Regex
 
 namespace Entropy
 {
+    // number of occurrences of every byte value
+    using Histogram = std::array<uint32, 256>;
+
+    CORE_EXPORT void ComputeHistogram(const BufferView& buffer, Histogram& frequency);
+    CORE_EXPORT double ShannonEntropy(const Histogram& frequency, uint64 length);
+    CORE_EXPORT double RenyiEntropy(const Histogram& frequency, uint64 length, double alpha);
+
     CORE_EXPORT double ShannonEntropy(const BufferView& buffer);
     CORE_EXPORT double RenyiEntropy(const BufferView& buffer, double alpha);
+
+    /**
+     * \brief Computes in parallel the Shannon and Renyi entropy of every block of blockSize bytes of the cache (the last block may be
+     * shorter). onProgress receives the number of blocks already computed and returns false to cancel.
+     * \return false if the computation was canceled or failed
+     */
+    CORE_EXPORT bool ComputeBlocksEntropy(
+          Utils::DataCache& cache,
+          uint32 blockSize,
+          double renyiAlpha,
+          std::vector<float>& shannon,
+          std::vector<float>& renyi,
+          const std::function<bool(uint64 blocksComputed)>& onProgress = nullptr);
+    /**
+     * \brief Computes in parallel the histogram of every block of blockSize bytes of the cache (the last block may be shorter). The
+     * entropy of the blocks of any multiple of blockSize is then computed by adding the histograms, without reading the cache again.
+     * \return false if the computation was canceled or failed
+     */
+    CORE_EXPORT bool ComputeBlocksHistograms(
+          Utils::DataCache& cache,
+          uint32 blockSize,
+          std::vector<Histogram>& histograms,
+          const std::function<bool(uint64 blocksComputed)>& onProgress = nullptr);
 } // namespace Entropy
 
+namespace DelimitedText
+{
+    constexpr uint32 BLOCK_SIZE = 64;
+
+    // bit i is set if byte i of a block is a quote, the separator, a '\n' or a '\r'
+    struct BlockMasks {
+        uint64 quotes;
+        uint64 separators;
+        uint64 lineFeeds;
+        uint64 carriageReturns;
+    };
+
+    /**
+     * \brief Classifies up to BLOCK_SIZE bytes, 8 bytes at a time (every comparison is done on a whole 64 bit word).
+     */
+    CORE_EXPORT void ClassifyBlock(const uint8* data, uint32 size, uint8 separator, BlockMasks& masks);
+    /**
+     * \brief Bit i is set if byte i of a block is inside quotes (every quote toggles the quoted state, an opening quote is inside).
+     * \param inQuotes the state before the block, it is updated to the state after the block
+     */
+    CORE_EXPORT uint64 GetQuotedMask(uint64 quotes, bool& inQuotes);
+    /**
+     * \brief The value of a field without the spaces / tabs around it and without its quotes. A value that starts with a quote but
+     * does not end with one (e.g. the start of a long value) loses only its first quote.
+     */
+    CORE_EXPORT std::string_view TrimValue(std::string_view value);
+    /**
+     * \brief Parses a decimal number ([-]digits[.digits][e[+/-]digits], at most 256 characters) the same way on every platform.
+     * \return false if the whole value is not such a number or if it is not finite
+     */
+    CORE_EXPORT bool ParseNumber(std::string_view value, double& number);
+
+    /**
+     * \brief Rows and fields of a delimited text (CSV, TSV, ...) kept in flat arrays: for every row its start offset and, for every
+     * field, its start relative to the row => 4 bytes for every cell. A quote toggles the quoted state (a doubled quote toggles it
+     * twice), separators and new lines inside quotes are part of the field. '\n', '\r' and "\r\n" end a row (an empty line is an
+     * empty row). The content is read as a stream, so a row can be bigger than the cache. Every quote toggles the state => the state
+     * at any offset depends only on the number of quotes before it, so the content is split in chunks that are indexed in parallel
+     * once the quotes of the previous chunks are counted.
+     */
+    class CORE_EXPORT Index
+    {
+        std::vector<uint64> rowStarts;    // rowsCount + 1 entries, the last one is the size of the content
+        std::vector<uint64> rowFields;    // rowsCount + 1 entries, the index of the first field of every row in fieldOffsets
+        std::vector<uint32> fieldOffsets; // relative to the row start, every row ends with (end of its content + separator size)
+        std::string separator{ "," };
+
+      public:
+        void Clear();
+        // separator can have more than one byte, but it can not contain quotes or new lines
+        bool Build(Utils::DataCache& cache, std::string_view separator, const std::function<bool(uint64 bytesProcessed)>& onProgress = nullptr);
+
+        std::string_view GetSeparator() const
+        {
+            return separator;
+        }
+        uint64 GetRowsCount() const
+        {
+            return rowStarts.empty() ? 0 : rowStarts.size() - 1;
+        }
+        uint32 GetFieldsCount(uint64 row) const
+        {
+            return row < GetRowsCount() ? static_cast<uint32>(rowFields[row + 1] - rowFields[row] - 1) : 0;
+        }
+        // [start, end) of the field without the separator (a quoted field includes its quotes)
+        bool GetField(uint64 row, uint32 field, uint64& start, uint64& end) const
+        {
+            CHECK(field < GetFieldsCount(row), false, "");
+            const auto index = rowFields[row] + field;
+            start            = rowStarts[row] + fieldOffsets[index];
+            end              = rowStarts[row] + fieldOffsets[index + 1] - separator.size();
+            return true;
+        }
+        // [start, end) of the row without its new line
+        bool GetRow(uint64 row, uint64& start, uint64& end) const
+        {
+            CHECK(row < GetRowsCount(), false, "");
+            start = rowStarts[row];
+            end   = rowStarts[row] + fieldOffsets[rowFields[row + 1] - 1] - separator.size();
+            return true;
+        }
+    };
+} // namespace DelimitedText
+
 /*
  * Object can be:
  *   - a file
@@ -1264,14 +1401,43 @@ namespace View
           protected:
             bool Grow(size_t size);
 
+            // while a batch is open the text is a piece table over the flat buffer (original) and the "added" buffer
+            // edits only split/insert/erase pieces; the flat buffer is rebuilt once, when the batch is committed
+            // (or earlier, if someone needs direct access to the characters)
+            struct Piece {
+                uint32 start;
+                uint32 length;
+                bool added;
+            };
+
+            uint32 FindPiece(uint32 offset);
+            uint32 SplitPieceAt(uint32 offset);
+            bool InsertPiece(uint32 offset, std::u16string_view text);
+            void ErasePieces(uint32 offset, uint32 count);
+            void ResetPieces();
+            bool Flatten();
+            void EndAllBatches();
+
           protected:
             char16* text;
             uint32 size;
             uint32 allocated;
 
+            std::vector<Piece> pieces;
+            std::u16string added;
+            uint32 batchLevel;
+            uint32 cursorPiece; // last located piece (edits from plugins usually move forward through the text)
+            uint32 cursorStart; // offset (in the edited text) of the cursor piece
+
             TextEditor();
 
           public:
+            // edits done between BeginBatch and CommitBatch are not applied on the flat buffer until the (outermost) commit
+            // batches can be nested; direct accesses (operator[], string view conversion, Find, ...) flatten the text on demand
+            void BeginBatch();
+            bool CommitBatch();
+            bool GetText(uint32 offset, uint32 charactersCount, std::u16string& result);
+
             bool Insert(uint32 offset, std::string_view text);
             bool Insert(uint32 offset, std::u16string_view text);
             bool InsertChar(uint32 offset, char16 ch);
@@ -1295,8 +1461,9 @@ namespace View
             {
                 return size;
             }
-            inline operator u16string_view() const
+            inline operator u16string_view()
             {
+                Flatten();
                 return { text, (size_t) size };
             }
         };
@@ -1569,6 +1736,10 @@ namespace View
             Settings();
 
             void SetSeparator(char separator[2]);
+            // a separator of one or more characters (e.g. "||"), it can not contain quotes or new lines
+            void SetSeparator(std::string_view separator);
+            // an index already built over the object (its separator is used) => the viewer does not parse the object again
+            void SetIndex(DelimitedText::Index&& index);
             bool SetName(std::string_view name);
         };
     }; // namespace GridViewer
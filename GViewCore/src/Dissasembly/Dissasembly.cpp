@@ -1,8 +1,150 @@
 #include "Internal.hpp"
 #include <capstone/capstone.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace GView::Dissasembly
 {
+// idle handles kept for every configuration - more than this are closed when they are given back
+constexpr size_t MAX_IDLE_HANDLES_PER_CONFIGURATION = 8;
+
+class CapstoneHandlesPool
+{
+    struct Entry {
+        csh handle;
+        cs_insn* insn;
+    };
+
+    std::mutex lock;
+    std::unordered_map<uint64, std::vector<Entry>> idle;
+
+  public:
+    ~CapstoneHandlesPool()
+    {
+        for (auto& [key, entries] : idle) {
+            for (auto& entry : entries) {
+                cs_free(entry.insn, 1);
+                cs_close(&entry.handle);
+            }
+        }
+    }
+
+    static uint64 GetKey(cs_arch arch, cs_mode mode, bool detail)
+    {
+        // cs_mode is a 32 bits mask
+        return (static_cast<uint64>(arch) << 33) | (static_cast<uint64>(detail) << 32) | static_cast<uint32>(mode);
+    }
+
+    cs_err Acquire(uint64 key, csh& handle, cs_insn*& insn)
+    {
+        {
+            std::scoped_lock guard(lock);
+            auto it = idle.find(key);
+            if (it != idle.end() && !it->second.empty()) {
+                handle = it->second.back().handle;
+                insn   = it->second.back().insn;
+                it->second.pop_back();
+                return CS_ERR_OK;
+            }
+        }
+
+        const auto arch   = static_cast<cs_arch>(key >> 33);
+        const auto detail = ((key >> 32) & 1) != 0;
+        const auto mode   = static_cast<cs_mode>(key & 0xFFFFFFFF);
+
+        auto result = cs_open(arch, mode, &handle);
+        if (result != CS_ERR_OK) {
+            return result;
+        }
+        if (detail) {
+            result = cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+            if (result != CS_ERR_OK) {
+                cs_close(&handle);
+                return result;
+            }
+        }
+        insn = cs_malloc(handle);
+        if (insn == nullptr) {
+            cs_close(&handle);
+            return CS_ERR_MEM;
+        }
+        return CS_ERR_OK;
+    }
+
+    void Release(uint64 key, csh handle, cs_insn* insn)
+    {
+        {
+            std::scoped_lock guard(lock);
+            auto& entries = idle[key];
+            if (entries.size() < MAX_IDLE_HANDLES_PER_CONFIGURATION) {
+                entries.push_back({ handle, insn });
+                return;
+            }
+        }
+        cs_free(insn, 1);
+        cs_close(&handle);
+    }
+};
+
+static CapstoneHandlesPool& GetCapstoneHandlesPool()
+{
+    static CapstoneHandlesPool pool;
+    return pool;
+}
+
+CapstoneHandle::CapstoneHandle(cs_arch arch, cs_mode mode, bool detail) : key(CapstoneHandlesPool::GetKey(arch, mode, detail))
+{
+    error = GetCapstoneHandlesPool().Acquire(key, handle, insn);
+    if (error != CS_ERR_OK) {
+        handle = 0;
+        insn   = nullptr;
+    }
+}
+
+CapstoneHandle::~CapstoneHandle()
+{
+    if (insn != nullptr) {
+        GetCapstoneHandlesPool().Release(key, handle, insn);
+    }
+}
+
+bool CapstoneHandle::DissasembleNext(const uint8*& code, size_t& size, uint64& address)
+{
+    CHECK(insn != nullptr, false, "");
+    return cs_disasm_iter(handle, &code, &size, &address, insn);
+}
+
+uint32 CapstoneHandle::DissasembleBatch(const uint8*& code, size_t& size, uint64& address, uint32 maxCount, InstructionsBatch& batch)
+{
+    CHECK(insn != nullptr, 0, "");
+    batch.Reserve(batch.count + maxCount);
+
+    uint32 decoded = 0;
+    while (decoded < maxCount && cs_disasm_iter(handle, &code, &size, &address, insn)) {
+        const auto index       = batch.count++;
+        batch.addresses[index] = insn->address;
+        batch.sizes[index]     = insn->size;
+        batch.ids[index]       = insn->id;
+        memcpy(batch.mnemonics.data() + static_cast<size_t>(index) * MNEMONIC_SIZE, insn->mnemonic, MNEMONIC_SIZE);
+        memcpy(batch.opStrs.data() + static_cast<size_t>(index) * OP_STR_SIZE, insn->op_str, OP_STR_SIZE);
+        decoded++;
+    }
+    return decoded;
+}
+
+void InstructionsBatch::Reserve(uint32 instructionsCount)
+{
+    if (addresses.size() >= instructionsCount) {
+        return;
+    }
+    addresses.resize(instructionsCount);
+    sizes.resize(instructionsCount);
+    ids.resize(instructionsCount);
+    mnemonics.resize(static_cast<size_t>(instructionsCount) * MNEMONIC_SIZE);
+    opStrs.resize(static_cast<size_t>(instructionsCount) * OP_STR_SIZE);
+}
+
 void InstructionToInstruction(const cs_insn& insn, Instruction& instruction)
 {
     instruction.id      = insn.id;
@@ -23,9 +165,9 @@ bool DissasemblerIntel::Init(Design design, Architecture architecture, Endianess
     this->architecture = architecture;
     this->endianess    = endianess;
 
-    if (handle != 0) {
-        CHECK(cs_close(&handle) == CS_ERR_OK, false, "");
-        handle = 0;
+    if (capstone != nullptr) {
+        delete capstone;
+        capstone = nullptr;
     }
 
     cs_arch arch = (cs_arch) 0;
@@ -86,45 +228,37 @@ bool DissasemblerIntel::Init(Design design, Architecture architecture, Endianess
         break;
     }
 
-    const auto result = cs_open(arch, mode, &handle);
-    CHECK(result == CS_ERR_OK, false, "Error: %u!", result);
-    const auto resultOption = cs_option(handle, cs_opt_type::CS_OPT_DETAIL, CS_OPT_ON);
-    CHECK(resultOption == CS_ERR_OK, false, "Error: %u!", result);
+    capstone = new CapstoneHandle(arch, mode, true);
+    CHECK(capstone->IsValid(), false, "Error: %u!", capstone->GetError());
 
     return true;
 }
 
 bool DissasemblerIntel::DissasembleInstruction(BufferView buf, uint64 va, Instruction& instruction)
 {
-    CHECK(handle != 0, false, "");
-
-    cs_detail detail{};
-    cs_insn insn{ .detail = &detail };
+    CHECK(capstone != nullptr && capstone->IsValid(), false, "");
 
     auto data   = buf.GetData();
     auto length = buf.GetLength();
 
     uint64 address = va;
-    CHECK(cs_disasm_iter(handle, &data, &length, &address, &insn), false, "");
-    InstructionToInstruction(insn, instruction);
+    CHECK(capstone->DissasembleNext(data, length, address), false, "");
+    InstructionToInstruction(*capstone->GetInstruction(), instruction);
 
     return true;
 }
 
 bool DissasemblerIntel::DissasembleInstructions(BufferView buf, uint64 va, std::vector<Instruction>& instructions)
 {
-    CHECK(handle != 0, false, "");
-
-    cs_detail detail{};
-    cs_insn insn{ .detail = &detail };
+    CHECK(capstone != nullptr && capstone->IsValid(), false, "");
 
     auto data    = buf.GetData();
     auto length  = buf.GetLength();
     auto address = va;
 
-    while (cs_disasm_iter(handle, &data, &length, &address, &insn)) {
+    while (capstone->DissasembleNext(data, length, address)) {
         auto& instruction = instructions.emplace_back();
-        InstructionToInstruction(insn, instruction);
+        InstructionToInstruction(*capstone->GetInstruction(), instruction);
     }
 
     return true;
@@ -132,7 +266,8 @@ bool DissasemblerIntel::DissasembleInstructions(BufferView buf, uint64 va, std::
 
 std::string_view DissasemblerIntel::GetInstructionGroupName(uint8 groupID) const
 {
-    const auto name = cs_group_name(handle, groupID);
+    CHECK(capstone != nullptr && capstone->IsValid(), "", "");
+    const auto name = cs_group_name(capstone->GetHandle(), groupID);
     if (name == nullptr) {
         return "";
     }
@@ -290,7 +425,7 @@ bool DissasemblerIntel::IsFunctionEndInstruction(const Instruction& instruction)
 
 DissasemblerIntel::~DissasemblerIntel()
 {
-    CHECKRET(cs_close(&handle) == CS_ERR_OK, "");
-    handle = 0;
+    delete capstone;
+    capstone = nullptr;
 }
 } // namespace GView::Dissasembly
@@ -2,18 +2,61 @@
 
 #include <math.h>
 #include <array>
+#include <atomic>
 
-constexpr uint32 MAX_NUMBER_OF_BYTES = 256;
+constexpr uint32 MAX_NUMBER_OF_BYTES           = 256;
+constexpr uint32 SPLIT_HISTOGRAMS_MIN_SIZE     = 1024; // below this, clearing the split histograms costs more than it saves
+constexpr uint32 F_LOG2_F_TABLE_SIZE           = 4096;
+constexpr uint64 BLOCKS_ENTROPY_BYTES_PER_TASK = 4 * 1024 * 1024;
 
 namespace GView::Entropy
 {
-void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+static void AddToHistogram(const uint8* data, size_t size, Histogram& frequency)
 {
-    // Count frequency of each byte in the buffer
-    for (uint32 i = 0; i < buffer.GetLength(); i++) {
-        const auto c = buffer[i];
-        frequency[c]++;
+    if (size < SPLIT_HISTOGRAMS_MIN_SIZE) {
+        for (size_t i = 0; i < size; i++) {
+            frequency[data[i]]++;
+        }
+        return;
+    }
+
+    // consecutive equal bytes would increment the same counter back to back (each increment waiting for the previous store)
+    // => 4 interleaved histograms, merged at the end
+    std::array<std::array<uint32, MAX_NUMBER_OF_BYTES>, 4> split{};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        split[0][data[i]]++;
+        split[1][data[i + 1]]++;
+        split[2][data[i + 2]]++;
+        split[3][data[i + 3]]++;
     }
+    for (; i < size; i++) {
+        split[0][data[i]]++;
+    }
+    for (uint32 j = 0; j < MAX_NUMBER_OF_BYTES; j++) {
+        frequency[j] += split[0][j] + split[1][j] + split[2][j] + split[3][j];
+    }
+}
+
+void ComputeHistogram(const BufferView& buffer, Histogram& frequency)
+{
+    frequency.fill(0);
+    if (buffer.IsValid()) {
+        AddToHistogram(buffer.GetData(), buffer.GetLength(), frequency);
+    }
+}
+
+// f * log2(f) for the small counts, which are the most frequent ones
+static const std::array<double, F_LOG2_F_TABLE_SIZE>& GetFLog2FTable()
+{
+    static const auto table = []() {
+        std::array<double, F_LOG2_F_TABLE_SIZE> values{};
+        for (uint32 f = 1; f < F_LOG2_F_TABLE_SIZE; f++) {
+            values[f] = f * log2(static_cast<double>(f));
+        }
+        return values;
+    }();
+    return table;
 }
 
 /*
@@ -26,26 +69,31 @@ void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYT
 
     The joint entropy of variables X_1, ..., X_n is then defined by
     H(X_1, ..., X_n) congruent - sum_(x_1) ... sum_(x_n) P(x_1, ..., x_n) log_2[P(x_1, ..., x_n)].
+
+    With P(x) = f(x) / n this is the same as log_2(n) - sum_x f(x) log_2[f(x)] / n, so the -P log_2 P terms are
+    read from a table of f log_2 f indexed by the count instead of computing a logarithm for every byte value.
 */
-double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+double ShannonEntropy(const Histogram& frequency, uint64 length)
 {
-    double entropy = 0.0;
-    for (auto f : frequency) {
-        if (f == 0) {
-            continue;
-        }
-        double probability = static_cast<double>(f) / buffer.GetLength();
-        entropy -= probability * log2(probability);
+    if (length == 0) {
+        return 0.0;
     }
 
-    return entropy; // max log2(n) = 8 (the entire sum)
+    const auto& table = GetFLog2FTable();
+    double sum        = 0.0;
+    for (const auto f : frequency) {
+        sum += f < F_LOG2_F_TABLE_SIZE ? table[f] : f * log2(static_cast<double>(f));
+    }
+
+    const double entropy = log2(static_cast<double>(length)) - sum / length;
+    return entropy > 0.0 ? entropy : 0.0; // max log2(n) = 8 (the entire sum)
 }
 
 double ShannonEntropy(const BufferView& buffer)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-    return ShannonEntropy_private(buffer, frequency);
+    Histogram frequency;
+    ComputeHistogram(buffer, frequency);
+    return ShannonEntropy(frequency, buffer.GetLength());
 }
 
 /*
@@ -56,19 +104,19 @@ double ShannonEntropy(const BufferView& buffer)
     H_α(p_1, p_2, ..., p_n)<=H_α'(p_1, p_2, ..., p_n)
     for α<=α'.
 */
-double RenyiEntropy(const BufferView& buffer, double alpha)
+double RenyiEntropy(const Histogram& frequency, uint64 length, double alpha)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-
     if (alpha == 1.0) {
-        return ShannonEntropy_private(buffer, frequency);
+        return ShannonEntropy(frequency, length);
+    }
+    if (length == 0) {
+        return 0.0;
     }
 
     double sum = 0.0;
     for (auto f : frequency) {
         if (f > 0) {
-            const double probability = static_cast<double>(f) / buffer.GetLength();
+            const double probability = static_cast<double>(f) / length;
             sum += pow(probability, alpha);
         }
     }
@@ -77,4 +125,101 @@ double RenyiEntropy(const BufferView& buffer, double alpha)
     // return std::max(((1.0 / (1.0 - alpha)) * log(sum)) / log(2), 0.0);
     return ((1.0 / (1.0 - alpha)) * log(sum)) / log(2);
 }
+
+double RenyiEntropy(const BufferView& buffer, double alpha)
+{
+    Histogram frequency;
+    ComputeHistogram(buffer, frequency);
+    return RenyiEntropy(frequency, buffer.GetLength(), alpha);
+}
+
+// runs onBlock(block, frequency, length) in parallel for every block of blockSize bytes of the cache
+template <typename OnBlock>
+static bool ForEachBlockHistogram(
+      Utils::DataCache& cache, uint32 blockSize, OnBlock onBlock, const std::function<bool(uint64 blocksComputed)>& onProgress)
+{
+    const uint64 size        = cache.GetSize();
+    const uint64 blocksCount = (size + blockSize - 1) / blockSize;
+    if (blocksCount == 0) {
+        return true;
+    }
+
+    // every task handles a few MB of consecutive blocks
+    const uint64 blocksPerTask = std::max<uint64>(BLOCKS_ENTROPY_BYTES_PER_TASK / blockSize, 1);
+    const uint64 tasksCount    = (blocksCount + blocksPerTask - 1) / blocksPerTask;
+    CHECK(tasksCount <= 0xFFFFFFFF, false, "");
+
+    // every worker reads through its own view of the cache
+    const auto workersCount = std::min<uint32>(Utils::GetWorkersCount(), static_cast<uint32>(tasksCount));
+    std::vector<Utils::DataCache> views(workersCount);
+    for (auto& view : views) {
+        CHECK(view.InitView(cache), false, "");
+    }
+
+    std::atomic<uint64> blocksComputed{ 0 };
+    std::atomic<bool> failed{ false };
+    const bool completed = Utils::ParallelFor(
+          static_cast<uint32>(tasksCount),
+          [&](uint32 index, uint32 workerIndex) {
+              auto& view             = views[workerIndex];
+              const uint64 readLimit = std::max<uint32>(view.GetCacheSize(), 1);
+              const uint64 first     = index * blocksPerTask;
+              const uint64 last      = std::min<uint64>(first + blocksPerTask, blocksCount);
+              Histogram frequency;
+              for (uint64 block = first; block < last; block++) {
+                  const uint64 start  = block * blockSize;
+                  const uint64 length = std::min<uint64>(blockSize, size - start);
+
+                  // blocks larger than the cache are read in pieces
+                  frequency.fill(0);
+                  for (uint64 offset = 0; offset < length;) {
+                      const auto buffer = view.Get(start + offset, static_cast<uint32>(std::min<uint64>(length - offset, readLimit)), false);
+                      if (buffer.GetLength() == 0) {
+                          failed.store(true, std::memory_order_relaxed);
+                          return;
+                      }
+                      AddToHistogram(buffer.GetData(), buffer.GetLength(), frequency);
+                      offset += buffer.GetLength();
+                  }
+                  onBlock(block, frequency, length);
+              }
+              blocksComputed.fetch_add(last - first, std::memory_order_relaxed);
+          },
+          [&]() { return onProgress == nullptr || onProgress(blocksComputed.load(std::memory_order_relaxed)); });
+
+    return completed && !failed.load(std::memory_order_relaxed);
+}
+
+bool ComputeBlocksEntropy(
+      Utils::DataCache& cache,
+      uint32 blockSize,
+      double renyiAlpha,
+      std::vector<float>& shannon,
+      std::vector<float>& renyi,
+      const std::function<bool(uint64 blocksComputed)>& onProgress)
+{
+    CHECK(blockSize > 0, false, "");
+    const uint64 blocksCount = (cache.GetSize() + blockSize - 1) / blockSize;
+    shannon.assign(blocksCount, 0.0f);
+    renyi.assign(blocksCount, 0.0f);
+
+    return ForEachBlockHistogram(
+          cache,
+          blockSize,
+          [&](uint64 block, const Histogram& frequency, uint64 length) {
+              shannon[block] = static_cast<float>(ShannonEntropy(frequency, length));
+              renyi[block]   = static_cast<float>(RenyiEntropy(frequency, length, renyiAlpha));
+          },
+          onProgress);
+}
+
+bool ComputeBlocksHistograms(
+      Utils::DataCache& cache, uint32 blockSize, std::vector<Histogram>& histograms, const std::function<bool(uint64 blocksComputed)>& onProgress)
+{
+    CHECK(blockSize > 0, false, "");
+    histograms.resize((cache.GetSize() + blockSize - 1) / blockSize);
+
+    return ForEachBlockHistogram(
+          cache, blockSize, [&](uint64 block, const Histogram& frequency, uint64) { histograms[block] = frequency; }, onProgress);
+}
 } // namespace GView::Entropy
@@ -18,6 +18,10 @@ bool Matcher::Init(std::string_view expression, bool isUnicode, bool isCaseSensi
     RE2::Options options;
     options.set_case_sensitive(isCaseSensitive);
     options.set_longest_match(false);
+    if (!isUnicode) {
+        // raw bytes => every byte is a character (in UTF-8 mode bytes >= 0x80 and invalid sequences would not match)
+        options.set_encoding(RE2::Options::EncodingLatin1);
+    }
 
     absl::string_view asv{ expression.data(), expression.size() };
 
@@ -29,7 +33,7 @@ bool Matcher::Init(std::string_view expression, bool isUnicode, bool isCaseSensi
 
     this->context = c;
 
-    return true;
+    return c->expression.ok();
 }
 
 Matcher::~Matcher()
@@ -55,4 +59,22 @@ bool Matcher::Match(BufferView buffer, uint64& start, uint64& end)
 
     return false;
 }
+
+bool Matcher::Match(BufferView buffer, uint64 searchFrom, uint64& start, uint64& end)
+{
+    auto ctx = reinterpret_cast<Context*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(ctx->expression.ok(), false, "");
+    CHECK(searchFrom <= buffer.GetLength(), false, "");
+
+    absl::string_view sv{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+    re2::StringPiece result;
+    if (ctx->expression.Match(sv, static_cast<size_t>(searchFrom), sv.size(), RE2::UNANCHORED, &result, 1)) {
+        start = result.data() - sv.data();
+        end   = start + result.size();
+        return true;
+    }
+
+    return false;
+}
 } // namespace GView::Regex
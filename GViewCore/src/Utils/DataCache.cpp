@@ -1,5 +1,7 @@
 #include "GView.hpp"
 
+#include <mutex>
+
 using namespace GView::Utils;
 
 constexpr uint32 MAX_CACHE_SIZE = 0x20000000U; // 16 M
@@ -13,6 +15,8 @@ DataCache::DataCache()
     this->end        = 0;
     this->fileSize   = 0;
     this->currentPos = 0;
+    this->sharedLock = nullptr;
+    this->isView     = false;
 }
 DataCache::DataCache(DataCache&& obj)
 {
@@ -23,6 +27,8 @@ DataCache::DataCache(DataCache&& obj)
     currentPos     = obj.currentPos;
     cache          = obj.cache;
     cacheSize      = obj.cacheSize;
+    sharedLock     = obj.sharedLock;
+    isView         = obj.isView;
     obj.fileObj    = nullptr;
     obj.fileSize   = 0;
     obj.start      = 0;
@@ -30,15 +36,20 @@ DataCache::DataCache(DataCache&& obj)
     obj.currentPos = 0;
     obj.cache      = nullptr;
     obj.cacheSize  = 0;
+    obj.sharedLock = nullptr;
+    obj.isView     = false;
 }
 DataCache::~DataCache()
 {
-    if (this->fileObj)
+    if (this->fileObj && !this->isView)
     {
         this->fileObj->Close();
         delete this->fileObj;
     }
     this->fileObj = nullptr;
+    if (this->sharedLock && !this->isView)
+        delete reinterpret_cast<std::mutex*>(this->sharedLock);
+    this->sharedLock = nullptr;
     if (this->cache)
         delete[] this->cache;
     this->cache = nullptr;
@@ -63,6 +74,35 @@ bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cache
 
     return true;
 }
+bool DataCache::InitView(DataCache& source)
+{
+    CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
+    CHECK(source.fileObj, false, "Source cache was not properly initialized !");
+    CHECK(!source.isView, false, "A view can not be created from another view !");
+    if (source.sharedLock == nullptr)
+        source.sharedLock = new std::mutex();
+
+    this->cache = new uint8[source.cacheSize];
+    CHECK(this->cache, false, "Fail to allocate: %u bytes", source.cacheSize);
+    this->fileObj    = source.fileObj;
+    this->fileSize   = source.fileSize;
+    this->sharedLock = source.sharedLock;
+    this->isView     = true;
+    this->cacheSize  = source.cacheSize;
+    this->start      = 0;
+    this->end        = 0;
+
+    return true;
+}
+bool DataCache::ReadFromObject(uint64 offset, uint32 size)
+{
+    if (this->sharedLock)
+    {
+        std::scoped_lock lock(*reinterpret_cast<std::mutex*>(this->sharedLock));
+        return this->fileObj->SetCurrentPos(offset) && this->fileObj->Read(this->cache, size);
+    }
+    return this->fileObj->SetCurrentPos(offset) && this->fileObj->Read(this->cache, size);
+}
 BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
 {
     CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
@@ -114,9 +154,7 @@ BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfReques
             _end = this->fileSize;
     }
     // read new data in cache
-    if (this->fileObj->SetCurrentPos(_start) == false)
-        return BufferView();
-    if (this->fileObj->Read(this->cache, (uint32) (_end - _start)) == false)
+    if (ReadFromObject(_start, (uint32) (_end - _start)) == false)
     {
         this->start = 0;
         this->end   = 0;
@@ -0,0 +1,396 @@
+#include "GView.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+constexpr uint64 SWAR_LOW_7_BITS  = 0x7F7F7F7F7F7F7F7FULL;
+constexpr uint64 SWAR_HIGH_BITS   = 0x8080808080808080ULL;
+constexpr uint64 SWAR_EVERY_BYTE  = 0x0101010101010101ULL;
+constexpr uint64 SWAR_GATHER_BITS = 0x0002040810204081ULL;
+
+constexpr uint64 INDEX_CHUNK_MIN_SIZE    = 4 * 1024 * 1024; // smaller contents are indexed by a single worker
+constexpr uint32 INDEX_CHUNKS_PER_WORKER = 4;
+constexpr uint8 QUOTE                    = '"';
+constexpr size_t NUMBER_MAX_SIZE         = 256;
+
+namespace GView::DelimitedText
+{
+// 8 bits mask (bit i = byte i) of the bytes of word equal to value
+static inline uint64 GetEqualBytesMask(uint64 word, uint64 broadcastValue)
+{
+    const uint64 x = word ^ broadcastValue; // equal bytes are 0
+    // the high bit of every byte is set if the byte is 0 (no carry between the bytes => exact)
+    const uint64 zeros = ~(((x & SWAR_LOW_7_BITS) + SWAR_LOW_7_BITS) | x | SWAR_LOW_7_BITS);
+    // bit 7 of byte i is moved to bit 56 + i (the products do not overlap => no carry)
+    return (zeros * SWAR_GATHER_BITS) >> 56;
+}
+
+void ClassifyBlock(const uint8* data, uint32 size, uint8 separator, BlockMasks& masks)
+{
+    masks = {};
+
+    const uint64 quotes          = SWAR_EVERY_BYTE * '"';
+    const uint64 separators      = SWAR_EVERY_BYTE * separator;
+    const uint64 lineFeeds       = SWAR_EVERY_BYTE * '\n';
+    const uint64 carriageReturns = SWAR_EVERY_BYTE * '\r';
+
+    size     = std::min<uint32>(size, BLOCK_SIZE);
+    uint32 i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64 word;
+        memcpy(&word, data + i, sizeof(word)); // little endian => byte i is the lowest one
+        masks.quotes |= GetEqualBytesMask(word, quotes) << i;
+        masks.separators |= GetEqualBytesMask(word, separators) << i;
+        masks.lineFeeds |= GetEqualBytesMask(word, lineFeeds) << i;
+        masks.carriageReturns |= GetEqualBytesMask(word, carriageReturns) << i;
+    }
+    for (; i < size; i++) {
+        const uint64 bit = 1ULL << i;
+        masks.quotes |= data[i] == '"' ? bit : 0;
+        masks.separators |= data[i] == separator ? bit : 0;
+        masks.lineFeeds |= data[i] == '\n' ? bit : 0;
+        masks.carriageReturns |= data[i] == '\r' ? bit : 0;
+    }
+}
+
+uint64 GetQuotedMask(uint64 quotes, bool& inQuotes)
+{
+    // prefix xor => bit i is the parity of the quotes in [0, i]
+    uint64 quoted = quotes;
+    quoted ^= quoted << 1;
+    quoted ^= quoted << 2;
+    quoted ^= quoted << 4;
+    quoted ^= quoted << 8;
+    quoted ^= quoted << 16;
+    quoted ^= quoted << 32;
+    if (inQuotes) {
+        quoted = ~quoted;
+    }
+    inQuotes = inQuotes ^ ((std::popcount(quotes) & 1) != 0);
+    return quoted;
+}
+
+std::string_view TrimValue(std::string_view value)
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+        value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+        value.remove_suffix(1);
+    if (!value.empty() && value.front() == QUOTE) {
+        value.remove_prefix(1);
+        if (!value.empty() && value.back() == QUOTE)
+            value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool ParseNumber(std::string_view value, double& number)
+{
+    CHECK(!value.empty() && value.size() <= NUMBER_MAX_SIZE, false, "");
+
+    // the syntax is checked here => strtod does not accept hex values, "inf", "nan" or white spaces
+    const auto isDigit = [&](size_t position) { return position < value.size() && value[position] >= '0' && value[position] <= '9'; };
+    size_t position    = value[0] == '-' ? 1 : 0;
+    size_t digits      = 0;
+    for (; isDigit(position); position++)
+        digits++;
+    if (position < value.size() && value[position] == '.') {
+        for (position++; isDigit(position); position++)
+            digits++;
+    }
+    CHECK(digits > 0, false, "");
+    if (position < value.size() && (value[position] == 'e' || value[position] == 'E')) {
+        position++;
+        if (position < value.size() && (value[position] == '+' || value[position] == '-'))
+            position++;
+        CHECK(isDigit(position), false, "");
+        while (isDigit(position))
+            position++;
+    }
+    CHECK(position == value.size(), false, "");
+
+    char buffer[NUMBER_MAX_SIZE + 1];
+    memcpy(buffer, value.data(), value.size());
+    buffer[value.size()] = 0;
+    number               = strtod(buffer, nullptr);
+    return std::isfinite(number);
+}
+
+struct IndexedChunk {
+    uint64 start{ 0 };
+    uint64 end{ 0 };
+    uint64 quotesCount{ 0 };
+    bool inQuotes{ false };                      // state at start
+    uint8 previousByte{ 0 };                     // the byte before start
+    std::vector<std::pair<uint64, uint64>> rows; // end of the content of a row, start of the next row
+    std::vector<uint64> fields;                  // start of every field but the first one of a row
+};
+
+// KMP matching (used for separators of more than one byte) => a separator that starts in one read and ends in the next one is still found
+class SeparatorMatcher
+{
+    std::string_view separator;
+    std::vector<uint32> fallback;
+    uint32 matched{ 0 };
+
+  public:
+    SeparatorMatcher(std::string_view separator) : separator(separator), fallback(separator.size(), 0)
+    {
+        for (uint32 i = 1, k = 0; i < separator.size(); i++) {
+            while (k > 0 && separator[i] != separator[k])
+                k = fallback[k - 1];
+            if (separator[i] == separator[k])
+                k++;
+            fallback[i] = k;
+        }
+    }
+    void Reset()
+    {
+        matched = 0;
+    }
+    // true if a separator ends with this byte
+    bool Next(uint8 value)
+    {
+        while (matched > 0 && static_cast<uint8>(separator[matched]) != value)
+            matched = fallback[matched - 1];
+        if (static_cast<uint8>(separator[matched]) == value)
+            matched++;
+        if (matched < separator.size())
+            return false;
+        matched = 0; // separators do not overlap
+        return true;
+    }
+};
+
+static bool CountQuotes(Utils::DataCache& cache, IndexedChunk& chunk)
+{
+    const uint64 readSize = std::max<uint32>(cache.GetCacheSize(), 1);
+    for (uint64 offset = chunk.start; offset < chunk.end;) {
+        const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(readSize, chunk.end - offset)), false);
+        CHECK(buffer.GetLength() > 0, false, "");
+        chunk.quotesCount += std::count(buffer.GetData(), buffer.GetData() + buffer.GetLength(), QUOTE);
+        offset += buffer.GetLength();
+    }
+    return true;
+}
+
+static bool IndexChunk(
+      Utils::DataCache& cache,
+      std::string_view separator,
+      bool isLast,
+      IndexedChunk& chunk,
+      std::atomic<uint64>& bytesProcessed,
+      const std::atomic<bool>& stop)
+{
+    SeparatorMatcher matcher(separator);
+    const uint64 readSize = std::max<uint32>(cache.GetCacheSize(), 1);
+    bool inQuotes         = chunk.inQuotes;
+    // '\r' does not change the quoted state => a '\r' right before the chunk was outside quotes if the chunk starts outside them
+    bool pendingCR = chunk.start > 0 && chunk.previousByte == '\r' && !inQuotes;
+
+    for (uint64 offset = chunk.start; offset < chunk.end;) {
+        CHECK(stop.load(std::memory_order_relaxed) == false, false, "");
+        const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(readSize, chunk.end - offset)), false);
+        CHECK(buffer.GetLength() > 0, false, "");
+
+        const auto data = buffer.GetData();
+        if (separator.size() == 1) {
+            // quotes, separators and new lines are found 64 bytes at a time
+            for (uint32 i = 0; i < buffer.GetLength(); i += BLOCK_SIZE) {
+                const uint32 blockSize = std::min<uint32>(BLOCK_SIZE, buffer.GetLength() - i);
+                const uint64 position  = offset + i;
+                BlockMasks masks;
+                ClassifyBlock(data + i, blockSize, separator[0], masks);
+                const uint64 outside         = ~GetQuotedMask(masks.quotes, inQuotes);
+                const uint64 separators      = masks.separators & outside;
+                const uint64 lineFeeds       = masks.lineFeeds & outside;
+                const uint64 carriageReturns = masks.carriageReturns & outside;
+
+                const bool afterCR = pendingCR;
+                pendingCR          = false;
+                if (afterCR && (lineFeeds & 1) == 0) {
+                    chunk.rows.emplace_back(position - 1, position); // '\r' alone
+                }
+
+                for (uint64 events = separators | lineFeeds | carriageReturns; events != 0; events &= events - 1) {
+                    const uint32 bit    = std::countr_zero(events);
+                    const uint64 bitPos = position + bit;
+                    if ((separators >> bit) & 1) {
+                        chunk.fields.push_back(bitPos + 1);
+                    } else if ((lineFeeds >> bit) & 1) {
+                        const bool isCRLF = bit == 0 ? afterCR : ((carriageReturns >> (bit - 1)) & 1) != 0;
+                        chunk.rows.emplace_back(isCRLF ? bitPos - 1 : bitPos, bitPos + 1);
+                    } else if (bit + 1 == blockSize) {
+                        pendingCR = true; // the next byte is in the next block
+                    } else if (((lineFeeds >> (bit + 1)) & 1) == 0) {
+                        chunk.rows.emplace_back(bitPos, bitPos + 1); // '\r' alone
+                    }
+                }
+            }
+
+            offset += buffer.GetLength();
+            bytesProcessed.fetch_add(buffer.GetLength(), std::memory_order_relaxed);
+            continue;
+        }
+
+        for (uint32 i = 0; i < buffer.GetLength(); i++) {
+            const uint64 position = offset + i;
+            const bool afterCR    = pendingCR;
+            pendingCR             = false;
+            if (afterCR && data[i] != '\n') {
+                chunk.rows.emplace_back(position - 1, position); // '\r' alone
+            }
+
+            if (data[i] == QUOTE) {
+                inQuotes = !inQuotes;
+                matcher.Reset();
+            } else if (inQuotes) {
+                continue;
+            } else if (data[i] == '\n') {
+                chunk.rows.emplace_back(afterCR ? position - 1 : position, position + 1);
+                matcher.Reset();
+            } else if (data[i] == '\r') {
+                pendingCR = true;
+                matcher.Reset();
+            } else if (matcher.Next(data[i])) {
+                chunk.fields.push_back(position + 1);
+            }
+        }
+
+        offset += buffer.GetLength();
+        bytesProcessed.fetch_add(buffer.GetLength(), std::memory_order_relaxed);
+    }
+
+    if (isLast && pendingCR) {
+        chunk.rows.emplace_back(chunk.end - 1, chunk.end);
+    }
+    return true;
+}
+
+void Index::Clear()
+{
+    rowStarts.clear();
+    rowFields.clear();
+    fieldOffsets.clear();
+}
+
+bool Index::Build(Utils::DataCache& cache, std::string_view separator, const std::function<bool(uint64 bytesProcessed)>& onProgress)
+{
+    Clear();
+    CHECK(!separator.empty() && separator.find_first_of("\"\r\n") == std::string_view::npos, false, "");
+    this->separator = separator;
+
+    const uint64 size = cache.GetSize();
+
+    // a separator of more than one byte could start in a chunk and end in the next one => a single chunk
+    uint64 chunksCount = 1;
+    if (separator.size() == 1 && size >= 2 * INDEX_CHUNK_MIN_SIZE) {
+        chunksCount = std::min<uint64>(size / INDEX_CHUNK_MIN_SIZE, static_cast<uint64>(Utils::GetWorkersCount()) * INDEX_CHUNKS_PER_WORKER);
+    }
+    std::vector<IndexedChunk> chunks(static_cast<size_t>(chunksCount));
+    const uint64 chunkSize = size / chunksCount;
+    for (uint64 i = 0; i < chunksCount; i++) {
+        chunks[i].start = i * chunkSize;
+        chunks[i].end   = i + 1 == chunksCount ? size : (i + 1) * chunkSize;
+    }
+
+    // every worker reads through its own view of the cache
+    const auto workersCount = std::min<uint32>(Utils::GetWorkersCount(), static_cast<uint32>(chunksCount));
+    std::vector<Utils::DataCache> views(workersCount);
+    for (auto& view : views) {
+        CHECK(view.InitView(cache), false, "");
+    }
+
+    std::atomic<uint64> bytesProcessed{ 0 };
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> failed{ false };
+    const auto onWait = [&]() {
+        if (onProgress != nullptr && !onProgress(bytesProcessed.load(std::memory_order_relaxed))) {
+            stop.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    };
+
+    // the quoted state at the start of every chunk
+    if (chunksCount > 1) {
+        CHECK(Utils::ParallelFor(
+                    static_cast<uint32>(chunksCount),
+                    [&](uint32 index, uint32 workerIndex) {
+                        if (!CountQuotes(views[workerIndex], chunks[index]))
+                            failed.store(true, std::memory_order_relaxed);
+                    },
+                    onWait),
+              false,
+              "");
+        CHECK(!failed.load(std::memory_order_relaxed), false, "");
+
+        for (uint64 i = 1; i < chunksCount; i++) {
+            chunks[i].inQuotes = chunks[i - 1].inQuotes ^ ((chunks[i - 1].quotesCount & 1) != 0);
+            const auto buffer  = cache.Get(chunks[i].start - 1, 1, true);
+            CHECK(buffer.IsValid(), false, "");
+            chunks[i].previousByte = buffer.GetData()[0];
+        }
+    }
+
+    CHECK(Utils::ParallelFor(
+                static_cast<uint32>(chunksCount),
+                [&](uint32 index, uint32 workerIndex) {
+                    if (!IndexChunk(views[workerIndex], separator, index + 1 == chunksCount, chunks[index], bytesProcessed, stop))
+                        failed.store(true, std::memory_order_relaxed);
+                },
+                onWait),
+          false,
+          "");
+    CHECK(!failed.load(std::memory_order_relaxed), false, "");
+
+    // the rows and the fields of the chunks are in order => merged in a single pass
+    uint64 rowsCount   = 0;
+    uint64 fieldsCount = 0;
+    for (const auto& chunk : chunks) {
+        rowsCount += chunk.rows.size();
+        fieldsCount += chunk.fields.size();
+    }
+    rowStarts.reserve(rowsCount + 2);
+    rowFields.reserve(rowsCount + 2);
+    fieldOffsets.reserve(fieldsCount + 2 * (rowsCount + 1));
+
+    uint64 rowStart = 0;
+    auto chunkIt    = chunks.begin();
+    size_t fieldIt  = 0;
+    const auto addRow = [&](uint64 contentEnd, uint64 nextRowStart) {
+        CHECK(contentEnd - rowStart + this->separator.size() <= 0xFFFFFFFF, false, "");
+        rowStarts.push_back(rowStart);
+        rowFields.push_back(fieldOffsets.size());
+        fieldOffsets.push_back(0);
+        for (; chunkIt != chunks.end(); chunkIt++, fieldIt = 0) {
+            for (; fieldIt < chunkIt->fields.size() && chunkIt->fields[fieldIt] <= contentEnd; fieldIt++) {
+                fieldOffsets.push_back(static_cast<uint32>(chunkIt->fields[fieldIt] - rowStart));
+            }
+            if (fieldIt < chunkIt->fields.size()) {
+                break;
+            }
+        }
+        fieldOffsets.push_back(static_cast<uint32>(contentEnd - rowStart + this->separator.size()));
+        rowStart = nextRowStart;
+        return true;
+    };
+
+    for (const auto& chunk : chunks) {
+        for (const auto& [contentEnd, nextRowStart] : chunk.rows) {
+            CHECK(addRow(contentEnd, nextRowStart), false, "");
+        }
+    }
+    if (rowStart < size) { // last row without a new line
+        CHECK(addRow(size, size), false, "");
+    }
+    rowStarts.push_back(rowStart);
+    rowFields.push_back(fieldOffsets.size());
+
+    return true;
+}
+} // namespace GView::DelimitedText
@@ -0,0 +1,83 @@
+#include "GView.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace GView::Utils;
+
+constexpr uint32 MAX_WORKERS_COUNT        = 64;
+constexpr auto WAIT_NOTIFICATION_INTERVAL = std::chrono::milliseconds(100);
+
+namespace GView::Utils
+{
+uint32 GetWorkersCount()
+{
+    const auto count = std::thread::hardware_concurrency();
+    if (count == 0)
+        return 1;
+    return std::min<uint32>(count, MAX_WORKERS_COUNT);
+}
+
+bool ParallelFor(uint32 count, const std::function<void(uint32 index, uint32 workerIndex)>& task, const std::function<bool()>& onWait)
+{
+    CHECK(task, false, "Expecting a valid task !");
+    if (count == 0)
+        return true;
+
+    const auto workersCount = std::min<uint32>(GetWorkersCount(), count);
+
+    std::atomic<uint32> nextIndex{ 0 };
+    std::atomic<bool> stop{ false };
+    uint32 finishedWorkers = 0;
+    std::mutex lock;
+    std::condition_variable finished;
+
+    std::vector<std::thread> workers;
+    workers.reserve(workersCount);
+    for (uint32 w = 0; w < workersCount; w++)
+    {
+        workers.emplace_back(
+              [&, w]()
+              {
+                  while (!stop.load(std::memory_order_relaxed))
+                  {
+                      const auto index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+                      if (index >= count)
+                          break;
+                      task(index, w);
+                  }
+
+                  std::scoped_lock guard(lock);
+                  finishedWorkers++;
+                  finished.notify_one();
+              });
+    }
+
+    bool result = true;
+    if (onWait)
+    {
+        std::unique_lock guard(lock);
+        while (finishedWorkers < workersCount)
+        {
+            if (finished.wait_for(guard, WAIT_NOTIFICATION_INTERVAL, [&]() { return finishedWorkers == workersCount; }))
+                break;
+
+            guard.unlock();
+            if (result && !onWait())
+            {
+                result = false;
+                stop.store(true, std::memory_order_relaxed);
+            }
+            guard.lock();
+        }
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return result;
+}
+} // namespace GView::Utils
@@ -3,11 +3,139 @@
 using namespace GView::Utils;
 using namespace AppCUI::Graphics;
 
+constexpr uint32 NO_ZONE = 0xFFFFFFFF;
+
 struct ZonesListContext {
     std::vector<Zone> zones{};
-    std::vector<Zone> cache{};
+
+    // index - rebuilt (lazily) after the zones are changed
+    // zones are sorted by low ASC, high DESC, insertion DESC => when several zones contain an offset, the last one (the innermost,
+    // first added on ties) has priority
+    bool indexIsValid{ true };
+    std::vector<uint32> order{};       // zone indexes in the order above
+    std::vector<uint64> lows{};        // lows in the order above
+    std::vector<uint64> sortedHighs{}; // all the highs sorted ASC (used to compute the boundaries from the viewport)
+    std::vector<uint64> maxHigh{};     // segment tree (max of high) built over 'order'
+    uint32 leavesCount{ 0 };
+
+    // viewport (SetCache) split in segments where the same zone has priority, read through a cursor that advances monotonically
+    // while a view is painted
+    struct Segment {
+        uint64 start;
+        uint32 zone;
+    };
+    Zone::Interval view{};
+    std::vector<Segment> segments{};
+    size_t cursor{ 0 };
 };
 
+static uint32 FindLastZone(const ZonesListContext* ctx, uint32 node, uint32 nodeLow, uint32 nodeHigh, uint32 last, uint64 position)
+{
+    if (nodeLow > last || ctx->maxHigh[node] < position) {
+        return NO_ZONE;
+    }
+    if (nodeLow == nodeHigh) {
+        return ctx->order[nodeLow];
+    }
+
+    const auto middle = (nodeLow + nodeHigh) / 2;
+    const auto zone   = FindLastZone(ctx, node * 2 + 1, middle + 1, nodeHigh, last, position);
+    if (zone != NO_ZONE) {
+        return zone;
+    }
+    return FindLastZone(ctx, node * 2, nodeLow, middle, last, position);
+}
+
+static uint32 FindZone(const ZonesListContext* ctx, uint64 position)
+{
+    // rightmost zone with low <= position and high >= position
+    const auto count = std::upper_bound(ctx->lows.begin(), ctx->lows.end(), position) - ctx->lows.begin();
+    if (count == 0) {
+        return NO_ZONE;
+    }
+    return FindLastZone(ctx, 1, 0, ctx->leavesCount - 1, static_cast<uint32>(count - 1), position);
+}
+
+static void BuildSegments(ZonesListContext* ctx)
+{
+    ctx->segments.clear();
+    ctx->cursor = 0;
+
+    const auto& view = ctx->view;
+    if (view.low == INVALID_OFFSET || view.low > view.high) {
+        return;
+    }
+
+    // the zone with priority can change only on a low or right after a high
+    std::vector<uint64> boundaries{ view.low };
+    auto lowIt = std::upper_bound(ctx->lows.begin(), ctx->lows.end(), view.low);
+    for (; lowIt != ctx->lows.end() && *lowIt <= view.high; lowIt++) {
+        boundaries.push_back(*lowIt);
+    }
+    auto highIt = std::lower_bound(ctx->sortedHighs.begin(), ctx->sortedHighs.end(), view.low);
+    for (; highIt != ctx->sortedHighs.end() && *highIt < view.high; highIt++) {
+        boundaries.push_back(*highIt + 1);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    for (const auto b : boundaries) {
+        const auto zone = FindZone(ctx, b);
+        if (ctx->segments.empty() || ctx->segments.back().zone != zone) {
+            ctx->segments.push_back({ b, zone });
+        }
+    }
+}
+
+static void BuildIndex(ZonesListContext* ctx)
+{
+    if (ctx->indexIsValid) {
+        return;
+    }
+
+    const auto& zones = ctx->zones;
+    const auto count  = static_cast<uint32>(zones.size());
+
+    ctx->order.resize(count);
+    for (uint32 i = 0; i < count; i++) {
+        ctx->order[i] = i;
+    }
+    std::sort(ctx->order.begin(), ctx->order.end(), [&zones](uint32 a, uint32 b) {
+        const auto& za = zones[a].interval;
+        const auto& zb = zones[b].interval;
+        if (za.low != zb.low) {
+            return za.low < zb.low;
+        }
+        if (za.high != zb.high) {
+            return za.high > zb.high;
+        }
+        return a > b;
+    });
+
+    ctx->lows.resize(count);
+    ctx->sortedHighs.resize(count);
+    for (uint32 i = 0; i < count; i++) {
+        ctx->lows[i]        = zones[ctx->order[i]].interval.low;
+        ctx->sortedHighs[i] = zones[i].interval.high;
+    }
+    std::sort(ctx->sortedHighs.begin(), ctx->sortedHighs.end());
+
+    ctx->leavesCount = 1;
+    while (ctx->leavesCount < count) {
+        ctx->leavesCount <<= 1;
+    }
+    ctx->maxHigh.assign(static_cast<size_t>(ctx->leavesCount) * 2, 0);
+    for (uint32 i = 0; i < count; i++) {
+        ctx->maxHigh[ctx->leavesCount + i] = zones[ctx->order[i]].interval.high;
+    }
+    for (uint32 i = ctx->leavesCount - 1; i > 0; i--) {
+        ctx->maxHigh[i] = std::max(ctx->maxHigh[i * 2], ctx->maxHigh[i * 2 + 1]);
+    }
+
+    ctx->indexIsValid = true;
+    BuildSegments(ctx);
+}
+
 ZonesList::ZonesList()
 {
     context = new ZonesListContext;
@@ -25,6 +153,7 @@ bool ZonesList::Add(uint64 s, uint64 e, ColorPair c, std::string_view txt)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(s, e, c, txt);
+    ctx->indexIsValid = false;
     return true;
 }
 
@@ -33,6 +162,7 @@ bool ZonesList::Add(const Zone& zone)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(zone);
+    ctx->indexIsValid = false;
     return true;
 }
 
@@ -40,14 +170,31 @@ std::optional<Zone> ZonesList::OffsetToZone(uint64 position) const
 {
     CHECK(context != nullptr, std::nullopt, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
-
-    for (const auto& zone : ctx->cache) {
-        if (zone.interval.low <= position && position <= zone.interval.high) {
-            return zone;
+    BuildIndex(ctx);
+
+    auto zone = NO_ZONE;
+    if (!ctx->segments.empty() && position >= ctx->view.low && position <= ctx->view.high) {
+        const auto& segments = ctx->segments;
+        auto& cursor         = ctx->cursor;
+        if (position < segments[cursor].start) {
+            cursor = std::upper_bound(segments.begin(), segments.end(), position, [](uint64 p, const ZonesListContext::Segment& s) {
+                         return p < s.start;
+                     }) -
+                     segments.begin() - 1;
+        } else {
+            while (cursor + 1 < segments.size() && segments[cursor + 1].start <= position) {
+                cursor++;
+            }
         }
+        zone = segments[cursor].zone;
+    } else {
+        zone = FindZone(ctx, position);
     }
 
-    return std::nullopt;
+    if (zone == NO_ZONE) {
+        return std::nullopt;
+    }
+    return ctx->zones[zone];
 }
 
 bool ZonesList::SetCache(const Zone::Interval& interval)
@@ -55,22 +202,13 @@ bool ZonesList::SetCache(const Zone::Interval& interval)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
-    ctx->cache.clear();
-
-    for (const auto& zone : ctx->zones) {
-        if ((zone.interval.low >= interval.low && zone.interval.low <= interval.high) ||
-            interval.low >= zone.interval.low && interval.low <= zone.interval.high) {
-            ctx->cache.push_back(zone);
-        }
+    ctx->view = interval;
+    if (ctx->indexIsValid) {
+        BuildSegments(ctx);
+    } else {
+        BuildIndex(ctx);
     }
 
-    std::sort(ctx->cache.begin(), ctx->cache.end(), [](const Zone& a, const Zone& b) {
-        if (a.interval.low == b.interval.low) {
-            return a.interval.high < b.interval.high;
-        }
-        return a.interval.low > b.interval.low;
-    });
-
     return true;
 }
 
@@ -80,7 +218,7 @@ void ZonesList::Clear()
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
     ctx->zones.clear();
-    ctx->cache.clear();
+    ctx->indexIsValid = false;
 }
 
 uint32 ZonesList::GetCount() const
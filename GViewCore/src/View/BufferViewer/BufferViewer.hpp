@@ -2,6 +2,8 @@
 
 #include "Internal.hpp"
 
+#include <bitset>
+
 namespace GView::View::BufferViewer
 {
 using namespace AppCUI;
@@ -67,9 +69,37 @@ struct Config {
     void Initialize();
 };
 
+// byte pattern where every position accepts a set of values (case folding, '?' wildcards, UTF-16 code units)
+class LiteralSearch
+{
+    std::vector<std::bitset<256>> classes;
+    std::array<uint32, 256> shift{}; // Horspool bad character shifts (used when there is no fixed byte to look for)
+    uint32 anchor{ NO_ANCHOR };      // the rarest fixed byte of the pattern - located with memchr
+    uint32 secondAnchor{ NO_ANCHOR };
+
+    bool Verify(const uint8* data) const;
+
+  public:
+    static constexpr uint32 NO_ANCHOR = 0xFFFFFFFF;
+
+    bool Init(std::vector<std::bitset<256>> patternClasses);
+    void Clear();
+    uint32 GetLength() const
+    {
+        return static_cast<uint32>(classes.size());
+    }
+    // first match in data that starts in [from, size - length]
+    bool Find(const uint8* data, uint32 size, uint32 from, uint32& position) const;
+};
+
 class FindDialog : public Window, public Handlers::OnCheckInterface
 {
+  public:
+    static constexpr uint32 MAX_FIND_ALL_RESULTS = 10000;
+
   private:
+    enum class SearchType : uint8 { None, Literal, Regex, UnicodeRegex };
+
     Reference<GView::Object> object;
     uint64 currentPos;
 
@@ -92,13 +122,22 @@ class FindDialog : public Window, public Handlers::OnCheckInterface
 
     Reference<CheckBox> ignoreCase;
     Reference<CheckBox> alingTextToUpperLeftCorner;
+    Reference<CheckBox> findAll;
 
     uint64 position{ 0 };
     uint64 length{ 0 };
 
     UnicodeStringBuilder usb;
     std::pair<uint64, uint64> match;
+    std::vector<std::pair<uint64, uint64>> results;
     bool newRequest{ true };
+
+    SearchType searchType{ SearchType::None };
+    LiteralSearch literal;
+    std::unique_ptr<GView::Regex::Matcher> regex;
+
+    bool BuildSearch();
+    bool BuildBinaryPattern(std::string_view text, std::vector<std::bitset<256>>& classes);
     bool ProcessInput(uint64 end = GView::Utils::INVALID_OFFSET, bool last = false);
 
   public:
@@ -131,6 +170,38 @@ class FindDialog : public Window, public Handlers::OnCheckInterface
         CHECK(start != GView::Utils::INVALID_OFFSET && length > 0, false, "");
         return true;
     }
+    bool IsFindAll()
+    {
+        CHECK(findAll.IsValid(), false, "");
+        return findAll->IsChecked();
+    }
+    // all the matches (offset, length) from the current position onward - filled when "find all" is checked
+    const std::vector<std::pair<uint64, uint64>>& GetResults() const
+    {
+        return results;
+    }
+    void SetCurrentMatch(std::pair<uint64, uint64> currentMatch)
+    {
+        match = currentMatch;
+    }
+};
+
+class FindAllDialog : public Window
+{
+    Reference<ListView> list;
+    const std::vector<std::pair<uint64, uint64>>& results;
+    std::pair<uint64, uint64> selectedMatch;
+
+    void Validate();
+
+  public:
+    FindAllDialog(Reference<GView::Object> object, const std::vector<std::pair<uint64, uint64>>& results);
+
+    virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    std::pair<uint64, uint64> GetSelectedMatch() const
+    {
+        return selectedMatch;
+    }
 };
 
 namespace Commands
@@ -0,0 +1,85 @@
+#include "BufferViewer.hpp"
+
+namespace GView::View::BufferViewer
+{
+constexpr int32 BTN_ID_OK          = 1;
+constexpr int32 BTN_ID_CANCEL      = 2;
+constexpr uint32 PREVIEW_SIZE      = 48;
+constexpr uint64 INVALID_RESULT_ID = 0xFFFFFFFFFFFFFFFF;
+
+FindAllDialog::FindAllDialog(Reference<GView::Object> object, const std::vector<std::pair<uint64, uint64>>& results)
+    : Window("All matches", "d:c,w:90,h:20", WindowFlags::ProcessReturn | WindowFlags::Sizeable),
+      results(results), selectedMatch({ GView::Utils::INVALID_OFFSET, 0 })
+{
+    list = Factory::ListView::Create(
+          this, "l:1,t:0,r:1,b:3", { "n:Offset,a:r,w:18", "n:Length,a:r,w:10", "n:Content,a:l,w:60" }, ListViewFlags::HideSearchBar);
+
+    LocalString<128> tmp;
+    LocalString<PREVIEW_SIZE + 1> preview;
+    for (uint64 i = 0; i < results.size(); i++)
+    {
+        const auto& [start, length] = results[i];
+
+        preview.Clear();
+        const auto buffer = object->GetData().Get(start, static_cast<uint32>(std::min<uint64>(length, PREVIEW_SIZE)), false);
+        for (uint32 j = 0; j < buffer.GetLength(); j++)
+        {
+            const auto c = buffer.GetData()[j];
+            preview.AddChar((c >= 32 && c < 127) ? static_cast<char>(c) : '.');
+        }
+
+        auto item = list->AddItem(tmp.Format("0x%llX", start));
+        item.SetText(1, tmp.Format("%llu", length));
+        item.SetText(2, preview);
+        item.SetData(i);
+    }
+
+    if (results.size() >= FindDialog::MAX_FIND_ALL_RESULTS)
+    {
+        list->AddItem(tmp.Format("Only the first %u matches are listed", FindDialog::MAX_FIND_ALL_RESULTS)).SetType(ListViewItem::Type::Category);
+    }
+
+    Factory::Button::Create(this, "&OK", "l:30,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:45,b:0,w:13", BTN_ID_CANCEL);
+}
+
+void FindAllDialog::Validate()
+{
+    const auto index = list->GetCurrentItem().GetData(INVALID_RESULT_ID);
+    if (index == INVALID_RESULT_ID || index >= results.size())
+    {
+        return;
+    }
+    selectedMatch = results[index];
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FindAllDialog::OnEvent(Reference<Control>, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+        break;
+    case Event::ListViewItemPressed:
+        Validate();
+        return true;
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
+} // namespace GView::View::BufferViewer
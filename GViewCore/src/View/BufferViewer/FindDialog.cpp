@@ -1,7 +1,7 @@
 #include "BufferViewer.hpp"
 
 #include <array>
-#include <regex>
+#include <algorithm>
 #include <charconv>
 
 namespace GView::View::BufferViewer
@@ -22,6 +22,7 @@ constexpr int32 CHECKBOX_ID_ALIGN_TEXT_UPPER_LEFT = 12;
 constexpr int32 RADIOBOX_ID_TEXT_HEX              = 13;
 constexpr int32 RADIOBOX_ID_TEXT_DEC              = 14;
 constexpr int32 CHECKBOX_ID_TEXT_REGEX            = 15;
+constexpr int32 CHECKBOX_ID_FIND_ALL              = 16;
 
 constexpr int32 GROUPD_ID_SEARCH_TYPE    = 1;
 constexpr int32 GROUPD_ID_TEXT_TYPE      = 2;
@@ -32,7 +33,7 @@ constexpr int32 GROUPD_ID_BUFFER_ACTION  = 5;
 constexpr uint32 DIALOG_HEIGHT_TEXT_FORMAT      = 18;
 constexpr uint32 DESCRIPTION_HEIGHT_TEXT_FORMAT = 3;
 constexpr std::string_view TEXT_FORMAT_TITLE    = "Text Pattern";
-constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (ECMAScript) to find. Alt+I to focus on input text field.";
+constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (RE2 syntax) to find. Alt+I to focus on input text field.";
 
 constexpr std::string_view BINARY_FORMAT_TITLE = "Binary Pattern";
 constexpr std::array<std::string_view, 4> BINARY_FORMAT_BODY{ "Binary pattern to find. Alt+I to focus on input text field.",
@@ -45,6 +46,9 @@ constexpr uint32 DESCRIPTION_HEIGHT_BINARY_FORMAT = DESCRIPTION_HEIGHT_TEXT_FORM
 
 constexpr std::string_view ANYTHING_PATTERN{ "???" };
 
+constexpr uint32 MAX_LITERAL_PATTERN_SIZE = 0x1000;
+constexpr uint32 REGEX_CHUNK_OVERLAP      = 0x1000; // a regex match longer than this might be truncated at a chunk boundary
+
 FindDialog::FindDialog()
     : Window("Find", "d:c,w:30%,h:18", WindowFlags::ProcessReturn | WindowFlags::Sizeable), currentPos(GView::Utils::INVALID_OFFSET),
       position(GView::Utils::INVALID_OFFSET), match({ GView::Utils::INVALID_OFFSET, 0 })
@@ -98,6 +102,9 @@ FindDialog::FindDialog()
     alingTextToUpperLeftCorner->SetChecked(true);
     alingTextToUpperLeftCorner->Handlers()->OnCheck = this;
 
+    findAll = Factory::CheckBox::Create(this, "Fi&nd all matches", "x:60%,y:11,w:40%,h:1", CHECKBOX_ID_FIND_ALL);
+    findAll->Handlers()->OnCheck = this;
+
     Factory::Button::Create(this, "&OK", "x:25%,y:100%,a:b,w:12", BTN_ID_OK);
     Factory::Button::Create(this, "&Cancel", "x:75%,y:100%,a:b,w:12", BTN_ID_CANCEL);
 
@@ -115,9 +122,9 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
             Exit(Dialogs::Result::Cancel);
             return true;
         case BTN_ID_OK:
-            Exit(Dialogs::Result::Ok);
+            CHECK(BuildSearch(), true, "");
             newRequest = true;
-            CHECK(ProcessInput(), false, "");
+            Exit(Dialogs::Result::Ok);
             return true;
         }
     }
@@ -125,9 +132,9 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
     switch (eventType)
     {
     case Event::WindowAccept:
-        Exit(Dialogs::Result::Ok);
+        CHECK(BuildSearch(), true, "");
         newRequest = true;
-        CHECK(ProcessInput(), false, "");
+        Exit(Dialogs::Result::Ok);
         return true;
     case Event::WindowClose:
         Exit(Dialogs::Result::Cancel);
@@ -273,6 +280,7 @@ bool FindDialog::Update()
     bufferSelect->MoveTo(bufferSelect->GetX(), bufferSelect->GetY() + deltaSigned);
     bufferMoveCursorTo->MoveTo(bufferMoveCursorTo->GetX(), bufferMoveCursorTo->GetY() + deltaSigned);
     ignoreCase->MoveTo(ignoreCase->GetX(), ignoreCase->GetY() + deltaSigned);
+    findAll->MoveTo(findAll->GetX(), findAll->GetY() + deltaSigned);
     alingTextToUpperLeftCorner->MoveTo(alingTextToUpperLeftCorner->GetX(), alingTextToUpperLeftCorner->GetY() + deltaSigned);
 
     return true;
@@ -304,21 +312,26 @@ std::pair<uint64, uint64> FindDialog::GetNextMatch(uint64 currentPos)
 std::pair<uint64, uint64> FindDialog::GetPreviousMatch(uint64 currentPos)
 {
     const auto initialCurrentPos = this->currentPos;
-    while (true)
+    const auto initialMatch      = match;
+    const auto cacheSize         = this->object->GetData().GetCacheSize();
+
+    // windows of cacheSize bytes, from the cursor back to the start of the object (a window ends where the next one starts)
+    auto end = currentPos > 0 ? currentPos - 1 : 0;
+    while (end > 0)
     {
-        const auto end   = currentPos - 1;
-        this->currentPos = this->object->GetData().GetCacheSize() > currentPos ? 0 : currentPos - this->object->GetData().GetCacheSize();
+        this->currentPos = end > cacheSize ? end - cacheSize : 0;
         ProcessInput(end, true);
         if (HasResults())
         {
             this->currentPos = match.first;
             break;
         }
-        CHECKBK(this->currentPos, "");
-    };
+        end = this->currentPos;
+    }
     if (HasResults() == false)
     {
         this->currentPos = initialCurrentPos;
+        match            = initialMatch;
     }
     return match;
 }
@@ -369,7 +382,7 @@ bool ValidateHex(std::string_view number)
         CHECK((number[0] >= '0' && number[0] <= '9') || (number[0] >= 'a' && number[0] <= 'f') || (number[0] >= 'A' && number[0] <= 'F'), false, "");
         if (number.size() == 2)
         {
-            CHECK((number[0] >= '1' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
+            CHECK((number[1] >= '0' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
         }
     }
     else
@@ -380,12 +393,67 @@ bool ValidateHex(std::string_view number)
     return true;
 }
 
-bool FindDialog::ProcessInput(uint64 end, bool last)
+bool FindDialog::BuildBinaryPattern(std::string_view text, std::vector<std::bitset<256>>& classes)
+{
+    const auto isDecimal = textDec->IsChecked();
+
+    size_t current = 0;
+    while (current < text.size())
+    {
+        if (text[current] == ' ')
+        {
+            current++;
+            continue;
+        }
+
+        auto next = text.find(' ', current);
+        if (next == std::string_view::npos)
+        {
+            next = text.size();
+        }
+        const auto number = text.substr(current, next - current);
+        current           = next;
+
+        if ((isDecimal && ValidateDecimal(number) == false) || (isDecimal == false && ValidateHex(number) == false))
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
+            return false;
+        }
+
+        auto& values = classes.emplace_back();
+        if (number[0] == '?')
+        {
+            values.set();
+            continue;
+        }
+
+        uint8 n;
+        const auto result = std::from_chars(number.data(), number.data() + number.size(), n, isDecimal ? 10 : 16);
+        if (result.ec != std::errc() || result.ptr != number.data() + number.size())
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
+            return false;
+        }
+        values.set(n);
+    }
+
+    if (classes.empty())
+    {
+        Dialogs::MessageBox::ShowError("Error!", "Missing input!");
+        return false;
+    }
+
+    return true;
+}
+
+bool FindDialog::BuildSearch()
 {
-    CHECK(currentPos != GView::Utils::INVALID_OFFSET, false, "");
-    CHECK(object.IsValid(), false, "");
     CHECK(input.IsValid(), false, "");
 
+    searchType = SearchType::None;
+    literal.Clear();
+    regex.reset();
+
     if (input->GetText().Len() == 0)
     {
         Dialogs::MessageBox::ShowError("Error!", "Missing input!");
@@ -395,295 +463,308 @@ bool FindDialog::ProcessInput(uint64 end, bool last)
     CHECK(usb.Set(input->GetText()), false, "");
     CHECK(usb.Len() > 0, false, "");
 
-    if (newRequest)
-    {
-        match      = { GView::Utils::INVALID_OFFSET, 0 };
-        newRequest = false;
-    }
+    const auto caseSensitive = ignoreCase->IsChecked() == false;
+    std::vector<std::bitset<256>> classes;
 
-    std::vector<TypeInterface::SelectionZone> selectedZones;
-    for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
+    if (textOption->IsChecked())
     {
-        selectedZones.emplace_back(this->object->GetContentType()->GetSelectionZone(i));
-    }
+        if (textRegex->IsChecked())
+        {
+            std::string expression;
+            usb.ToString(expression);
 
-    const auto computeForFile = !searchSelection->IsChecked();
+            regex = std::make_unique<GView::Regex::Matcher>();
+            if (regex->Init(expression, textUnicode->IsChecked(), caseSensitive) == false)
+            {
+                regex.reset();
+                Dialogs::MessageBox::ShowError("Error!", "Invalid regular expression!");
+                return false;
+            }
 
-    auto objectSize = 0ULL;
-    if (computeForFile)
-    {
-        if (last && end != GView::Utils::INVALID_OFFSET)
+            searchType = textUnicode->IsChecked() ? SearchType::UnicodeRegex : SearchType::Regex;
+            return true;
+        }
+
+        const auto AddValue = [&](uint8 value, bool fold)
+        {
+            auto& values = classes.emplace_back();
+            values.set(value);
+            if (fold && caseSensitive == false && ((value >= 'a' && value <= 'z') || (value >= 'A' && value <= 'Z')))
+            {
+                values.set(value ^ 0x20);
+            }
+        };
+
+        if (textAscii->IsChecked())
         {
-            objectSize = end - currentPos;
+            std::string text;
+            usb.ToString(text);
+            for (const auto c : text)
+            {
+                AddValue(static_cast<uint8>(c), true);
+            }
         }
         else
         {
-            objectSize = object->GetData().GetSize();
+            // UTF-16LE - only the ASCII code units are case folded
+            for (const auto c : usb.ToStringView())
+            {
+                AddValue(static_cast<uint8>(c & 0xFF), c < 0x80);
+                AddValue(static_cast<uint8>(c >> 8), false);
+            }
         }
     }
     else
     {
-        for (auto& sz : selectedZones)
+        std::string text;
+        usb.ToString(text);
+        if (BuildBinaryPattern(text, classes) == false)
         {
-            objectSize += sz.end - sz.start + 1;
+            return false;
         }
     }
-    ProgressStatus::Init("Searching...", objectSize);
 
-    LocalString<512> ls;
-    const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
-    if (objectSize > 0xFFFFFFFF)
+    if (classes.size() >= MAX_LITERAL_PATTERN_SIZE)
     {
-        format = "[0x%.16llX/0x%.16llX] bytes...";
+        Dialogs::MessageBox::ShowError("Error!", "Pattern is too long!");
+        return false;
     }
 
-    const auto block = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : object->GetData().GetCacheSize();
-
-    const auto SearchInAsciiChunk = [&](uint64 offset, uint64 left, const std::regex& pattern)
-    {
-        do
-        {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
+    CHECK(literal.Init(std::move(classes)), false, "");
+    searchType = SearchType::Literal;
 
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
+    return true;
+}
 
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
+bool FindDialog::ProcessInput(uint64 end, bool last)
+{
+    CHECK(currentPos != GView::Utils::INVALID_OFFSET, false, "");
+    CHECK(object.IsValid(), false, "");
+    CHECK(searchType != SearchType::None, false, "");
 
-            const auto initialStart = reinterpret_cast<char const*>(buffer.GetData());
-            auto start              = reinterpret_cast<char const*>(buffer.GetData());
-            const auto end          = reinterpret_cast<char const*>(start + buffer.GetLength());
-            std::cmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
-            {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
-            }
+    // every match is collected only by the first search of a request - find next/previous just move between them
+    const auto findAllMatches = newRequest && last == false && IsFindAll();
+    if (findAllMatches)
+    {
+        results.clear();
+    }
 
-            offset += sizeToRead;
-        } while (left > 0);
+    if (newRequest || last)
+    {
+        match      = { GView::Utils::INVALID_OFFSET, 0 };
+        newRequest = false;
+    }
 
-        return true;
+    // matches must start in [start, stop) and end before readEnd - the selected zones are clipped to the current position
+    // (and to end when looking for the last match) but a match may still extend past end
+    struct Range {
+        uint64 start;
+        uint64 stop;
+        uint64 readEnd;
     };
-
-    const auto SearchInUnicodeChunk = [&](uint64 offset, uint64 left, const std::wregex& pattern)
+    const auto fileSize = object->GetData().GetSize();
+    const auto rangeEnd = (last && end != GView::Utils::INVALID_OFFSET) ? std::min<uint64>(end, fileSize) : fileSize;
+    std::vector<Range> ranges;
+    if (searchSelection->IsChecked())
     {
-        do
+        for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
         {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
-
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
-
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
-
-            auto initialStart = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            auto start        = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            const auto end    = reinterpret_cast<wchar_t const*>(start + buffer.GetLength());
-            std::wcmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
+            const auto zone  = this->object->GetContentType()->GetSelectionZone(i);
+            const auto start = std::max<uint64>(zone.start, currentPos);
+            const auto stop  = std::min<uint64>(zone.end + 1, rangeEnd);
+            if (start < stop)
             {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) * sizeof(wchar_t) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
+                ranges.push_back({ start, stop, std::min<uint64>(zone.end + 1, fileSize) });
             }
+        }
+        std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.start < b.start; });
+    }
+    else if (currentPos < rangeEnd)
+    {
+        ranges.push_back({ currentPos, rangeEnd, fileSize });
+    }
+
+    auto objectSize = 0ULL;
+    for (const auto& range : ranges)
+    {
+        objectSize += range.stop - range.start;
+    }
+    ProgressStatus::Init("Searching...", objectSize);
 
-            offset += sizeToRead;
-        } while (left > 0);
+    LocalString<512> ls;
+    const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
+    if (objectSize > 0xFFFFFFFF)
+    {
+        format = "[0x%.16llX/0x%.16llX] bytes...";
+    }
 
-        return true;
-    };
+    const auto cacheSize = object->GetData().GetCacheSize();
+    const auto isUnicode = searchType == SearchType::UnicodeRegex;
+    const auto step      = isUnicode ? 2U : 1U;
+    const auto overlap   = searchType == SearchType::Literal ? literal.GetLength() - 1 : REGEX_CHUNK_OVERLAP;
+    CHECK(overlap < cacheSize / 2, false, "");
 
-    if (textOption->IsChecked())
+    // UTF-16LE chunk => UTF-8 text for RE2 + the chunk offset of every UTF-8 byte (and one past the last one)
+    std::string narrowed;
+    std::vector<uint32> narrowedOffsets;
+    const auto Narrow = [&](BufferView buffer)
     {
-        if (textAscii->IsChecked())
+        narrowed.clear();
+        narrowedOffsets.clear();
+        for (uint32 i = 0; i + 1 < buffer.GetLength(); i += 2)
         {
-            std::string ascii;
-            usb.ToString(ascii);
-
-            if (textRegex->IsChecked() == false)
+            auto c = static_cast<char16>(buffer.GetData()[i] | (buffer.GetData()[i + 1] << 8));
+            if (c >= 0xD800 && c <= 0xDFFF)
             {
-                const static std::regex specialChars{ R"([-[\]{}()*+?.,\^$|#\s])" };
-                ascii = std::regex_replace(ascii, specialChars, R"(\$&)");
+                c = 0xFFFD;
             }
 
-            const std::regex pattern(
-                  ascii,
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
-
-            if (computeForFile)
+            if (c < 0x80)
             {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
-
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
+                narrowed.push_back(static_cast<char>(c));
+            }
+            else if (c < 0x800)
+            {
+                narrowed.push_back(static_cast<char>(0xC0 | (c >> 6)));
+                narrowed.push_back(static_cast<char>(0x80 | (c & 0x3F)));
             }
             else
             {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
+                narrowed.push_back(static_cast<char>(0xE0 | (c >> 12)));
+                narrowed.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                narrowed.push_back(static_cast<char>(0x80 | (c & 0x3F)));
             }
+            narrowedOffsets.resize(narrowed.size(), i);
         }
-        else
+        narrowedOffsets.push_back(buffer.GetLength() & ~1U);
+    };
+
+    // first match in the chunk that starts at or after from
+    const auto FindInChunk = [&](BufferView buffer, uint32 from, uint32& start, uint32& length)
+    {
+        if (searchType == SearchType::Literal)
         {
-            std::wstring unicode{ reinterpret_cast<const wchar_t*>(usb.ToStringView().data()), usb.ToStringView().size() };
+            length = literal.GetLength();
+            return literal.Find(buffer.GetData(), static_cast<uint32>(buffer.GetLength()), from, start);
+        }
 
-            if (textRegex->IsChecked() == false)
+        uint64 matchStart, matchEnd;
+        if (isUnicode == false)
+        {
+            if (regex->Match(buffer, from, matchStart, matchEnd) == false)
             {
-                const static std::wregex specialChars{ LR"([-[\]{}()*+?.,\^$|#\s])" };
-                unicode = std::regex_replace(unicode, specialChars, LR"(\$&)");
+                return false;
             }
+            start  = static_cast<uint32>(matchStart);
+            length = static_cast<uint32>(matchEnd - matchStart);
+            return true;
+        }
 
-            const std::wregex pattern(
-                  reinterpret_cast<wchar_t const* const>(usb.ToStringView().data()),
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
+        const auto narrowedFrom = std::lower_bound(narrowedOffsets.begin(), narrowedOffsets.end(), from) - narrowedOffsets.begin();
+        if (regex->Match(BufferView{ narrowed.data(), narrowed.size() }, narrowedFrom, matchStart, matchEnd) == false)
+        {
+            return false;
+        }
+        start  = narrowedOffsets[matchStart];
+        length = narrowedOffsets[matchEnd] - start;
+        return true;
+    };
 
-            if (computeForFile)
-            {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
+    // chunks overlap so that a match crossing a chunk boundary is still found - a chunk reports only the matches
+    // starting before its overlap (the next chunk reports the others); onMatch returns false to stop the search
+    auto searched            = 0ULL;
+    const auto SearchInRange = [&](const Range& range, const std::function<bool(uint64, uint64)>& onMatch)
+    {
+        auto offset      = range.start;
+        auto nextAllowed = offset;
+        while (offset < range.stop)
+        {
+            CHECK(ProgressStatus::Update(searched, ls.Format(format, searched, objectSize)) == false, false, "");
 
-                CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
+            auto sizeToRead = static_cast<uint32>(std::min<uint64>(cacheSize, range.readEnd - offset));
+            if (isUnicode)
+            {
+                sizeToRead &= ~1U;
             }
-            else
+            if (sizeToRead == 0)
             {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
+                break;
             }
-        }
-    }
-    else
-    {
-        std::string input;
-        usb.ToString(input);
 
-        std::string regexPayload;
-        regexPayload.reserve(input.size() * 2);
+            const auto isLastChunk = offset + sizeToRead + step - 1 >= range.readEnd || sizeToRead <= overlap;
+            const auto chunkEnd    = isLastChunk ? sizeToRead : sizeToRead - (overlap + step - 1) / step * step;
+            const auto commit      = static_cast<uint32>(std::min<uint64>(chunkEnd, range.stop - offset));
 
-        uint64 last    = 0;
-        uint64 current = input.find_first_of(' ', last);
-        do
-        {
-            if (current == std::string::npos)
+            const auto buffer = object->GetData().Get(offset, sizeToRead, true);
+            CHECK(buffer.IsValid(), false, "");
+            if (isUnicode)
             {
-                current = input.size();
+                Narrow(buffer);
             }
 
-            std::string_view number{ input.data() + last, current - last };
-
-            if (textDec->IsChecked())
+            uint32 from = static_cast<uint32>(nextAllowed - offset);
+            uint32 start, length;
+            while (from < commit && FindInChunk(buffer, from, start, length))
             {
-                if (ValidateDecimal(number) == false)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (number[0] == '?')
+                if (start >= commit)
                 {
-                    regexPayload.append("[\\x00-\\xFF]");
+                    break;
                 }
-                else
-                {
-                    uint8 n;
-                    const std::from_chars_result resultFrom = std::from_chars(number.data(), number.data() + number.size(), n);
-                    if (resultFrom.ec == std::errc::invalid_argument || resultFrom.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-
-                    char hex[10]                        = { 0 };
-                    const std::to_chars_result resultTo = std::to_chars(std::begin(hex), std::end(hex), n, 16);
-                    if (resultTo.ec == std::errc::invalid_argument || resultTo.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-                    regexPayload.append("\\x");
-                    if (hex[1] == 0)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(hex);
-                }
-            }
-            else
-            {
-                if (number.size() > 2)
+                if (length == 0)
                 {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
+                    from = start + step;
+                    continue;
                 }
 
-                if (ValidateHex(number) == false)
+                if (onMatch(offset + start, length) == false)
                 {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
+                    return true;
                 }
 
-                if (number[0] == '?')
-                {
-                    regexPayload.append("[\\x00-\\xFF]");
-                }
-                else
-                {
-                    regexPayload.append("\\x");
-                    if (number.size() == 1)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(number);
-                }
+                // the last match before a position may overlap the previous one
+                nextAllowed = offset + start + (last ? step : length);
+                from        = static_cast<uint32>(nextAllowed - offset);
             }
-            last = current + 1;
-        } while ((current = input.find_first_of(' ', last)) && last < input.size());
 
-        const std::regex pattern(
-              regexPayload,
-              (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                       : std::regex_constants::ECMAScript | std::regex_constants::optimize));
+            if (isLastChunk)
+            {
+                break;
+            }
+            searched += commit;
+            offset += commit;
+            nextAllowed = std::max<uint64>(nextAllowed, offset);
+        }
 
-        if (computeForFile)
-        {
-            auto offset = currentPos;
-            auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
+        return true;
+    };
 
-            CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-            CHECK(HasResults() == false, true, "");
-        }
-        else
+    auto found         = false;
+    const auto OnMatch = [&](uint64 start, uint64 length)
+    {
+        found = true;
+        if (findAllMatches)
         {
-            for (const auto& zone : selectedZones)
+            if (results.empty())
             {
-                auto offset = zone.start;
-                auto left   = zone.end - zone.start + 1;
-
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
+                match = { start, length };
             }
+            results.emplace_back(start, length);
+            return results.size() < MAX_FIND_ALL_RESULTS;
+        }
+
+        match = { start, length };
+        return last; // keep going only when looking for the last match
+    };
+
+    for (const auto& range : ranges)
+    {
+        CHECK(SearchInRange(range, OnMatch), false, "");
+        if (found && last == false && findAllMatches == false)
+        {
+            return true;
         }
     }
 
-    return false;
+    return found;
 }
 } // namespace GView::View::BufferViewer
@@ -368,7 +368,15 @@ bool Instance::ShowFindDialog()
     findDialog.UpdateData(this->cursor.GetCurrentPosition(), this->obj);
     CHECK(findDialog.Show() == Dialogs::Result::Ok, true, "");
 
-    const auto [start, length] = findDialog.GetNextMatch(this->cursor.GetCurrentPosition());
+    auto result = findDialog.GetNextMatch(this->cursor.GetCurrentPosition());
+    if (findDialog.IsFindAll() && findDialog.HasResults()) {
+        FindAllDialog dlg(this->obj, findDialog.GetResults());
+        CHECK(dlg.Show() == Dialogs::Result::Ok, true, "");
+        result = dlg.GetSelectedMatch();
+        findDialog.SetCurrentMatch(result);
+    }
+
+    const auto [start, length] = result;
     if (start != GView::Utils::INVALID_OFFSET && length != GView::Utils::INVALID_OFFSET) {
         if (findDialog.AlignToUpperRightCorner()) {
             MoveScrollTo(start);
@@ -0,0 +1,152 @@
+#include "BufferViewer.hpp"
+
+#include <cstring>
+
+namespace GView::View::BufferViewer
+{
+// rough frequency of a byte in usual content (files are full of 0x00, 0xFF, spaces and lowercase text) - higher means rarer
+static uint32 ByteRarity(uint8 value)
+{
+    if (value == 0 || value == 0xFF)
+    {
+        return 0;
+    }
+    if (value == ' ' || (value >= 'a' && value <= 'z'))
+    {
+        return 1;
+    }
+    if ((value >= 'A' && value <= 'Z') || (value >= '0' && value <= '9') || value == '\r' || value == '\n')
+    {
+        return 2;
+    }
+    return 3;
+}
+
+static uint8 FirstValue(const std::bitset<256>& values)
+{
+    for (uint32 c = 0; c < 256; c++)
+    {
+        if (values.test(c))
+        {
+            return static_cast<uint8>(c);
+        }
+    }
+    return 0;
+}
+
+bool LiteralSearch::Init(std::vector<std::bitset<256>> patternClasses)
+{
+    Clear();
+    CHECK(patternClasses.empty() == false, false, "");
+    for (const auto& c : patternClasses)
+    {
+        CHECK(c.any(), false, "");
+    }
+
+    classes         = std::move(patternClasses);
+    const auto size = GetLength();
+
+    // the two rarest positions that accept a single value
+    for (uint32 i = 0; i < size; i++)
+    {
+        if (classes[i].count() != 1)
+        {
+            continue;
+        }
+
+        const auto rarity = ByteRarity(FirstValue(classes[i]));
+        if (anchor == NO_ANCHOR || rarity > ByteRarity(FirstValue(classes[anchor])))
+        {
+            secondAnchor = anchor;
+            anchor       = i;
+        }
+        else if (secondAnchor == NO_ANCHOR || rarity > ByteRarity(FirstValue(classes[secondAnchor])))
+        {
+            secondAnchor = i;
+        }
+    }
+
+    shift.fill(size);
+    for (uint32 i = 0; i + 1 < size; i++)
+    {
+        for (uint32 c = 0; c < 256; c++)
+        {
+            if (classes[i].test(c))
+            {
+                shift[c] = size - 1 - i;
+            }
+        }
+    }
+
+    return true;
+}
+
+void LiteralSearch::Clear()
+{
+    classes.clear();
+    anchor       = NO_ANCHOR;
+    secondAnchor = NO_ANCHOR;
+}
+
+bool LiteralSearch::Verify(const uint8* data) const
+{
+    const auto size = GetLength();
+    for (uint32 i = 0; i < size; i++)
+    {
+        if (classes[i].test(data[i]) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LiteralSearch::Find(const uint8* data, uint32 size, uint32 from, uint32& position) const
+{
+    const auto length = GetLength();
+    CHECK(length > 0, false, "");
+    if (size < length || from > size - length)
+    {
+        return false;
+    }
+    const auto lastStart = size - length;
+
+    if (anchor != NO_ANCHOR)
+    {
+        // memchr (vectorized by the C runtime) on the rarest fixed byte, then a second fixed byte, then the whole pattern
+        const auto anchorValue = FirstValue(classes[anchor]);
+        while (from <= lastStart)
+        {
+            const auto found = reinterpret_cast<const uint8*>(memchr(data + from + anchor, anchorValue, lastStart - from + 1));
+            if (found == nullptr)
+            {
+                return false;
+            }
+
+            const auto start = static_cast<uint32>(found - data) - anchor;
+            if ((secondAnchor == NO_ANCHOR || classes[secondAnchor].test(data[start + secondAnchor])) && Verify(data + start))
+            {
+                position = start;
+                return true;
+            }
+            from = start + 1;
+        }
+        return false;
+    }
+
+    // Horspool - every position is a set of values, the shift of a byte is given by the last position (except the final one) that accepts it
+    const auto& lastClass = classes[length - 1];
+    while (from <= lastStart)
+    {
+        const auto value = data[from + length - 1];
+        if (lastClass.test(value) && Verify(data + from))
+        {
+            position = from;
+            return true;
+        }
+        from += shift[value];
+    }
+
+    return false;
+}
+} // namespace GView::View::BufferViewer
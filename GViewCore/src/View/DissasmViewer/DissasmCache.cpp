@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <array>
 #include <filesystem>
 
 #include "DissasmCache.hpp"
@@ -5,14 +7,126 @@
 #include "DissasmCodeZone.hpp"
 #include "DissasmIOHelpers.hpp"
 
+#ifdef BUILD_FOR_WINDOWS
+#    include <Windows.h>
+#    undef GetObject
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 using namespace GView::View::DissasmViewer;
 using namespace AppCUI::Input;
 
+constexpr char DISSASM_CACHE_MAGIC[8]               = { 'G', 'V', 'D', 'S', 'M', 'C', 'H', 0 };
+constexpr uint32 DISSASM_CACHE_VERSION              = 2;
+constexpr uint32 DISSASM_CACHE_HEADER_SIZE          = sizeof(DISSASM_CACHE_MAGIC) + 3 * sizeof(uint32) + 2 * sizeof(uint64);
+constexpr uint32 DISSASM_CACHE_PAYLOAD_ALIGNMENT    = 64;
+constexpr uint32 DISSASM_CACHE_MAX_REGION_NAME_SIZE = 256;
+
+static uint32 ComputeCacheChecksum(const std::byte* data, uint64 size)
+{
+    GView::Hashes::CRC32 crc32;
+    uint32 value = 0;
+    crc32.Init(GView::Hashes::CRC32Type::JAMCRC);
+    while (size > 0) {
+        const uint32 chunkSize = static_cast<uint32>(std::min<uint64>(size, 0x40000000));
+        crc32.Update(reinterpret_cast<const unsigned char*>(data), chunkSize);
+        data += chunkSize;
+        size -= chunkSize;
+    }
+    crc32.Final(value);
+    return value;
+}
+
+DissasmCacheFileMapping::DissasmCacheFileMapping(DissasmCacheFileMapping&& other) noexcept : data(other.data), size(other.size)
+{
+    other.data = nullptr;
+    other.size = 0;
+}
+
+DissasmCacheFileMapping& DissasmCacheFileMapping::operator=(DissasmCacheFileMapping&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        data       = other.data;
+        size       = other.size;
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+DissasmCacheFileMapping::~DissasmCacheFileMapping()
+{
+    Close();
+}
+
+bool DissasmCacheFileMapping::Open(const std::filesystem::path& path)
+{
+    Close();
+#ifdef BUILD_FOR_WINDOWS
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!fileMapping)
+        return false;
+    // the view keeps the mapping alive
+    const void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fileMapping);
+    if (!view)
+        return false;
+    data = static_cast<const std::byte*>(view);
+    size = static_cast<uint64>(fileSize.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat fileInfo = {};
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    // the mapping stays valid after the descriptor is closed
+    void* view = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+    data = static_cast<const std::byte*>(view);
+    size = static_cast<uint64>(fileInfo.st_size);
+#endif
+    return true;
+}
+
+void DissasmCacheFileMapping::Close()
+{
+    if (!data)
+        return;
+#ifdef BUILD_FOR_WINDOWS
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<std::byte*>(data), static_cast<size_t>(size));
+#endif
+    data = nullptr;
+    size = 0;
+}
+
 void DissasmCache::ClearCache(bool forceClear)
 {
     if (!hasCache && !forceClear)
         return;
     zonesData.clear();
+    loadedRegions.clear();
+    mapping.Close();
     cacheFile.Close();
 }
 
@@ -26,6 +140,23 @@ bool DissasmCache::AddRegion(std::string regionName, const std::byte* data, AppC
     return true;
 }
 
+bool DissasmCache::GetRegion(const std::string& regionName, const std::byte*& data, AppCUI::uint32& size)
+{
+    const auto it = loadedRegions.find(regionName);
+    if (it == loadedRegions.end())
+        return false;
+    auto& region = it->second;
+    if (!region.isChecked) {
+        region.isValid   = ComputeCacheChecksum(mapping.GetData() + region.offset, region.size) == region.checksum;
+        region.isChecked = true;
+    }
+    if (!region.isValid)
+        return false;
+    data = mapping.GetData() + region.offset;
+    size = region.size;
+    return true;
+}
+
 std::filesystem::path DissasmCache::GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile)
 {
     constexpr char16 currentLoc  = '.';
@@ -36,84 +167,108 @@ std::filesystem::path DissasmCache::GetCacheFilePath(std::u16string_view fileLoc
     return path;
 }
     
-bool DissasmCache::SaveCacheFile(std::u16string_view location)
+bool DissasmCache::SaveCacheFile(std::u16string_view location, AppCUI::uint64 analyzedFileSize)
 {
     if (zonesData.empty())
         return false;
+
+    // regions are written sorted by name so that the same data always produces the same file
+    std::vector<std::pair<const std::string*, const DissasmCacheEntry*>> regions;
+    regions.reserve(zonesData.size());
+    uint64 directorySize = 0;
+    for (const auto& [name, entry] : zonesData) {
+        regions.emplace_back(&name, &entry);
+        directorySize += sizeof(uint32) + name.size() + sizeof(uint64) + 2 * sizeof(uint32);
+    }
+    std::sort(regions.begin(), regions.end(), [](const auto& a, const auto& b) { return *a.first < *b.first; });
+
+    const auto alignOffset = [](uint64 offset) {
+        return (offset + DISSASM_CACHE_PAYLOAD_ALIGNMENT - 1) & ~static_cast<uint64>(DISSASM_CACHE_PAYLOAD_ALIGNMENT - 1);
+    };
+
+    std::vector<std::byte> directory;
+    directory.reserve(static_cast<size_t>(directorySize));
+    uint64 payloadOffset = alignOffset(DISSASM_CACHE_HEADER_SIZE + directorySize);
+    for (const auto& [name, entry] : regions) {
+        append_string(directory, *name);
+        append_bytes(directory, payloadOffset);
+        append_bytes(directory, entry->size);
+        append_bytes(directory, ComputeCacheChecksum(entry->data.get(), entry->size));
+        payloadOffset = alignOffset(payloadOffset + entry->size);
+    }
+
+    std::vector<std::byte> header;
+    header.reserve(DISSASM_CACHE_HEADER_SIZE);
+    const auto magic = reinterpret_cast<const std::byte*>(DISSASM_CACHE_MAGIC);
+    header.insert(header.end(), magic, magic + sizeof(DISSASM_CACHE_MAGIC));
+    append_bytes(header, DISSASM_CACHE_VERSION);
+    append_bytes(header, static_cast<uint32>(regions.size()));
+    append_bytes(header, static_cast<uint64>(directory.size()));
+    append_bytes(header, ComputeCacheChecksum(directory.data(), directory.size()));
+    append_bytes(header, analyzedFileSize);
+
     const std::filesystem::path filePath(location.begin(), location.end());
-    bool created = cacheFile.Create(filePath, true);
-    if (!created)
-        return false;
-    const uint32 zonesCount = (uint32) zonesData.size();
-    uint32 entrySize;
-    cacheFile.Write((const char*) &zonesCount, sizeof(zonesCount));
-    for (auto& [name, entry] : zonesData) {
-        entrySize = (uint32) name.size();
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(name.data(), entrySize);
-
-        entrySize = entry.size;
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(reinterpret_cast<const char*>(entry.data.get()), entry.size);
+    if (!cacheFile.Create(filePath, true))
+        return false;
+    cacheFile.Write(reinterpret_cast<const char*>(header.data()), static_cast<uint32>(header.size()));
+    cacheFile.Write(reinterpret_cast<const char*>(directory.data()), static_cast<uint32>(directory.size()));
+
+    const std::array<char, DISSASM_CACHE_PAYLOAD_ALIGNMENT> padding = {};
+    uint64 written = header.size() + directory.size();
+    for (const auto& [name, entry] : regions) {
+        const uint64 aligned = alignOffset(written);
+        if (aligned > written)
+            cacheFile.Write(padding.data(), static_cast<uint32>(aligned - written));
+        cacheFile.Write(reinterpret_cast<const char*>(entry->data.get()), entry->size);
+        written = aligned + entry->size;
     }
     cacheFile.Close();
     return true;
 }
 
-bool DissasmCache::LoadCacheFile(std::u16string_view location)
+bool DissasmCache::LoadCacheFile(std::u16string_view location, AppCUI::uint64 analyzedFileSize)
 {
     const std::filesystem::path filePath(location.begin(), location.end());
-    const bool opened = cacheFile.OpenRead(filePath);
-    if (!opened)
-        return false;
-    const auto fileSize = cacheFile.GetSize();
-    if (fileSize == (uint64)-1)
+    if (!mapping.Open(filePath))
         return false;
-    if (fileSize == 0)
-        return true;
-    std::vector<uint8> buffer;
-    buffer.resize((uint32) fileSize);
-    cacheFile.Read(reinterpret_cast<char*>(buffer.data()), (uint32)fileSize);
-    cacheFile.Close();
 
-    if (fileSize < sizeof(uint32))
+    const std::byte* dataPtr    = mapping.GetData();
+    const std::byte* dataPtrEnd = dataPtr + mapping.GetSize();
+    if (mapping.GetSize() < DISSASM_CACHE_HEADER_SIZE || memcmp(dataPtr, DISSASM_CACHE_MAGIC, sizeof(DISSASM_CACHE_MAGIC)) != 0)
         return false;
+    dataPtr += sizeof(DISSASM_CACHE_MAGIC);
 
-    uint32 offset     = 0;
-    uint32 zonesCount = 0;
-    memcpy(&zonesCount, buffer.data() + offset, sizeof(zonesCount));
-    offset += sizeof(zonesCount);
-
-    while (offset < buffer.size()) {
-        if (zonesCount-- == 0)
-            return false;
-        uint32 entrySize;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
-            return false;
-        const auto entryDataName = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
-            return false;
-        std::string_view entryName = { (const char*) entryDataName, entrySize };
+    uint32 version = 0, regionsCount = 0, directoryChecksum = 0;
+    uint64 directorySize = 0, cachedFileSize = 0;
+    if (!read_primitive(dataPtr, dataPtrEnd, version) || version != DISSASM_CACHE_VERSION)
+        return false;
+    if (!read_primitive(dataPtr, dataPtrEnd, regionsCount) || !read_primitive(dataPtr, dataPtrEnd, directorySize) ||
+        !read_primitive(dataPtr, dataPtrEnd, directoryChecksum) || !read_primitive(dataPtr, dataPtrEnd, cachedFileSize))
+        return false;
+    // a cache of another version of the analyzed file
+    if (cachedFileSize != analyzedFileSize)
+        return false;
+    if (directorySize > static_cast<uint64>(dataPtrEnd - dataPtr))
+        return false;
+    if (ComputeCacheChecksum(dataPtr, directorySize) != directoryChecksum)
+        return false;
 
-        if (offset + sizeof(uint32) > buffer.size())
+    const std::byte* directoryEnd = dataPtr + directorySize;
+    loadedRegions.reserve(regionsCount);
+    while (regionsCount-- > 0) {
+        uint32 nameSize       = 0;
+        const std::byte* name = nullptr;
+        DissasmCacheRegion region{};
+        if (!read_string_with_size(dataPtr, directoryEnd, nameSize, name) || nameSize > DISSASM_CACHE_MAX_REGION_NAME_SIZE)
             return false;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
+        if (!read_primitive(dataPtr, directoryEnd, region.offset) || !read_primitive(dataPtr, directoryEnd, region.size) ||
+            !read_primitive(dataPtr, directoryEnd, region.checksum))
             return false;
-        const auto entryData = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
+        if (region.offset > mapping.GetSize() || region.size > mapping.GetSize() - region.offset)
             return false;
-
-        auto newCacheEntry = DissasmCacheEntry{ std::make_unique<std::byte[]>(entrySize), entrySize };
-        memcpy(newCacheEntry.data.get(), entryData, entrySize);
-        zonesData.emplace(entryName, std::move(newCacheEntry));
+        loadedRegions.emplace(std::string(reinterpret_cast<const char*>(name), nameSize), region);
     }
-    return true;
+    return dataPtr == directoryEnd;
 }
 
 bool DisassemblyZone::ToBuffer(std::vector<std::byte>& buffer, Reference<GView::Object> obj) const
@@ -137,7 +292,7 @@ void Instance::LoadCacheData()
     if (!config.EnableDeepScanDissasmOnStart)
         return;
     const std::filesystem::path path = DissasmCache::GetCacheFilePath(obj->GetPath(), config.CacheSameLocationAsAnalyzedFile);
-    if (!cacheData.LoadCacheFile(path.u16string())) {
+    if (!cacheData.LoadCacheFile(path.u16string(), obj->GetData().GetSize())) {
         cacheData.ClearCache(true);
         return;
     }
@@ -170,7 +325,7 @@ void Instance::SaveCacheData()
     }
 
     const std::filesystem::path path = DissasmCache::GetCacheFilePath(obj->GetPath(), config.CacheSameLocationAsAnalyzedFile);
-    cacheData.SaveCacheFile(path.u16string());
+    cacheData.SaveCacheFile(path.u16string(), obj->GetData().GetSize());
 }
 
 bool SettingsData::SaveToCache(DissasmCache& cache, Reference<GView::Object> obj)
@@ -193,14 +348,15 @@ bool SettingsData::ValidateCacheData(DissasmCache& cache, Reference<GView::Objec
     LocalString<64> zoneName;
     for (auto& [start, zone] : disassemblyZones) {
         zoneName.SetFormat("DisassemblyZone.%llu", start);
-        if (!cache.zonesData.contains(zoneName.GetText()))
+        const std::byte* regionData = nullptr;
+        uint32 regionSize           = 0;
+        if (!cache.GetRegion(zoneName.GetText(), regionData, regionSize))
             return false;
-        const auto& entry = cache.zonesData[zoneName.GetText()];
         if (!zone.ToBuffer(buffer, obj))
             return false;
-        if (entry.size != buffer.size())
+        if (regionSize != buffer.size())
             return false;
-        if (memcmp(entry.data.get(), buffer.data(), buffer.size()) != 0)
+        if (memcmp(regionData, buffer.data(), buffer.size()) != 0)
             return false;
     }
     return true;
@@ -228,11 +384,12 @@ bool DissasmCodeZone::TryLoadDataFromCache(DissasmCache& cache)
     LocalString<64> zoneName;
     zoneName.SetFormat("DissasmParseZoneType.%llu", startLineIndex);
 
-    auto it = cache.zonesData.find(zoneName.GetText());
-    if (it == cache.zonesData.end())
+    // the region is read from the mapped cache file only now, when the zone is shown for the first time
+    const std::byte* dataPtr = nullptr;
+    uint32 regionSize        = 0;
+    if (!cache.GetRegion(zoneName.GetText(), dataPtr, regionSize))
         return false;
-    const std::byte* dataPtr    = it->second.data.get();
-    const std::byte* dataPtrEnd = dataPtr + it->second.size;
+    const std::byte* dataPtrEnd = dataPtr + regionSize;
 
     if (dataPtr + sizeof(uint32) > dataPtrEnd)
         return false;
@@ -11,18 +11,64 @@ struct DissasmCacheEntry
     AppCUI::uint32 size;
 };
 
+// A region of a loaded cache file: its payload stays in the mapped file and is checked against its checksum on first access.
+struct DissasmCacheRegion
+{
+    AppCUI::uint64 offset;
+    AppCUI::uint32 size;
+    AppCUI::uint32 checksum;
+    bool isChecked;
+    bool isValid;
+};
+
+// Read-only memory mapping of a whole file (the pages are read by the OS only when they are accessed).
+class DissasmCacheFileMapping
+{
+    const std::byte* data;
+    AppCUI::uint64 size;
+
+  public:
+    DissasmCacheFileMapping() : data(nullptr), size(0)
+    {
+    }
+    DissasmCacheFileMapping(DissasmCacheFileMapping&& other) noexcept;
+    DissasmCacheFileMapping& operator=(DissasmCacheFileMapping&& other) noexcept;
+    ~DissasmCacheFileMapping();
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    const std::byte* GetData() const
+    {
+        return data;
+    }
+    AppCUI::uint64 GetSize() const
+    {
+        return size;
+    }
+};
+
+// Cache file layout (little endian):
+//   header    : magic, version, regions count, directory size, directory checksum, size of the analyzed file
+//   directory : for every region its name, offset, size and checksum
+//   payloads  : every region aligned to DISSASM_CACHE_PAYLOAD_ALIGNMENT
 struct DissasmCache {
     bool hasCache;
     AppCUI::OS::File cacheFile;
-    std::unordered_map<std::string, DissasmCacheEntry> zonesData;
+    std::unordered_map<std::string, DissasmCacheEntry> zonesData;       // regions added to be saved
+    std::unordered_map<std::string, DissasmCacheRegion> loadedRegions; // directory of the loaded cache file
+    DissasmCacheFileMapping mapping;
 
     void ClearCache(bool forceClear = false);
 
     static std::filesystem::path GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile);
     bool AddRegion(std::string regionName, const std::byte* data, AppCUI::uint32 size);
+    // payload of a region of the loaded cache file, false if the region is missing or its checksum does not match
+    bool GetRegion(const std::string& regionName, const std::byte*& data, AppCUI::uint32& size);
 
-    bool SaveCacheFile(std::u16string_view location);
-    bool LoadCacheFile(std::u16string_view location);
+    bool SaveCacheFile(std::u16string_view location, AppCUI::uint64 analyzedFileSize);
+    // only the header and the directory are read, a cache created for a file of a different size is rejected
+    bool LoadCacheFile(std::u16string_view location, AppCUI::uint64 analyzedFileSize);
 };
 
 
@@ -5,90 +5,41 @@ using namespace GView::View::DissasmViewer;
 
 constexpr size_t DISSASM_INSTRUCTION_OFFSET_MARGIN = 500;
 
-const uint8 HEX_MAPPER[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
-                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
-                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15 };
-
-inline bool ExtractCallsToInsertFunctionNames(
-      vector<AsmOffsetLine>& offsets,
-      DissasmCodeZone* zone,
-      Reference<GView::Object> obj,
-      int internalArchitecture,
-      uint32& totalLines,
-      uint64 maxLocationMemoryMappingSize)
+inline bool ExtractCallsToInsertFunctionNames(DissasmCodeZone* zone, uint32& totalLines)
 {
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
-        // WriteErrorToScreen(dli, cs_strerror(resCode));
-        return false;
-    }
-
-    cs_insn* insn = cs_malloc(handle);
-
-    DisassemblyZone& zoneDetails = zone->zoneDetails;
-    const auto instructionData   = obj->GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
-
-    uint32 linesToDecode = totalLines;
-    size_t size          = zoneDetails.size;
-    uint64 address       = offsets[0].offset - zoneDetails.startingZonePoint;
-    auto data            = instructionData.GetData() + address;
+    const DisassemblyZone& zoneDetails = zone->zoneDetails;
+    const auto& instructionIndex       = zone->instructionIndex;
 
+    // call and jump targets come from the control flow recovered by populateOffsetsVector
+    const auto& controlFlow = zone->controlFlow;
     std::vector<std::pair<uint64, std::string>> callsFound;
-    std::unordered_map<uint64, bool> callsMap; // true for offset, false for sub
-    callsFound.reserve(16);
-    bool foundCall     = false;
-    uint64 callAddress = 0;
-    while (cs_disasm_iter(handle, &data, &size, &address, insn) && linesToDecode > 0) {
-        linesToDecode--;
-        const bool isJump = insn->mnemonic[0] == 'j';
-        if (*(uint32*) insn->mnemonic == callOP || isJump) {
-            uint64 value;
-            const bool foundValue = CheckExtractInsnHexValue(insn->op_str, value, maxLocationMemoryMappingSize);
-            if (foundValue && value < zoneDetails.startingZonePoint + zoneDetails.size) {
-                if (value < offsets[0].offset)
-                    value += offsets[0].offset;
-                const char* prefix = isJump ? "offset_0x" : "sub_0x";
-                const auto it      = callsMap.find(value);
-                if (it != callsMap.end()) {
-                    if (isJump == it->second)
-                        continue;
-                }
-                auto callName = FormatFunctionName(value, prefix);
-                callsFound.emplace_back(value, callName.GetText());
-                callsMap.insert({ value, isJump });
-            }
-        } else {
-            const auto mnemonicVal = *(uint32*) insn->mnemonic;
-            if (foundCall) {
-                if (mnemonicVal == movOP && strcmp(insn->op_str, "ebp, esp") == 0) {
-                    if (callAddress < offsets[0].offset)
-                        callAddress += offsets[0].offset;
-                    const auto it = callsMap.find(callAddress);
-                    if (it != callsMap.end()) {
-                        if (!it->second)
-                            continue;
-                    }
-                    const char* prefix = "sub_0x";
-                    auto callName      = FormatFunctionName(callAddress, prefix);
-                    callsFound.emplace_back(callAddress, callName.GetText());
-                    callsMap.insert({ callAddress, true });
-                }
-                foundCall = false;
-            } else {
-                if (mnemonicVal == pushOP) {
-                    if (strcmp(insn->op_str, "ebp") == 0) {
-                        callAddress = insn->address;
-                        foundCall   = true;
-                    }
-                }
-            }
+    callsFound.reserve(controlFlow.functions.size() + 16);
+    for (const auto function : controlFlow.functions)
+        callsFound.emplace_back(function, FormatFunctionName(function, "sub_0x").GetText());
+    uint64 lastTarget = UINT64_MAX;
+    for (const auto& xref : controlFlow.xrefs) {
+        if (xref.type == DissasmControlFlow::ReferenceType::Call || xref.to == lastTarget || controlFlow.IsFunction(xref.to))
+            continue;
+        lastTarget = xref.to;
+        callsFound.emplace_back(xref.to, FormatFunctionName(xref.to, "offset_0x").GetText());
+    }
+
+    // functions only reached through indirect calls are found by their prologue
+    for (uint32 line = 0; line + 1 < instructionIndex.GetCount(); line++) {
+        if ((instructionIndex.flags[line] & DissasmInstructionIndex::FramePush) &&
+            (instructionIndex.flags[line + 1] & DissasmInstructionIndex::FrameSetup)) {
+            const uint64 functionAddress = instructionIndex.offsets[line] + zoneDetails.startingZonePoint;
+            if (!controlFlow.IsFunction(functionAddress))
+                callsFound.emplace_back(functionAddress, FormatFunctionName(functionAddress, "sub_0x").GetText());
         }
     }
 
+    // labels after the last shown instruction have no line to be attached to
+    const uint64 shownCodeEnd = instructionIndex.end + zoneDetails.startingZonePoint;
+    callsFound.erase(
+          std::remove_if(callsFound.begin(), callsFound.end(), [shownCodeEnd](const auto& call) { return call.first >= shownCodeEnd; }), callsFound.end());
+
     if (callsFound.empty()) {
-        cs_free(insn, 1);
-        cs_close(&handle);
         return false;
     }
 
@@ -140,168 +91,63 @@ inline bool ExtractCallsToInsertFunctionNames(
     // callsFound.push_back({ 1140, "call 5" });
     uint32 extraLines = 0;
     for (const auto& call : callsFound) {
-        const uint64 callValue = call.first;
-        uint32 diffLines       = 0;
-        auto callInsn          = GetCurrentInstructionByOffset(callValue, zone, obj, diffLines);
-        if (callInsn) {
+        const uint64 callValue = call.first - zoneDetails.startingZonePoint;
+        uint32 line            = 0;
+        if (instructionIndex.FindLine(callValue, line)) {
             auto& annotations = zone->dissasmType.annotations;
-            annotations.insert({ diffLines + extraLines, { call.second, callValue - offsets[0].offset } });
+            annotations.insert({ line + extraLines, { call.second, callValue } });
             annotations.add_initial_name(call.second);
-            cs_free(callInsn, 1);
             extraLines++;
         }
     }
     totalLines += static_cast<uint32>(callsFound.size());
-    cs_free(insn, 1);
-    cs_close(&handle);
 
     return true;
 }
 
 inline bool populateOffsetsVector(
-      vector<AsmOffsetLine>& offsets, DisassemblyZone& zoneDetails, GView::Object& obj, int internalArchitecture, uint32& totalLines)
+      vector<AsmOffsetLine>& offsets,
+      DisassemblyZone& zoneDetails,
+      GView::Object& obj,
+      int internalArchitecture,
+      DissasmControlFlow& controlFlow,
+      DissasmInstructionIndex& instructionIndex,
+      uint32& totalLines)
 {
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
-        // WriteErrorToScreen(dli, cs_strerror(resCode));
-        return false;
-    }
-
     const auto instructionData = obj.GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
-
-    if (offsets.empty()) {
-        offsets.reserve(256);
-        offsets.push_back({ zoneDetails.entryPoint, 0 });
+    if (!instructionData.IsValid()) {
+        return false;
     }
 
-    size_t minimalValue = offsets[0].offset;
-
-    cs_insn* insn     = cs_malloc(handle);
-    size_t lastOffset = offsets[0].offset;
-
     constexpr uint32 addInstructionsStop = 30; // TODO: update this -> for now it stops, later will fold
 
-    std::list<uint64> finalOffsets;
-
-    size_t size       = zoneDetails.startingZonePoint + zoneDetails.size;
-    uint64 address    = zoneDetails.entryPoint - zoneDetails.startingZonePoint;
-    uint64 endAddress = zoneDetails.size;
-
-    if (address >= endAddress) {
-        cs_close(&handle);
+    if (zoneDetails.entryPoint - zoneDetails.startingZonePoint >= zoneDetails.size) {
         return false;
     }
 
-    auto data = instructionData.GetData() + address;
-
-    // std::string saved1 = "s1", saved2 = "s2";
-    uint64 startingOffset = offsets[0].offset;
-
-    size_t lastSize = size;
-    // std::vector<uint64> tempStorage;
-    // tempStorage.push_back(lastOffset);
-
-    do {
-        if (size > lastSize) {
-            lastSize = size;
-            // tempStorage.reserve(size / DISSASM_INSTRUCTION_OFFSET_MARGIN + 1);
-        }
-
-        while (address < endAddress) {
-            if (!cs_disasm_iter(handle, &data, &size, &address, insn))
-                break;
-
-            if ((insn->mnemonic[0] == 'j' || *(uint32*) insn->mnemonic == callOP)) // && insn->op_str[0] == '0' /* && insn->op_str[1] == 'x'*/)
-            {
-                uint64 computedValue = 0;
-                if (insn->op_str[1] == 'x') {
-                    // uint64 computedValue = 0;
-                    char* ptr = &insn->op_str[2];
-                    // TODO: also check not to overflow access!
-                    while (*ptr && *ptr != ' ' && *ptr != ',') {
-                        if (!(*ptr >= 'a' && *ptr <= 'f' || *ptr >= '0' && *ptr <= '9')) {
-                            computedValue = 0;
-                            break;
-                        }
-                        computedValue = computedValue * 16 + HEX_MAPPER[static_cast<uint8>(*ptr)];
-                        ptr++;
-                    }
-                } else {
-                    char* ptr = &insn->op_str[0];
-                    while (*ptr && *ptr != ' ' && *ptr != ',') {
-                        if (*ptr < '0' || *ptr > '9') {
-                            computedValue = 0;
-                            break;
-                        }
-                        computedValue = computedValue * 10 + (static_cast<uint8>(*ptr) - '0');
-                        ptr++;
-                    }
-                    if (computedValue < zoneDetails.startingZonePoint)
-                        computedValue += zoneDetails.startingZonePoint;
-                    // if (insn->op_str[1] == '\0') {
-                    //     computedValue = zoneDetails.startingZonePoint;
-                    // }
-                }
-
-                if (computedValue < minimalValue && computedValue >= zoneDetails.startingZonePoint) {
-                    minimalValue = computedValue;
-                    // saved1       = insn->mnemonic;
-                    // saved2       = insn->op_str;
-                }
-            }
-            const size_t adjustedSize = address + zoneDetails.startingZonePoint;
-            if (adjustedSize - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
-                lastOffset = adjustedSize;
-            }
-        }
-        if (minimalValue >= startingOffset)
-            break;
-
-        // pushBack                       = false;
-        const size_t zoneSizeToAnalyze = startingOffset - minimalValue;
-        // finalOffsets.push_front(minimalValue);
-
-        address        = minimalValue - zoneDetails.startingZonePoint;
-        endAddress     = zoneSizeToAnalyze + address;
-        size           = address + zoneSizeToAnalyze;
-        data           = instructionData.GetData() + address;
-        lastOffset     = minimalValue;
-        startingOffset = minimalValue;
-    } while (true);
+    // functions, blocks and cross references reachable from the entry point - the labels are added based on them
+    if (!controlFlow.Build(
+              instructionData.GetData(), instructionData.GetLength(), zoneDetails.startingZonePoint, zoneDetails.entryPoint, internalArchitecture)) {
+        return false;
+    }
 
-    size       = zoneDetails.size;
-    address    = minimalValue - zoneDetails.startingZonePoint;
-    data       = instructionData.GetData() + address;
-    lastOffset = address;
+    // the whole zone is shown, including the padding and the code before the entry point
+    if (!instructionIndex.Build(instructionData.GetData(), instructionData.GetLength(), internalArchitecture, addInstructionsStop)) {
+        return false;
+    }
 
-    uint32 lineIndex = 0;
     offsets.clear();
-    offsets.push_back({ minimalValue, 0 });
-
-    constexpr uint32 alOpStr         = 7102752u; //* (uint32*) " al";
-    uint32 continuousAddInstructions = 0;
-
-    while (cs_disasm_iter(handle, &data, &size, &address, insn)) {
-        lineIndex++;
+    offsets.push_back({ zoneDetails.startingZonePoint, 0 });
+    uint32 lastOffset = 0;
+    for (uint32 line = 1; line <= instructionIndex.GetCount(); line++) {
+        const uint32 address = line < instructionIndex.GetCount() ? instructionIndex.offsets[line] : instructionIndex.end;
         if (address - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
-            lastOffset                = address;
-            const size_t adjustedSize = address + zoneDetails.startingZonePoint;
-            offsets.push_back({ adjustedSize, lineIndex });
+            lastOffset = address;
+            offsets.push_back({ address + zoneDetails.startingZonePoint, line });
         }
-
-        if (*(uint32*) insn->mnemonic == addOP && insn->op_str[0] == 'b' && *(uint32*) &insn->op_str[15] == alOpStr) {
-            if (++continuousAddInstructions == addInstructionsStop) {
-                lineIndex -= continuousAddInstructions;
-                break;
-            }
-        } else
-            continuousAddInstructions = 0;
     }
 
-    totalLines = lineIndex;
-    cs_free(insn, 1);
-    cs_close(&handle);
+    totalLines = instructionIndex.GetCount();
     return true;
 }
 
@@ -329,12 +175,12 @@ bool GView::View::DissasmViewer::DissasmCodeZone::InitZone(DissasmCodeZoneInitDa
     }
 
     uint32 totalLines = 0;
-    if (!populateOffsetsVector(cachedCodeOffsets, zoneDetails, initData.obj, internalArchitecture, totalLines)) {
+    if (!populateOffsetsVector(cachedCodeOffsets, zoneDetails, initData.obj, internalArchitecture, controlFlow, instructionIndex, totalLines)) {
         initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
         return false;
     }
     if (initData.enableDeepScanDissasmOnStart &&
-        !ExtractCallsToInsertFunctionNames(cachedCodeOffsets, this, initData.obj, internalArchitecture, totalLines, initData.maxLocationMemoryMappingSize)) {
+        !ExtractCallsToInsertFunctionNames(this, totalLines)) {
         initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
         return false;
     }
@@ -409,18 +255,11 @@ void DissasmCodeZone::ReachZoneLine(uint32 line)
     }
 
     DissasmCodeInternalType& currentType = types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
-    // TODO: maybe use some caching here?
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
-        currentType.textLinesPassed = 0;
-        currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
-        }
+        // jumps are answered by a binary search over the annotation lines instead of walking every line
+        const uint32 linesPassed    = levelToReach >= currentType.indexZoneStart ? levelToReach - currentType.indexZoneStart + 1 : 0;
+        currentType.textLinesPassed = currentType.annotations.CountLinesInRange(currentType.indexZoneStart, levelToReach);
+        currentType.asmLinesPassed  = linesPassed - currentType.textLinesPassed;
     } else {
         if (currentType.annotations.contains(levelToReach))
             currentType.textLinesPassed++;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "DissasmViewer.hpp"
+#include "DissasmControlFlow.hpp"
+#include "DissasmInstructionIndex.hpp"
 
 namespace GView::View::DissasmViewer
 {
@@ -24,6 +26,8 @@ struct DissasmCodeZone : public ParseZone {
     DissasmAsmPreCacheData asmPreCacheData;
 
     std::vector<AsmOffsetLine> cachedCodeOffsets;
+    DissasmControlFlow controlFlow;
+    DissasmInstructionIndex instructionIndex; // empty when the zone was loaded from the cache
     DisassemblyZone zoneDetails;
     int internalArchitecture; // used for dissasm libraries
     bool isInit;
@@ -0,0 +1,117 @@
+#include "DissasmControlFlow.hpp"
+#include "Internal.hpp"
+
+#include <algorithm>
+
+using namespace GView::View::DissasmViewer;
+
+void DissasmControlFlow::Clear()
+{
+    blocks.clear();
+    functions.clear();
+    xrefs.clear();
+    visited.clear();
+}
+
+bool DissasmControlFlow::IsFunction(uint64 address) const
+{
+    return std::binary_search(functions.begin(), functions.end(), address);
+}
+
+void DissasmControlFlow::SplitBlockAt(uint64 address)
+{
+    auto it = blocks.upper_bound(address);
+    if (it == blocks.begin())
+        return;
+    --it;
+    auto& block = it->second;
+    if (block.start == address || address >= block.end)
+        return;
+    blocks.insert({ address, { address, block.end } });
+    block.end = address;
+}
+
+bool DissasmControlFlow::Build(const uint8* data, uint64 size, uint64 baseOffset, uint64 entryPoint, int internalArchitecture)
+{
+    Clear();
+    CHECK(data != nullptr && entryPoint >= baseOffset && entryPoint - baseOffset < size, false, "");
+
+    GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), true);
+    CHECK(capstone.IsValid(), false, "");
+    const csh handle    = capstone.GetHandle();
+    const cs_insn* insn = capstone.GetInstruction();
+
+    const uint64 endOffset = baseOffset + size;
+    visited.assign(static_cast<size_t>((size + 63) / 64), 0);
+
+    std::vector<uint64> worklist;
+    worklist.push_back(entryPoint);
+    functions.push_back(entryPoint);
+
+    const auto addTarget = [&](uint64 from, uint64 to, ReferenceType type) {
+        if (to < baseOffset || to >= endOffset)
+            return;
+        xrefs.push_back({ from, to, type });
+        if (type == ReferenceType::Call)
+            functions.push_back(to);
+        worklist.push_back(to);
+    };
+
+    while (!worklist.empty()) {
+        const uint64 start = worklist.back();
+        worklist.pop_back();
+        if (IsVisited(start - baseOffset)) {
+            // already decoded => it only has to begin a block
+            SplitBlockAt(start);
+            continue;
+        }
+
+        const uint8* code = data + (start - baseOffset);
+        size_t remaining  = static_cast<size_t>(endOffset - start);
+        uint64 address    = start;
+        while (remaining > 0) {
+            if (IsVisited(address - baseOffset)) {
+                // falls through into code decoded from another target
+                SplitBlockAt(address);
+                break;
+            }
+            if (!capstone.DissasembleNext(code, remaining, address))
+                break;
+            SetVisited(insn->address - baseOffset);
+
+            const auto& x86      = insn->detail->x86;
+            const bool hasTarget = x86.op_count == 1 && x86.operands[0].type == X86_OP_IMM;
+            const uint64 target  = static_cast<uint64>(x86.operands[0].imm);
+
+            if (cs_insn_group(handle, insn, CS_GRP_CALL)) {
+                if (hasTarget)
+                    addTarget(insn->address, target, ReferenceType::Call);
+                continue;
+            }
+            if (cs_insn_group(handle, insn, CS_GRP_JUMP)) {
+                const bool isUnconditional = insn->id == X86_INS_JMP || insn->id == X86_INS_LJMP;
+                if (hasTarget)
+                    addTarget(insn->address, target, isUnconditional ? ReferenceType::Jump : ReferenceType::ConditionalJump);
+                if (!isUnconditional && address < endOffset)
+                    worklist.push_back(address);
+                break;
+            }
+            if (cs_insn_group(handle, insn, CS_GRP_RET) || cs_insn_group(handle, insn, CS_GRP_IRET) || insn->id == X86_INS_HLT ||
+                insn->id == X86_INS_UD2 || insn->id == X86_INS_INT3)
+                break;
+        }
+
+        if (address > start)
+            blocks.insert({ start, { start, address } });
+    }
+    visited.clear();
+    visited.shrink_to_fit();
+
+    std::sort(functions.begin(), functions.end());
+    functions.erase(std::unique(functions.begin(), functions.end()), functions.end());
+    std::sort(xrefs.begin(), xrefs.end(), [](const CrossReference& a, const CrossReference& b) {
+        return a.to < b.to || (a.to == b.to && a.from < b.from);
+    });
+
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <AppCUI/include/AppCUI.hpp>
+
+namespace GView::View::DissasmViewer
+{
+// Recursive descent over the x86/x64 code of a zone: starting from the entry point, follows the direct branch and call targets
+// reported by the Capstone detail operands. All the addresses are file offsets.
+struct DissasmControlFlow {
+    enum class ReferenceType : AppCUI::uint8 { Call, Jump, ConditionalJump };
+
+    struct BasicBlock {
+        AppCUI::uint64 start;
+        AppCUI::uint64 end; // first byte after the last instruction
+    };
+    struct CrossReference {
+        AppCUI::uint64 from; // address of the branch instruction
+        AppCUI::uint64 to;
+        ReferenceType type;
+    };
+
+    std::map<AppCUI::uint64, BasicBlock> blocks; // ordered by the start of the block
+    std::vector<AppCUI::uint64> functions;       // entry point and call targets, sorted
+    std::vector<CrossReference> xrefs;           // sorted by target
+
+    void Clear();
+    bool Build(const AppCUI::uint8* data, AppCUI::uint64 size, AppCUI::uint64 baseOffset, AppCUI::uint64 entryPoint, int internalArchitecture);
+
+    bool IsFunction(AppCUI::uint64 address) const;
+    AppCUI::uint64 GetLowestAddress() const
+    {
+        return blocks.empty() ? UINT64_MAX : blocks.begin()->first;
+    }
+
+  private:
+    // one bit per byte of the zone, set for every address where an instruction was decoded
+    std::vector<AppCUI::uint64> visited;
+
+    bool IsVisited(AppCUI::uint64 index) const
+    {
+        return (visited[index >> 6] >> (index & 63)) & 1;
+    }
+    void SetVisited(AppCUI::uint64 index)
+    {
+        visited[index >> 6] |= 1ULL << (index & 63);
+    }
+    void SplitBlockAt(AppCUI::uint64 address);
+};
+} // namespace GView::View::DissasmViewer
@@ -126,6 +126,15 @@ void AnnotationContainer::ToBuffer(std::vector<std::byte>& buffer) const
     }
 }
 
+void AnnotationContainer::RebuildLinesIndex() const
+{
+    linesIndex.clear();
+    linesIndex.reserve(mappings.size());
+    for (const auto& annotation : mappings)
+        linesIndex.push_back(annotation.first);
+    linesIndexIsValid = true;
+}
+
 bool AnnotationContainer::LoadFromBuffer(const std::byte*& start, const std::byte* end)
 {
     if (start + sizeof(uint32) > end)
@@ -146,6 +155,7 @@ bool AnnotationContainer::LoadFromBuffer(const std::byte*& start, const std::byt
             return false;
         std::string annName((const char*) annotation, annotationSize);
         mappings[offset] = { std::move(annName), callValue };
+        linesIndexIsValid = false;
         --annotationsCount;
     }
 
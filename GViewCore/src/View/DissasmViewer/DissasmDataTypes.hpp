@@ -2,6 +2,8 @@
 
 #include "Internal.hpp"
 
+#include <algorithm>
+
 namespace GView
 {
 namespace View
@@ -89,27 +91,32 @@ namespace View
 
             std::pair<iterator, bool> insert(const value_type& v)
             {
+                linesIndexIsValid = false;
                 return mappings.insert(v);
             }
 
             template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
             std::pair<iterator, bool> insert(P&& v)
             {
+                linesIndexIsValid = false;
                 return mappings.insert(std::forward<P>(v));
             }
 
             template <class InputIt>
             void insert(InputIt first, InputIt last)
             {
+                linesIndexIsValid = false;
                 mappings.insert(first, last);
             }
 
             mapped_type& operator[](const key_type& k)
             {
+                linesIndexIsValid = false;
                 return mappings[k];
             }
             mapped_type& operator[](key_type&& k)
             {
+                linesIndexIsValid = false;
                 return mappings[std::move(k)];
             }
 
@@ -173,14 +180,38 @@ namespace View
 
             void populate_annotations_from_other_storage(const AnnotationContainer& other)
             {
+                linesIndexIsValid = false;
                 mappings.insert(other.mappings.begin(), other.mappings.end());
                 initial_name_to_current_name.insert(other.initial_name_to_current_name.begin(), other.initial_name_to_current_name.end());
                 current_name_to_initial_name.insert(other.current_name_to_initial_name.begin(), other.current_name_to_initial_name.end());
             }
 
+            // number of annotations placed on the lines [0, line]
+            uint32 CountLinesUntil(AnnoationLineNumberType line) const
+            {
+                if (!linesIndexIsValid)
+                    RebuildLinesIndex();
+                return static_cast<uint32>(std::upper_bound(linesIndex.begin(), linesIndex.end(), line) - linesIndex.begin());
+            }
+
+            // number of annotations placed on the lines [firstLine, lastLine]
+            uint32 CountLinesInRange(AnnoationLineNumberType firstLine, AnnoationLineNumberType lastLine) const
+            {
+                if (lastLine < firstLine)
+                    return 0;
+                return CountLinesUntil(lastLine) - (firstLine > 0 ? CountLinesUntil(firstLine - 1) : 0);
+            }
+
             uint32 GetRequiredSizeForSerialization() const;
             void ToBuffer(std::vector<std::byte>& buffer) const;
             bool LoadFromBuffer(const std::byte*& start, const std::byte* end);
+
+          private:
+            // sorted annotation lines, rebuilt by the first query after the annotations changed
+            mutable std::vector<AnnoationLineNumberType> linesIndex;
+            mutable bool linesIndexIsValid = false;
+
+            void RebuildLinesIndex() const;
         };
 
 
@@ -152,12 +152,16 @@ AsmOffsetLine SearchForClosestAsmOffsetLineByOffset(const std::vector<AsmOffsetL
 }
 
 cs_insn* GetCurrentInstructionByOffset(
-      uint64 offsetToReach, DissasmCodeZone* zone, Reference<GView::Object> obj, uint32& diffLines, DrawLineInfo* dli)
+      uint64 offsetToReach, DissasmCodeZone* zone, Reference<GView::Object> obj, GView::Dissasembly::CapstoneHandle& capstone, uint32& diffLines, DrawLineInfo* dli)
 {
-    const auto closestData = SearchForClosestAsmOffsetLineByOffset(zone->cachedCodeOffsets, offsetToReach);
-    zone->lastClosestLine  = closestData.line;
-    zone->asmAddress       = closestData.offset - zone->cachedCodeOffsets[0].offset;
-    zone->asmSize          = zone->zoneDetails.size - zone->asmAddress;
+    const uint64 zoneStart    = zone->cachedCodeOffsets[0].offset;
+    AsmOffsetLine closestData = SearchForClosestAsmOffsetLineByOffset(zone->cachedCodeOffsets, offsetToReach);
+    uint32 line               = 0;
+    if (offsetToReach >= zoneStart && zone->instructionIndex.FindLine(offsetToReach - zoneStart, line))
+        closestData = { zoneStart + zone->instructionIndex.offsets[line], line }; // start right at the instruction
+    zone->lastClosestLine = closestData.line;
+    zone->asmAddress      = closestData.offset - zoneStart;
+    zone->asmSize         = zone->zoneDetails.size - zone->asmAddress;
 
     // TODO: maybe get less data ?
     const auto instructionData = obj->GetData().Get(zone->cachedCodeOffsets[0].offset + zone->asmAddress, static_cast<uint32>(zone->asmSize), false);
@@ -171,33 +175,28 @@ cs_insn* GetCurrentInstructionByOffset(
 
     zone->asmData = const_cast<uint8*>(zone->lastData.GetData());
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
+    if (!capstone.IsValid()) {
         if (dli)
-            dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
+            dli->WriteErrorToScreen(cs_strerror(capstone.GetError()));
         return nullptr;
     }
 
-    diffLines     = 0;
-    cs_insn* insn = cs_malloc(handle);
+    diffLines = 0;
     if (offsetToReach >= zone->cachedCodeOffsets[0].offset)
         offsetToReach -= zone->cachedCodeOffsets[0].offset;
+    size_t asmSize = static_cast<size_t>(zone->asmSize);
     while (zone->asmAddress <= offsetToReach) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!capstone.DissasembleNext(zone->asmData, asmSize, zone->asmAddress)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
+            zone->asmSize = asmSize;
             return nullptr;
         }
         diffLines++;
     }
+    zone->asmSize = asmSize;
     diffLines += closestData.line - 1;
-    cs_close(&handle);
-    return insn;
+    return capstone.GetInstruction();
 }
 
 AsmOffsetLine SearchForClosestAsmOffsetLineByLine(const std::vector<AsmOffsetLine>& values, uint64 searchedLine, uint32* index)
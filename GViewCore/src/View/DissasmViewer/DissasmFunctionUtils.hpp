@@ -2,11 +2,12 @@
 #include "AppCUI/include/AppCUI.hpp"
 #include "Internal.hpp"
 
-constexpr uint32 callOP = 1819042147u; //*(uint32*) "call";
-constexpr uint32 addOP  = 6579297u;    //*((uint32*) "add");
-constexpr uint32 pushOP = 1752397168u; //*((uint32*) "push");
-constexpr uint32 movOP  = 7761773u;    //*((uint32*) "mov");
-constexpr uint32 retOP  = 7628146u;    //*((uint32*) "ret");
+constexpr uint32 callOP  = 1819042147u; //*(uint32*) "call";
+constexpr uint32 addOP   = 6579297u;    //*((uint32*) "add");
+constexpr uint32 pushOP  = 1752397168u; //*((uint32*) "push");
+constexpr uint32 movOP   = 7761773u;    //*((uint32*) "mov");
+constexpr uint32 retOP   = 7628146u;    //*((uint32*) "ret");
+constexpr uint32 alOpStr = 7102752u;    //*((uint32*) " al");
 
 // TODO: maybe add also minimum number?
 bool CheckExtractInsnHexValue(const char* op_str, AppCUI::uint64& value, AppCUI::uint64 maxSize);
@@ -16,6 +17,7 @@ cs_insn* GetCurrentInstructionByOffset(
       uint64 offsetToReach,
       GView::View::DissasmViewer::DissasmCodeZone* zone,
       Reference<GView::Object> obj,
+      GView::Dissasembly::CapstoneHandle& capstone,
       uint32& diffLines,
       GView::View::DissasmViewer::DrawLineInfo* dli = nullptr);
 
@@ -0,0 +1,159 @@
+#include "DissasmInstructionIndex.hpp"
+#include "DissasmFunctionUtils.hpp"
+
+#include <algorithm>
+
+using namespace GView::View::DissasmViewer;
+
+constexpr uint32 INSTRUCTION_INDEX_CHUNK_SIZE = 256 * 1024;
+constexpr uint32 NO_DECODING_FAILURE          = UINT32_MAX;
+
+struct InstructionIndexChunk {
+    std::vector<uint32> offsets;
+    std::vector<uint8> flags;
+    uint32 failedAt{ NO_DECODING_FAILURE };
+    bool hasHandle{ false };
+};
+
+static uint8 GetInstructionFlags(const cs_insn* insn)
+{
+    const auto mnemonic = *(const uint32*) insn->mnemonic;
+    if (mnemonic == addOP && insn->op_str[0] == 'b' && *(const uint32*) &insn->op_str[15] == alOpStr)
+        return DissasmInstructionIndex::Padding;
+    if (insn->mnemonic[0] == 'j')
+        return DissasmInstructionIndex::Jump;
+    if (mnemonic == callOP)
+        return DissasmInstructionIndex::Call;
+    if (mnemonic == retOP)
+        return DissasmInstructionIndex::Return;
+    if (mnemonic == pushOP && strcmp(insn->op_str, "ebp") == 0)
+        return DissasmInstructionIndex::FramePush;
+    if (mnemonic == movOP && strcmp(insn->op_str, "ebp, esp") == 0)
+        return DissasmInstructionIndex::FrameSetup;
+    return DissasmInstructionIndex::None;
+}
+
+static void DecodeChunk(const uint8* data, uint32 size, uint32 start, uint32 chunkEnd, int internalArchitecture, InstructionIndexChunk& chunk)
+{
+    GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture));
+    chunk.hasHandle = capstone.IsValid();
+    if (!chunk.hasHandle)
+        return;
+
+    const cs_insn* insn = capstone.GetInstruction();
+    const uint8* code   = data + start;
+    size_t remaining    = size - start;
+    uint64 address      = start;
+    chunk.offsets.reserve((chunkEnd - start) / 3);
+    chunk.flags.reserve((chunkEnd - start) / 3);
+    while (address < chunkEnd) {
+        if (!capstone.DissasembleNext(code, remaining, address)) {
+            chunk.failedAt = static_cast<uint32>(address);
+            return;
+        }
+        chunk.offsets.push_back(static_cast<uint32>(insn->address));
+        chunk.flags.push_back(GetInstructionFlags(insn));
+    }
+}
+
+void DissasmInstructionIndex::Clear()
+{
+    offsets.clear();
+    flags.clear();
+    end = 0;
+}
+
+bool DissasmInstructionIndex::Build(const uint8* data, uint32 size, int internalArchitecture, uint32 paddingInstructionsStop)
+{
+    Clear();
+    CHECK(data != nullptr && size > 0, false, "");
+
+    const uint32 chunksCount = (size - 1) / INSTRUCTION_INDEX_CHUNK_SIZE + 1;
+    std::vector<InstructionIndexChunk> chunks(chunksCount);
+    GView::Utils::ParallelFor(chunksCount, [&](uint32 index, uint32) {
+        const uint32 start = index * INSTRUCTION_INDEX_CHUNK_SIZE;
+        DecodeChunk(data, size, start, std::min<uint32>(start + INSTRUCTION_INDEX_CHUNK_SIZE, size), internalArchitecture, chunks[index]);
+    });
+
+    GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture));
+    CHECK(capstone.IsValid(), false, "");
+    const cs_insn* insn = capstone.GetInstruction();
+
+    offsets.reserve(std::max<size_t>(chunks[0].offsets.size(), 1) * chunksCount);
+    flags.reserve(offsets.capacity());
+
+    uint32 next  = 0; // the first offset (on the instructions already added) that was not added yet
+    bool stopped = false;
+    for (uint32 index = 0; index < chunksCount && !stopped; index++) {
+        auto& chunk = chunks[index];
+        CHECK(chunk.hasHandle, false, "");
+        const uint32 chunkEnd = std::min<uint32>((index + 1) * INSTRUCTION_INDEX_CHUNK_SIZE, size);
+
+        // decode one by one until this chunk reaches the same instruction boundary
+        auto it = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), next);
+        while (next < chunkEnd && (it == chunk.offsets.end() || *it != next)) {
+            const uint8* code = data + next;
+            size_t remaining  = size - next;
+            uint64 address    = next;
+            if (!capstone.DissasembleNext(code, remaining, address)) {
+                stopped = true;
+                break;
+            }
+            offsets.push_back(next);
+            flags.push_back(GetInstructionFlags(insn));
+            next = static_cast<uint32>(address);
+            it   = std::lower_bound(it, chunk.offsets.end(), next);
+        }
+        if (stopped || next >= chunkEnd)
+            continue;
+
+        const auto first = static_cast<size_t>(it - chunk.offsets.begin());
+        offsets.insert(offsets.end(), chunk.offsets.begin() + first, chunk.offsets.end());
+        flags.insert(flags.end(), chunk.flags.begin() + first, chunk.flags.end());
+        if (chunk.failedAt != NO_DECODING_FAILURE) {
+            // the same bytes fail to decode no matter where the decoding started from
+            stopped = true;
+            next    = chunk.failedAt;
+            break;
+        }
+
+        // the last instruction may end inside the next chunk
+        const uint8* code = data + offsets.back();
+        size_t remaining  = size - offsets.back();
+        uint64 address    = offsets.back();
+        CHECK(capstone.DissasembleNext(code, remaining, address), false, "");
+        next = static_cast<uint32>(address);
+
+        chunk.offsets.clear();
+        chunk.offsets.shrink_to_fit();
+        chunk.flags.clear();
+        chunk.flags.shrink_to_fit();
+    }
+    end = next;
+
+    uint32 continuousPadding = 0;
+    for (size_t i = 0; i < flags.size(); i++) {
+        if (!(flags[i] & Padding)) {
+            continuousPadding = 0;
+            continue;
+        }
+        if (++continuousPadding == paddingInstructionsStop) {
+            const size_t count = i + 1 - paddingInstructionsStop;
+            end                = count < offsets.size() ? offsets[count] : end;
+            offsets.resize(count);
+            flags.resize(count);
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool DissasmInstructionIndex::FindLine(uint64 offset, uint32& line) const
+{
+    if (offsets.empty() || offset < offsets[0] || offset >= end)
+        return false;
+    const auto it = std::upper_bound(offsets.begin(), offsets.end(), offset);
+    line          = static_cast<uint32>(it - offsets.begin()) - 1;
+    return true;
+}
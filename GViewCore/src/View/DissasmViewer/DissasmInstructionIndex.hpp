@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include <AppCUI/include/AppCUI.hpp>
+
+namespace GView::View::DissasmViewer
+{
+// Offset (relative to the start of the zone) and flags of every instruction shown for a code zone, one entry per line.
+// The zone is split in chunks disassembled in parallel. Decoding a chunk from its first byte may start in the middle of an
+// instruction, but x86 decoding resynchronizes after a few instructions, so every chunk is stitched to the previous ones
+// from the first instruction boundary they have in common.
+struct DissasmInstructionIndex {
+    enum Flags : AppCUI::uint8 {
+        None       = 0,
+        Jump       = 1,
+        Call       = 2,
+        Return     = 4,
+        Padding    = 8,  // add byte ptr [reg], al => 00 00 bytes
+        FramePush  = 16, // push ebp
+        FrameSetup = 32, // mov ebp, esp
+    };
+
+    std::vector<AppCUI::uint32> offsets;
+    std::vector<AppCUI::uint8> flags;
+    AppCUI::uint32 end{ 0 }; // first byte after the last instruction
+
+    void Clear();
+    // stops after the last instruction that precedes paddingInstructionsStop consecutive padding instructions
+    bool Build(const AppCUI::uint8* data, AppCUI::uint32 size, int internalArchitecture, AppCUI::uint32 paddingInstructionsStop);
+
+    AppCUI::uint32 GetCount() const
+    {
+        return static_cast<AppCUI::uint32>(offsets.size());
+    }
+    bool IsEmpty() const
+    {
+        return offsets.empty();
+    }
+    AppCUI::uint32 GetSize(AppCUI::uint32 line) const
+    {
+        return (line + 1 < offsets.size() ? offsets[line + 1] : end) - offsets[line];
+    }
+    // the line of the instruction that contains offset
+    bool FindLine(AppCUI::uint64 offset, AppCUI::uint32& line) const;
+};
+} // namespace GView::View::DissasmViewer
@@ -3,6 +3,7 @@
 #include "x86_x64/DissasmX86.hpp"
 #include "DissasmFunctionUtils.hpp"
 #include <array>
+#include <algorithm>
 
 using namespace GView::View::DissasmViewer;
 
@@ -565,11 +566,33 @@ TEST_CASE("DissasmFunctions", "[Dissasm]Functions")
     REQUIRE(!CheckExtractInsnHexValue("mov [0x123], eax", value, 5));
 }
 
+TEST_CASE("DissasmControlFlow", "[Dissasm]ControlFlow")
+{
+    DissasmControlFlow controlFlow;
+    REQUIRE(controlFlow.Build(exampleTest1BinaryCode, exampleTest1BinaryCodeSize, 0, 10, CS_MODE_32));
+
+    // the entry point jumps to 0x2B0, which calls the thunks at 0x5 and 0xF
+    REQUIRE(controlFlow.functions == std::vector<uint64>{ 0x5, 0xA, 0xF });
+    REQUIRE(controlFlow.IsFunction(0xA));
+    REQUIRE(!controlFlow.IsFunction(0x30));
+    REQUIRE(controlFlow.GetLowestAddress() == 0x5);
+    REQUIRE(controlFlow.blocks.contains(0x2B0));
+    REQUIRE(controlFlow.blocks.at(0xA).end == 0xF);
+
+    const auto it = std::find_if(controlFlow.xrefs.begin(), controlFlow.xrefs.end(), [](const auto& xref) { return xref.to == 0x2B0; });
+    REQUIRE(it != controlFlow.xrefs.end());
+    REQUIRE(it->from == 0xA);
+    REQUIRE(it->type == DissasmControlFlow::ReferenceType::Jump);
+
+    // the jump table used by the switch at 0x7A is data => nothing inside it is decoded
+    REQUIRE(!controlFlow.blocks.contains(0x18E));
+}
+
 TEST_CASE("AddAndCollapseCollapsibleZones", "[Dissasm]CollapsibleZones")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
 
-    uint32 zoneEndingIndex = 4572;
+    uint32 zoneEndingIndex = 4571;
 
     REQUIRE(dissasmInstance.CheckLineMnemonic(6, "jmp"));
     REQUIRE(dissasmInstance.CheckLineMnemonic(0, "int3"));
@@ -621,7 +644,7 @@ TEST_CASE("AddAndCollapseCollapsibleZones", "[Dissasm]CollapsibleZones")
 TEST_CASE("AddAndCollapseCollapsibleZones2", "[Dissasm]CollapsibleZones")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
-    uint32 zoneEndingIndex = 4572;
+    uint32 zoneEndingIndex = 4571;
 
     std::array<const char*, 47> mnemonicArrayStart = { "int3", "int3",
                                                        "int3", "int3",
@@ -705,7 +728,7 @@ TEST_CASE("GenricRemoveCollapsibleZone", "[Dissasm]CollapsibleZones")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
 
-    uint32 zoneEndingIndex = 4572;
+    uint32 zoneEndingIndex = 4571;
     // dissasmInstance.PrintInstructions(50);
     REQUIRE(dissasmInstance.CheckLineMnemonic(0, "int3"));
     REQUIRE(dissasmInstance.CheckLineMnemonic(1, "int3"));
@@ -776,7 +799,7 @@ TEST_CASE("RemoveCollapsibleZoneSpecialCases", "[Dissasm]CollapsibleZones")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
 
-    uint32 zoneEndingIndex = 4572;
+    uint32 zoneEndingIndex = 4571;
     // dissasmInstance.PrintInstructions(20);
     REQUIRE(dissasmInstance.CheckLineMnemonic(0, "int3"));
     REQUIRE(dissasmInstance.CheckLineMnemonic(1, "int3"));
@@ -839,7 +862,7 @@ TEST_CASE("ValidatingComments", "[Dissasm]Comments")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
 
-    uint32 zoneEndingIndex = 4572;
+    uint32 zoneEndingIndex = 4571;
     // dissasmInstance.PrintInstructions(20);
     REQUIRE(dissasmInstance.CheckLineMnemonic(0, "int3"));
     REQUIRE(dissasmInstance.CheckLineMnemonic(1, "int3"));
@@ -906,4 +929,19 @@ TEST_CASE("ValidatingComments", "[Dissasm]Comments")
         REQUIRE(dissasmInstance.RemoveComment(5));
         REQUIRE(!dissasmInstance.HasComment(5));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("AnnotationLinesCount", "[Dissasm]Annotations")
+{
+    AnnotationContainer annotations;
+    annotations.insert({ 3, { "sub_0x3", 3 } });
+    annotations.insert({ 10, { "offset_0xA", 10 } });
+    REQUIRE(annotations.CountLinesUntil(2) == 0);
+    REQUIRE(annotations.CountLinesUntil(3) == 1);
+    REQUIRE(annotations.CountLinesInRange(4, 10) == 1);
+    REQUIRE(annotations.CountLinesInRange(11, 4) == 0);
+
+    // the index is refreshed after every change
+    annotations[7] = { "sub_0x7", 7 };
+    REQUIRE(annotations.CountLinesInRange(0, 100) == 3);
+    REQUIRE(annotations.CountLinesInRange(4, 7) == 1);
+}
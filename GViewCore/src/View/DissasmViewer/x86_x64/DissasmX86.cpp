@@ -18,6 +18,8 @@ constexpr uint32 DISSASM_ASSISTANT_MAX_DISSASM_LINES_SENT     = 100;
 constexpr uint32 DISSASM_ASSISTANT_MAX_DISSASM_LINES_ANALYSED = 150;
 constexpr uint32 DISSASM_ASSISTANT_MAX_API_CALLS              = 10;
 constexpr uint32 DISSASM_ASSISTANT_MAX_BYTE_TO_SEND           = 640;
+constexpr uint32 EXPORT_INSTRUCTIONS_BATCH_SIZE               = 256;
+constexpr uint32 EXPORT_INSTRUCTIONS_CHUNK_LINES              = 16384;
 
 #pragma warning(disable : 4996) // The POSIX name for this item is deprecated. Instead, use the ISO C and C++ conformant name
 
@@ -229,23 +231,35 @@ inline void DissasmAddColorsToInstruction(
 }
 
 inline cs_insn* GetCurrentInstructionByLine(
-      uint32 lineToReach, DissasmCodeZone* zone, Reference<GView::Object> obj, uint32& diffLines, DrawLineInfo* dli = nullptr)
+      uint32 lineToReach,
+      DissasmCodeZone* zone,
+      Reference<GView::Object> obj,
+      GView::Dissasembly::CapstoneHandle& capstone,
+      uint32& diffLines,
+      DrawLineInfo* dli = nullptr)
 {
     uint32 lineDifferences = 1;
     // TODO: first or be transformed into an abs ?
     const bool lineIsAtMargin = lineToReach >= zone->offsetCacheMaxLine;
     if (lineToReach < zone->lastDrawnLine || lineToReach - zone->lastDrawnLine > 1 || lineIsAtMargin) {
         // TODO: can be inlined as function
-        uint32 codeOffsetIndex      = 0;
-        const auto closestData      = SearchForClosestAsmOffsetLineByLine(zone->cachedCodeOffsets, lineToReach, &codeOffsetIndex);
+        uint32 codeOffsetIndex = 0;
+        AsmOffsetLine closestData;
+        if (lineToReach < zone->instructionIndex.GetCount()) {
+            // the instruction index knows where every line starts
+            closestData              = { zone->cachedCodeOffsets[0].offset + zone->instructionIndex.offsets[lineToReach], lineToReach };
+            zone->offsetCacheMaxLine = UINT32_MAX;
+        } else {
+            closestData = SearchForClosestAsmOffsetLineByLine(zone->cachedCodeOffsets, lineToReach, &codeOffsetIndex);
+            if (static_cast<size_t>(codeOffsetIndex) + 1u < zone->cachedCodeOffsets.size())
+                zone->offsetCacheMaxLine = zone->cachedCodeOffsets[static_cast<size_t>(codeOffsetIndex) + 1u].line;
+            else
+                zone->offsetCacheMaxLine = UINT32_MAX;
+        }
         const bool samePreviousZone = closestData.line == zone->lastClosestLine;
         zone->lastClosestLine       = closestData.line;
         zone->asmAddress            = closestData.offset - zone->cachedCodeOffsets[0].offset;
         zone->asmSize               = zone->zoneDetails.size - zone->asmAddress;
-        if (static_cast<size_t>(codeOffsetIndex) + 1u < zone->cachedCodeOffsets.size())
-            zone->offsetCacheMaxLine = zone->cachedCodeOffsets[static_cast<size_t>(codeOffsetIndex) + 1u].line;
-        else
-            zone->offsetCacheMaxLine = UINT32_MAX;
 
         if (!samePreviousZone) {
             // TODO: maybe get less data ?
@@ -269,31 +283,25 @@ inline cs_insn* GetCurrentInstructionByLine(
         return nullptr;
     }
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
+    if (!capstone.IsValid()) {
         if (dli)
-            dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
+            dli->WriteErrorToScreen(cs_strerror(capstone.GetError()));
         return nullptr;
     }
 
-    cs_insn* insn = cs_malloc(handle);
-
+    size_t asmSize = static_cast<size_t>(zone->asmSize);
     while (lineDifferences > 0) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!capstone.DissasembleNext(zone->asmData, asmSize, zone->asmAddress)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
+            zone->asmSize = asmSize;
             return nullptr;
         }
         lineDifferences--;
     }
 
-    cs_close(&handle);
-    return insn;
+    zone->asmSize = asmSize;
+    return capstone.GetInstruction();
 }
 
 inline const MemoryMappingEntry* TryExtractMemoryMapping(const Pointer<SettingsData>& settings, uint64 initialLocation, const uint64 possibleLocationAdjustment)
@@ -374,18 +382,10 @@ std::optional<uint32> DissasmGetCurrentAsmLineAndPrepareCodeZone(DissasmCodeZone
     }
 
     DissasmCodeInternalType& currentType = zone->types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
-    // TODO: maybe use some caching here?
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
-        currentType.textLinesPassed = 0;
-        currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
-        }
+        const uint32 linesPassed    = levelToReach >= currentType.indexZoneStart ? levelToReach - currentType.indexZoneStart + 1 : 0;
+        currentType.textLinesPassed = currentType.annotations.CountLinesInRange(currentType.indexZoneStart, levelToReach);
+        currentType.asmLinesPassed  = linesPassed - currentType.textLinesPassed;
     } else {
         if (currentType.annotations.contains(levelToReach))
             currentType.textLinesPassed++;
@@ -439,7 +439,8 @@ bool DissasmAsmPreCacheLine::TryGetDataFromAnnotations(const DissasmCodeInternal
 bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& params)
 {
     uint32 diffLines = 0;
-    cs_insn* insn    = GetCurrentInstructionByLine(params.asmLine, params.zone, params.obj, diffLines, params.dli);
+    GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(params.zone->internalArchitecture));
+    cs_insn* insn = GetCurrentInstructionByLine(params.asmLine, params.zone, params.obj, capstone, diffLines, params.dli);
     if (!insn)
         return false;
 
@@ -452,7 +453,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str      = strdup(params.zoneName->c_str());
         op_str_size = static_cast<uint32>(params.zoneName->size());
         strncpy(mnemonic, "collapsed", std::min<uint32>(sizeof(mnemonic), 9));
-        cs_free(insn, 1);
         return true;
     }
 
@@ -475,7 +475,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
     }
@@ -559,7 +558,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
 
@@ -586,7 +584,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str_size = (uint32) strlen(op_str);
     }
     // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-    cs_free(insn, 1);
     return true;
 }
 
@@ -889,6 +886,54 @@ bool Instance::DrawDissasmX86AndX64CodeZone(DrawLineInfo& dli, DissasmCodeZone*
     return true;
 }
 
+// the lines of the instruction index are formatted in parallel, a few chunks per worker at a time, and written in order
+static bool ExportIndexedInstructions(AppCUI::OS::File& f, const uint8* data, size_t size, const DissasmCodeZone* zone, uint64 startingOffset)
+{
+    const auto& index        = zone->instructionIndex;
+    const uint32 linesCount  = index.GetCount();
+    const uint32 chunksCount = (linesCount - 1) / EXPORT_INSTRUCTIONS_CHUNK_LINES + 1;
+    const uint32 roundSize   = std::max<uint32>(GView::Utils::GetWorkersCount(), 1) * 2;
+    std::vector<std::string> texts(roundSize);
+
+    LocalString<64> progressText;
+    AppCUI::Graphics::ProgressStatus::Init("Exporting instructions", linesCount);
+    for (uint32 roundStart = 0; roundStart < chunksCount; roundStart += roundSize) {
+        const uint32 roundCount = std::min<uint32>(roundSize, chunksCount - roundStart);
+        GView::Utils::ParallelFor(roundCount, [&](uint32 chunkIndex, uint32) {
+            auto& text = texts[chunkIndex];
+            text.clear();
+
+            GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture));
+            if (!capstone.IsValid())
+                return;
+
+            const uint32 firstLine = (roundStart + chunkIndex) * EXPORT_INSTRUCTIONS_CHUNK_LINES;
+            const uint32 lastLine  = std::min<uint32>(firstLine + EXPORT_INSTRUCTIONS_CHUNK_LINES, linesCount);
+            const uint8* code      = data + index.offsets[firstLine];
+            size_t remaining       = size - index.offsets[firstLine];
+            uint64 address         = index.offsets[firstLine];
+
+            GView::Dissasembly::InstructionsBatch batch;
+            capstone.DissasembleBatch(code, remaining, address, lastLine - firstLine, batch);
+
+            LocalString<128> line;
+            text.reserve(static_cast<size_t>(batch.count) * 48);
+            for (uint32 i = 0; i < batch.count; i++) {
+                line.SetFormat("0x%" PRIx64 ":     %-10s %s\n", batch.addresses[i] + startingOffset, batch.GetMnemonic(i), batch.GetOpStr(i));
+                text.append(line.GetText(), line.Len());
+            }
+        });
+
+        for (uint32 i = 0; i < roundCount; i++)
+            f.Write(texts[i].data(), static_cast<uint32>(texts[i].size()));
+
+        const uint32 linesDone = std::min<uint32>((roundStart + roundCount) * EXPORT_INSTRUCTIONS_CHUNK_LINES, linesCount);
+        if (AppCUI::Graphics::ProgressStatus::Update(linesDone, progressText.Format("%u / %u lines", linesDone, linesCount)))
+            return false;
+    }
+    return true;
+}
+
 void Instance::CommandExportAsmFile()
 {
     int zoneIndex = 0;
@@ -912,15 +957,13 @@ void Instance::CommandExportAsmFile()
 
             f.Write("ASMZoneZone\n", sizeof("ASMZoneZone\n") - 1);
 
-            csh handle;
-            const auto resCode = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
-            if (resCode != CS_ERR_OK) {
-                f.Write(cs_strerror(resCode));
+            GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, CS_MODE_64);
+            if (!capstone.IsValid()) {
+                f.Write(cs_strerror(capstone.GetError()));
                 f.Close();
+                continue;
             }
 
-            cs_insn* insn = cs_malloc(handle);
-
             const auto dissamZone      = static_cast<DissasmCodeZone*>(zone.get());
             const uint64 staringOffset = dissamZone->cachedCodeOffsets[0].offset;
             size_t size                = dissamZone->zoneDetails.size - (staringOffset - dissamZone->zoneDetails.startingZonePoint);
@@ -936,16 +979,29 @@ void Instance::CommandExportAsmFile()
             }
             auto data = dataBuffer.GetData();
 
+            if (!dissamZone->instructionIndex.IsEmpty()) {
+                const bool exported = ExportIndexedInstructions(f, data, size, dissamZone, staringOffset);
+                f.Close();
+                if (!exported)
+                    return;
+                zoneIndex++;
+                GView::App::OpenFile(sb.ToStringView(), App::OpenMethod::BestMatch);
+                continue;
+            }
+
+            // decode a batch of instructions at a time and only then format them
+            GView::Dissasembly::InstructionsBatch batch;
             while (address < endAddress) {
-                if (!cs_disasm_iter(handle, &data, &size, &address, insn))
+                batch.Clear();
+                if (capstone.DissasembleBatch(data, size, address, EXPORT_INSTRUCTIONS_BATCH_SIZE, batch) == 0)
                     break;
 
-                string.SetFormat("0x%" PRIx64 ":     %-10s %s\n", insn->address + staringOffset, insn->mnemonic, insn->op_str);
-                f.Write(string.GetText(), string.Len());
+                for (uint32 i = 0; i < batch.count; i++) {
+                    string.SetFormat("0x%" PRIx64 ":     %-10s %s\n", batch.addresses[i] + staringOffset, batch.GetMnemonic(i), batch.GetOpStr(i));
+                    f.Write(string.GetText(), string.Len());
+                }
             }
 
-            cs_free(insn, 1);
-            cs_close(&handle);
             f.Close();
             zoneIndex++;
 
@@ -959,6 +1015,7 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
     uint32 diffLines     = 0;
     uint64 computedValue = 0;
     cs_insn* insn;
+    GView::Dissasembly::CapstoneHandle capstone(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture));
     if (!offsetToReach) {
         if (line <= 1)
             return;
@@ -976,7 +1033,7 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
         if (!adjustedLine.has_value())
             return;
 
-        insn = GetCurrentInstructionByLine(adjustedLine.value(), zone, obj, diffLines);
+        insn = GetCurrentInstructionByLine(adjustedLine.value(), zone, obj, capstone, diffLines);
         if (!insn) {
             Dialogs::MessageBox::ShowNotification("Warning", "There was an error reaching that line!");
             return;
@@ -1000,12 +1057,9 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
             } else if (insn->op_str[0] >= '0' && insn->op_str[0] <= '9' && insn->op_str[1] == '\0') {
                 computedValue = zone->cachedCodeOffsets[0].offset + (insn->op_str[0] - '0');
             } else {
-                cs_free(insn, 1);
                 return;
             }
-            cs_free(insn, 1);
         } else {
-            cs_free(insn, 1);
             return;
         }
     } else
@@ -1020,12 +1074,11 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
     // computedValue = 1064;
 
     diffLines = 0;
-    insn      = GetCurrentInstructionByOffset(computedValue, zone, obj, diffLines);
+    insn      = GetCurrentInstructionByOffset(computedValue, zone, obj, capstone, diffLines);
     if (!insn) {
         Dialogs::MessageBox::ShowNotification("Warning", "There was an error reaching that line!");
         return;
     }
-    cs_free(insn, 1);
 
     // diffLines++; // increased because of the menu bar
 
@@ -1037,13 +1090,7 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
     const auto adjustedLine = DissasmGetCurrentAsmLineAndPrepareCodeZone(zone, diffLines);
     uint32 actualLine       = zone->types.back().get().beforeTextLines + 2; //+1 for menu, +1 for title
 
-    const auto annotations = zone->types.back().get().annotations;
-    for (const auto& entry : annotations.mappings) // no std::views::keys on mac
-    {
-        if (entry.first > diffLines + 1)
-            break;
-        actualLine++;
-    }
+    actualLine += zone->types.back().get().annotations.CountLinesUntil(diffLines + 1);
 
     // if (adjustedLine.has_value())
     //     actualLine += adjustedLine.value() + 1;
@@ -0,0 +1,317 @@
+#include "GridRowOrder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 ROWS_PER_TASK          = 64 * 1024; // a multiple of 64 => the tasks of a filter do not share words of the bitmap
+constexpr uint32 SORT_BLOCK_MIN_SIZE    = 16 * 1024;
+constexpr uint32 SORT_BLOCKS_PER_WORKER = 4;
+constexpr uint32 MAX_VALUE_SIZE         = 256; // longer values are compared by their start
+constexpr uint32 EMPTY_RANK             = 0xFFFFFFFF;
+
+enum class ValueKind : uint8 { Empty, Number, Text };
+
+// the buffer of the value is valid until the next read from cache
+static std::string_view ReadValue(GView::Utils::DataCache& cache, const GView::DelimitedText::Index& index, uint64 row, uint32 column)
+{
+    uint64 start = 0;
+    uint64 end   = 0;
+    if (!index.GetField(row, column, start, end) || start == end)
+        return {}; // a row with fewer fields => an empty value
+    const auto buffer = cache.Get(start, static_cast<uint32>(std::min<uint64>(end - start, MAX_VALUE_SIZE)), false);
+    return GView::DelimitedText::TrimValue({ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() });
+}
+
+static uint8 ToLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint8>(c - 'A' + 'a') : static_cast<uint8>(c);
+}
+
+// case insensitive three way comparison
+static int CompareText(std::string_view a, std::string_view b)
+{
+    const size_t size = std::min<size_t>(a.size(), b.size());
+    for (size_t i = 0; i < size; i++) {
+        const auto ca = ToLower(a[i]);
+        const auto cb = ToLower(b[i]);
+        if (ca != cb)
+            return ca < cb ? -1 : 1;
+    }
+    return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+}
+
+static bool ContainsText(std::string_view text, std::string_view pattern)
+{
+    if (pattern.empty())
+        return true;
+    for (size_t i = 0; i + pattern.size() <= text.size(); i++) {
+        if (CompareText(text.substr(i, pattern.size()), pattern) == 0)
+            return true;
+    }
+    return false;
+}
+
+// sorted blocks are merged two by two, every round in parallel; std::merge takes the equal values from the first range => stable
+template <typename Less>
+static bool ParallelMergeSort(std::vector<uint32>& values, Less less, const std::function<bool()>& onWait)
+{
+    const auto count         = static_cast<uint32>(values.size());
+    const uint32 blocksCount = std::max<uint32>(1, std::min<uint32>(count / SORT_BLOCK_MIN_SIZE, GView::Utils::GetWorkersCount() * SORT_BLOCKS_PER_WORKER));
+    const uint32 blockSize   = (count + blocksCount - 1) / blocksCount;
+    CHECK(GView::Utils::ParallelFor(
+                blocksCount,
+                [&](uint32 block, uint32) {
+                    const uint32 start = std::min<uint32>(block * blockSize, count);
+                    const uint32 end   = std::min<uint32>(start + blockSize, count);
+                    std::stable_sort(values.begin() + start, values.begin() + end, less);
+                },
+                onWait),
+          false,
+          "");
+
+    std::vector<uint32> merged(values.size());
+    for (uint64 width = blockSize; width < count; width *= 2) {
+        const auto pairsCount = static_cast<uint32>((count + 2 * width - 1) / (2 * width));
+        CHECK(GView::Utils::ParallelFor(
+                    pairsCount,
+                    [&](uint32 pair, uint32) {
+                        const auto start  = static_cast<uint32>(std::min<uint64>(pair * 2 * width, count));
+                        const auto middle = static_cast<uint32>(std::min<uint64>(start + width, count));
+                        const auto end    = static_cast<uint32>(std::min<uint64>(start + 2 * width, count));
+                        const auto first = values.begin();
+                        std::merge(first + start, first + middle, first + middle, first + end, merged.begin() + start, less);
+                    },
+                    onWait),
+              false,
+              "");
+        values.swap(merged);
+    }
+    return true;
+}
+
+bool GridRowOrder::Reset(const GView::DelimitedText::Index& index, uint64 firstRow)
+{
+    ranks.clear();
+    permutation.clear();
+    selection.clear();
+    visibleRows.clear();
+    sortColumn = 0;
+    ascending  = true;
+
+    const uint64 rows = index.GetRowsCount();
+    this->firstRow    = std::min<uint64>(firstRow, rows);
+    CHECK(rows - this->firstRow < EMPTY_RANK, false, "");
+    rowsCount = static_cast<uint32>(rows - this->firstRow);
+
+    UpdateVisibleRows();
+    return true;
+}
+
+bool GridRowOrder::ComputeRanks(
+      GView::Utils::DataCache& cache,
+      const GView::DelimitedText::Index& index,
+      uint32 column,
+      std::atomic<uint64>& rowsProcessed,
+      const std::function<bool()>& onWait)
+{
+    // every worker reads through its own view of the cache
+    const uint32 tasksCount   = (rowsCount + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    const uint32 workersCount = std::max<uint32>(1, std::min<uint32>(GView::Utils::GetWorkersCount(), tasksCount));
+    std::vector<GView::Utils::DataCache> views(workersCount);
+    for (auto& view : views) {
+        CHECK(view.InitView(cache), false, "");
+    }
+
+    std::vector<ValueKind> kinds(rowsCount, ValueKind::Empty);
+    std::vector<double> numbers(rowsCount, 0.0);
+    std::vector<std::string> texts(rowsCount);
+    CHECK(GView::Utils::ParallelFor(
+                tasksCount,
+                [&](uint32 task, uint32 workerIndex) {
+                    const uint32 end = std::min<uint32>((task + 1) * ROWS_PER_TASK, rowsCount);
+                    for (uint32 row = task * ROWS_PER_TASK; row < end; row++) {
+                        const auto value = ReadValue(views[workerIndex], index, firstRow + row, column);
+                        if (value.empty())
+                            continue;
+                        kinds[row] = GView::DelimitedText::ParseNumber(value, numbers[row]) ? ValueKind::Number : ValueKind::Text;
+                        texts[row].assign(value);
+                    }
+                    rowsProcessed.fetch_add(end - task * ROWS_PER_TASK, std::memory_order_relaxed);
+                },
+                onWait),
+          false,
+          "");
+
+    // a single text value => the whole column is compared as text
+    const bool isNumeric = std::find(kinds.begin(), kinds.end(), ValueKind::Text) == kinds.end();
+    const auto less      = [&](uint32 a, uint32 b) {
+        if (kinds[a] == ValueKind::Empty || kinds[b] == ValueKind::Empty)
+            return kinds[a] != ValueKind::Empty && kinds[b] == ValueKind::Empty;
+        return isNumeric ? numbers[a] < numbers[b] : CompareText(texts[a], texts[b]) < 0;
+    };
+
+    std::vector<uint32> order(rowsCount);
+    std::iota(order.begin(), order.end(), 0);
+    CHECK(ParallelMergeSort(order, less, onWait), false, "");
+
+    // equal values have the same rank
+    auto& columnRanks = ranks[column];
+    columnRanks.resize(rowsCount);
+    uint32 rank = 0;
+    for (uint32 i = 0; i < rowsCount; i++) {
+        if (i > 0 && less(order[i - 1], order[i]))
+            rank++;
+        columnRanks[order[i]] = kinds[order[i]] == ValueKind::Empty ? EMPTY_RANK : rank;
+    }
+    return true;
+}
+
+bool GridRowOrder::Sort(
+      GView::Utils::DataCache& cache,
+      const GView::DelimitedText::Index& index,
+      uint32 column,
+      bool ascending,
+      const std::function<bool(uint64 rowsProcessed)>& onProgress)
+{
+    std::atomic<uint64> rowsProcessed{ 0 };
+    const auto onWait = [&]() { return onProgress == nullptr || onProgress(rowsProcessed.load(std::memory_order_relaxed)); };
+
+    if (ranks.size() <= column)
+        ranks.resize(static_cast<size_t>(column) + 1);
+    if (ranks[column].size() != rowsCount) {
+        ranks[column].clear();
+        CHECK(ComputeRanks(cache, index, column, rowsProcessed, onWait), false, "");
+    }
+
+    // counting sort on the ranks (stable), the empty values are last in both directions
+    const auto& columnRanks = ranks[column];
+    uint32 maxRank          = 0;
+    for (const auto rank : columnRanks) {
+        if (rank != EMPTY_RANK)
+            maxRank = std::max<uint32>(maxRank, rank);
+    }
+    const auto getBucket = [&](uint32 rank) -> uint64 {
+        if (rank == EMPTY_RANK)
+            return static_cast<uint64>(maxRank) + 1;
+        return ascending ? rank : maxRank - rank;
+    };
+
+    std::vector<uint32> positions(static_cast<size_t>(maxRank) + 3, 0);
+    for (const auto rank : columnRanks) {
+        positions[getBucket(rank) + 1]++;
+    }
+    for (size_t i = 1; i < positions.size(); i++) {
+        positions[i] += positions[i - 1];
+    }
+    permutation.resize(rowsCount);
+    for (uint32 row = 0; row < rowsCount; row++) {
+        permutation[positions[getBucket(columnRanks[row])]++] = row;
+    }
+
+    sortColumn      = column;
+    this->ascending = ascending;
+    UpdateVisibleRows();
+    return true;
+}
+
+bool GridRowOrder::Filter(
+      GView::Utils::DataCache& cache,
+      const GView::DelimitedText::Index& index,
+      const FilterPredicate& predicate,
+      const std::function<bool(uint64 rowsProcessed)>& onProgress)
+{
+    std::atomic<uint64> rowsProcessed{ 0 };
+    const auto onWait = [&]() { return onProgress == nullptr || onProgress(rowsProcessed.load(std::memory_order_relaxed)); };
+
+    const uint32 tasksCount   = (rowsCount + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    const uint32 workersCount = std::max<uint32>(1, std::min<uint32>(GView::Utils::GetWorkersCount(), tasksCount));
+    std::vector<GView::Utils::DataCache> views(workersCount);
+    for (auto& view : views) {
+        CHECK(view.InitView(cache), false, "");
+    }
+
+    const auto pattern    = GView::DelimitedText::TrimValue(predicate.value);
+    double patternNumber  = 0.0;
+    const bool isNumber   = GView::DelimitedText::ParseNumber(pattern, patternNumber);
+    const auto isSelected = [&](std::string_view value) {
+        if (predicate.operation == FilterOperation::Contains)
+            return ContainsText(value, pattern);
+
+        int result    = 0;
+        double number = 0.0;
+        if (isNumber && GView::DelimitedText::ParseNumber(value, number))
+            result = number < patternNumber ? -1 : (number > patternNumber ? 1 : 0);
+        else
+            result = CompareText(value, pattern);
+
+        switch (predicate.operation) {
+        case FilterOperation::Equal:
+            return result == 0;
+        case FilterOperation::NotEqual:
+            return result != 0;
+        case FilterOperation::Less:
+            return result < 0;
+        case FilterOperation::LessOrEqual:
+            return result <= 0;
+        case FilterOperation::Greater:
+            return result > 0;
+        case FilterOperation::GreaterOrEqual:
+            return result >= 0;
+        default:
+            return false;
+        }
+    };
+
+    std::vector<uint64> result((static_cast<size_t>(rowsCount) + 63) / 64, 0);
+    CHECK(GView::Utils::ParallelFor(
+                tasksCount,
+                [&](uint32 task, uint32 workerIndex) {
+                    const uint32 end = std::min<uint32>((task + 1) * ROWS_PER_TASK, rowsCount);
+                    for (uint32 row = task * ROWS_PER_TASK; row < end; row++) {
+                        if (isSelected(ReadValue(views[workerIndex], index, firstRow + row, predicate.column)))
+                            result[row / 64] |= 1ULL << (row % 64);
+                    }
+                    rowsProcessed.fetch_add(end - task * ROWS_PER_TASK, std::memory_order_relaxed);
+                },
+                onWait),
+          false,
+          "");
+
+    if (selection.empty()) {
+        selection = std::move(result);
+    } else {
+        for (size_t i = 0; i < selection.size(); i++) {
+            selection[i] &= result[i];
+        }
+    }
+    UpdateVisibleRows();
+    return true;
+}
+
+void GridRowOrder::ClearSort()
+{
+    permutation.clear();
+    UpdateVisibleRows();
+}
+
+void GridRowOrder::ClearFilters()
+{
+    selection.clear();
+    UpdateVisibleRows();
+}
+
+void GridRowOrder::UpdateVisibleRows()
+{
+    const auto isVisible = [this](uint32 row) { return selection.empty() || ((selection[row / 64] >> (row % 64)) & 1) != 0; };
+
+    visibleRows.clear();
+    visibleRows.reserve(rowsCount);
+    for (uint32 i = 0; i < rowsCount; i++) {
+        const uint32 row = permutation.empty() ? i : permutation[i];
+        if (isVisible(row))
+            visibleRows.push_back(row);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Internal.hpp"
+
+namespace GView::View::GridViewer
+{
+enum class FilterOperation : uint8 { Contains, Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual };
+
+// compares the value of a column with a constant: as numbers if both are numbers, as text otherwise (case insensitive)
+struct FilterPredicate {
+    uint32 column{ 0 };
+    FilterOperation operation{ FilterOperation::Contains };
+    std::string value;
+};
+
+// The order in which the rows of a DelimitedText::Index are displayed: a permutation of the rows (sort) and a bitmap of the rows that are
+// kept (filters), the index itself is never changed. The first sort on a column parses its values (numbers if all of them are
+// numbers, text otherwise), sorts them with a parallel merge sort and keeps the rank of every row => sorting the same column
+// again (ascending or descending) is a counting sort on the cached ranks. Empty values are always last.
+class GridRowOrder
+{
+    std::vector<std::vector<uint32>> ranks; // for every column (empty if not computed yet) the rank of every row
+    std::vector<uint32> permutation;        // the rows in sort order (empty if not sorted)
+    std::vector<uint64> selection;          // bit i is set if row i passes all the filters (empty if not filtered)
+    std::vector<uint32> visibleRows;        // the rows in display order
+    uint64 firstRow{ 0 };                   // the rows before it (a header) are not ordered
+    uint32 rowsCount{ 0 };
+    uint32 sortColumn{ 0 };
+    bool ascending{ true };
+
+    bool ComputeRanks(
+          GView::Utils::DataCache& cache,
+          const DelimitedText::Index& index,
+          uint32 column,
+          std::atomic<uint64>& rowsProcessed,
+          const std::function<bool()>& onWait);
+    void UpdateVisibleRows();
+
+  public:
+    // drops the cached ranks, the sort and the filters
+    bool Reset(const DelimitedText::Index& index, uint64 firstRow);
+    bool Sort(
+          GView::Utils::DataCache& cache,
+          const DelimitedText::Index& index,
+          uint32 column,
+          bool ascending,
+          const std::function<bool(uint64 rowsProcessed)>& onProgress = nullptr);
+    // the filters are cumulative => a row is kept only if it passes all of them
+    bool Filter(
+          GView::Utils::DataCache& cache,
+          const DelimitedText::Index& index,
+          const FilterPredicate& predicate,
+          const std::function<bool(uint64 rowsProcessed)>& onProgress = nullptr);
+    void ClearSort();
+    void ClearFilters();
+
+    bool IsSorted() const
+    {
+        return !permutation.empty();
+    }
+    bool IsFiltered() const
+    {
+        return !selection.empty();
+    }
+    uint32 GetSortColumn() const
+    {
+        return sortColumn;
+    }
+    bool IsAscending() const
+    {
+        return ascending;
+    }
+    uint32 GetVisibleRowsCount() const
+    {
+        return static_cast<uint32>(visibleRows.size());
+    }
+    // the row of the index displayed at position displayRow
+    uint64 GetRow(uint32 displayRow) const
+    {
+        return firstRow + visibleRows[displayRow];
+    }
+};
+} // namespace GView::View::GridViewer
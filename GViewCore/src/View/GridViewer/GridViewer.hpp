@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Internal.hpp"
+#include "GridRowOrder.hpp"
 #include <array>
 namespace GView
 {
@@ -17,6 +18,8 @@ namespace View
             constexpr uint32 COMMAND_ID_VIEW_CELL_CONTENT           = 0x1003;
             constexpr uint32 COMMAND_ID_EXPORT_CELL_CONTENT         = 0x1004;
             constexpr uint32 COMMAND_ID_EXPORT_COLUMN_CONTENT       = 0x1005;
+            constexpr uint32 COMMAND_ID_SORT_BY_COLUMN              = 0x1006;
+            constexpr uint32 COMMAND_ID_CLEAR_SORT_AND_FILTERS      = 0x1007;
 
             static KeyboardControl ReplaceHeader = { Key::Space, "ReplaceHeader", "Replace header with first row", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW };
 
@@ -33,20 +36,28 @@ namespace View
             static KeyboardControl ExportColumnContent = {
                 Key::Ctrl | Key::Alt | Key::S, "ExportColumnContent", "Export the content of the current column", COMMAND_ID_EXPORT_COLUMN_CONTENT
             };
+            static KeyboardControl SortByColumn = {
+                Key::S, "SortByColumn", "Sort the rows by the current column (again to reverse the order)", COMMAND_ID_SORT_BY_COLUMN
+            };
+            static KeyboardControl ClearSortAndFilters = {
+                Key::R, "ClearSortAndFilters", "Show the rows in their original order, without filters", COMMAND_ID_CLEAR_SORT_AND_FILTERS
+            };
 
-            static std::array AllGridCommands = { &ReplaceHeader, &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent, &ExportCellContent, &ExportColumnContent };
+            static std::array AllGridCommands = { &ReplaceHeader,     &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent,
+                                                  &ExportCellContent, &ExportColumnContent,   &SortByColumn,        &ClearSortAndFilters };
         }
 
 
         struct SettingsData
         {
             String name;
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
-            char separator[2]{ "," };
+            GView::DelimitedText::Index index;
+            char separator[2]{ "," };          // used by the grid when copying cells
+            std::string fieldSeparator{ "," }; // used by the index, it can have more than one character
             uint64 rows           = 0;
             uint64 cols           = 0;
             bool firstRowAsHeader = false;
+            bool isIndexBuilt     = false; // given by the type plugin (e.g. built together with its statistics) => not built again
             SettingsData();
         };
 
@@ -124,6 +135,8 @@ namespace View
             Reference<GView::Object> obj;
             Reference<AppCUI::Controls::Grid> grid;
             Pointer<SettingsData> settings;
+            GridRowOrder rowOrder;        // sort and filters, applied over settings->index
+            std::vector<uint32> gridRows; // the row of the index shown by every row of the grid
 
             static Config config;
             FindDialog findDialog;
@@ -163,6 +176,10 @@ namespace View
           private:
             void PopulateGrid();
             void ProcessContent();
+            void ResetRowOrder();
+            uint32 GetCurrentColumn();
+            void SortByCurrentColumn();
+            void FilterCurrentColumn(std::u16string_view filter);
             void PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
@@ -10,6 +10,8 @@ constexpr uint32 PROP_ID_REPLACE_HEADER_WITH_1ST_ROW = 0;
 constexpr uint32 PROP_ID_TOGGLE_HORIZONTAL_LINES     = 1;
 constexpr uint32 PROP_ID_TOGGLE_VERTICAL_LINES       = 2;
 
+constexpr uint32 ROW_NOT_SHOWN = 0xFFFFFFFF;
+
 Config Instance::config;
 
 Instance::Instance(Reference<GView::Object> obj, Settings* _settings)
@@ -31,7 +33,7 @@ Instance::Instance(Reference<GView::Object> obj, Settings* _settings)
               "d:c,w:100%,h:100%",
               static_cast<uint32>(settings->cols),
               static_cast<uint32>(settings->rows),
-              AppCUI::Controls::GridFlags::Sort | AppCUI::Controls::GridFlags::Filter | GridFlags::DisableDuplicates);
+              GridFlags::DisableDuplicates); // sort and filters are applied by rowOrder
 
         grid->SetSeparator(settings->separator);
     }
@@ -76,10 +78,7 @@ bool Instance::ShowFindDialog()
 {
     CHECK(findDialog.Show() == Dialogs::Result::Ok, true, "");
 
-    auto filterValue = findDialog.GetFilterValue();
-    grid->SetFilterOnCurrentColumn(filterValue);
-    grid->Filter();
-
+    FilterCurrentColumn(findDialog.GetFilterValue());
     return true;
 }
 
@@ -142,6 +141,7 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
     if (eventType == Event::Command) {
         if (ID == COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW) {
             settings->firstRowAsHeader = !settings->firstRowAsHeader;
+            ResetRowOrder();
             PopulateGrid();
             return true;
         } else if (ID == COMMAND_ID_TOGGLE_HORIZONTAL_LINES) {
@@ -150,6 +150,14 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
         } else if (ID == COMMAND_ID_TOGGLE_VERTICAL_LINES) {
             grid->ToggleVerticalLines();
             return true;
+        } else if (ID == COMMAND_ID_SORT_BY_COLUMN) {
+            SortByCurrentColumn();
+            return true;
+        } else if (ID == COMMAND_ID_CLEAR_SORT_AND_FILTERS) {
+            rowOrder.ClearSort();
+            rowOrder.ClearFilters();
+            PopulateGrid();
+            return true;
         } else if (ID == COMMAND_ID_VIEW_CELL_CONTENT) {
             auto content = grid->GetSelectedCellContent();
             if (content.has_value()) {
@@ -212,128 +220,149 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 void Instance::OnStart()
 {
     ProcessContent();
+    ResetRowOrder();
     grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows) });
     PopulateGrid();
 }
 
 void Instance::PopulateGrid()
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
+    const auto& index = settings->index;
+    uint64 start      = 0;
+    uint64 end        = 0;
 
-    if (settings->firstRowAsHeader) {
-        const auto& header = it->second;
+    if (settings->firstRowAsHeader && index.GetRowsCount() > 0) {
         std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header) {
+        for (uint32 j = 0; j < index.GetFieldsCount(0); j++) {
+            index.GetField(0, j, start, end);
             const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
             headerCS.push_back(token);
         }
-        std::advance(it, 1);
         grid->UpdateHeaderValues(headerCS);
     } else {
         grid->SetDefaultHeaderValues();
     }
 
-    const auto dimensions = grid->GetGridDimensions();
-    if (static_cast<uint32>(settings->rows - settings->firstRowAsHeader) != dimensions.Height) {
-        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
+    // the rows are displayed in the order (and with the filters) of rowOrder
+    const uint32 rowsCount = rowOrder.GetVisibleRowsCount();
+    const auto dimensions  = grid->GetGridDimensions();
+    if (rowsCount != dimensions.Height) {
+        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), rowsCount });
+        gridRows.clear(); // the cells kept by the grid are not known anymore
+    }
+    gridRows.resize(rowsCount, ROW_NOT_SHOWN);
+
+    // the grid keeps the value of every cell (it can not ask for the rows of the viewport when it paints them) => only the rows of
+    // the grid that show another row of the index are updated, and they are read in file order => the cache only moves forward
+    std::vector<uint32> gridRowOf(index.GetRowsCount(), ROW_NOT_SHOWN);
+    for (uint32 i = 0; i < rowsCount; i++) {
+        const auto row = static_cast<uint32>(rowOrder.GetRow(i));
+        if (gridRows[i] != row) {
+            gridRows[i]    = row;
+            gridRowOf[row] = i;
+        }
     }
 
-    while (it != content.end()) {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++) {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
+    const ConstString empty{ "" };
+    for (uint32 row = 0; row < gridRowOf.size(); row++) {
+        const auto i = gridRowOf[row];
+        if (i == ROW_NOT_SHOWN) {
+            continue;
+        }
+        const auto fieldsCount = index.GetFieldsCount(row);
+        for (uint32 j = 0; j < settings->cols; j++) {
+            if (j >= fieldsCount) {
+                grid->UpdateCell(j, i, empty); // the cell can have the value of another row
+                continue;
+            }
+            index.GetField(row, j, start, end);
+            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
             const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
+            grid->UpdateCell(j, i, value);
         }
-        std::advance(it, 1);
     }
-
-    grid->Sort();
 }
 
-void GView::View::GridViewer::Instance::ProcessContent()
+void Instance::ResetRowOrder()
 {
-    // TODO: this function should be a state machine with using cache as a stream-like structure!
-    // the implementation below is wrong if a "row" contains more bytes than the cache size!
-
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
-
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = static_cast<uint64>(obj->GetData().GetCacheSize());
-
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do {
-        const auto dataSize = oSizeProcessed >= oSize ? 0 : std::min<uint64>(oSize - oSizeProcessed, cSize);
-        const auto buf      = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(dataSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos) {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r') {
-                oSizeProcessed += nPos + 2;
-            } else {
-                oSizeProcessed += nPos + 1;
-            }
-        } else if (nPos > rPos) {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n') {
-                oSizeProcessed += rPos + 2;
-            } else {
-                oSizeProcessed += rPos + 1;
-            }
-        } else if (nPos == rPos && nPos == std::string::npos) {
-            nPos = data.size();
-            oSizeProcessed += nPos + 1;
-        }
+    const uint64 firstRow = settings->firstRowAsHeader && settings->index.GetRowsCount() > 0 ? 1 : 0;
+    if (!rowOrder.Reset(settings->index, firstRow)) {
+        settings->index.Clear();
+        rowOrder.Reset(settings->index, 0);
+    }
+}
 
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
+uint32 Instance::GetCurrentColumn()
+{
+    const auto start = grid->GetSelectionLocationsStart();
+    return start.X > 0 ? static_cast<uint32>(start.X) : 0;
+}
 
-        std::vector<uint64> separators;
-        {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos) {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
-        }
+void Instance::SortByCurrentColumn()
+{
+    // the same column again => the order is reversed (the keys of the column are already cached)
+    const uint32 column    = GetCurrentColumn();
+    const bool ascending   = !(rowOrder.IsSorted() && rowOrder.GetSortColumn() == column && rowOrder.IsAscending());
+    const uint64 rowsCount = settings->index.GetRowsCount();
+
+    LocalString<128> ls;
+    ProgressStatus::Init("Sorting rows...", rowsCount);
+    const auto onProgress = [&](uint64 processed) { return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] rows", processed, rowsCount)); };
+    if (!rowOrder.Sort(obj->GetData(), settings->index, column, ascending, onProgress)) {
+        return;
+    }
+    PopulateGrid();
+}
 
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.empty()) {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
+void Instance::FilterCurrentColumn(std::u16string_view filter)
+{
+    // "=value", "!=value", "<value", "<=value", ">value", ">=value" or just "value" (the cells that contain it)
+    static const std::pair<std::u16string_view, FilterOperation> operations[] = {
+        { u"!=", FilterOperation::NotEqual }, { u"<=", FilterOperation::LessOrEqual }, { u">=", FilterOperation::GreaterOrEqual },
+        { u"=", FilterOperation::Equal },     { u"<", FilterOperation::Less },         { u">", FilterOperation::Greater },
+    };
+
+    FilterPredicate predicate;
+    predicate.column = GetCurrentColumn();
+    for (const auto& [prefix, operation] : operations) {
+        if (filter.starts_with(prefix)) {
+            predicate.operation = operation;
+            filter.remove_prefix(prefix.size());
+            break;
         }
+    }
+    UnicodeStringBuilder usb;
+    CHECKRET(usb.Set(filter), "");
+    usb.ToString(predicate.value);
+
+    const uint64 rowsCount = settings->index.GetRowsCount();
+    LocalString<128> ls;
+    ProgressStatus::Init("Filtering rows...", rowsCount);
+    const auto onProgress = [&](uint64 processed) { return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] rows", processed, rowsCount)); };
+    if (!rowOrder.Filter(obj->GetData(), settings->index, predicate, onProgress)) {
+        return;
+    }
+    PopulateGrid();
+}
 
-        {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators) {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
-            }
-            lTokens.push_back({ tEnd + 1, oSizeProcessed });
+void GView::View::GridViewer::Instance::ProcessContent()
+{
+    // the content is read as a stream => a row can be bigger than the cache
+    auto& data       = obj->GetData();
+    const auto oSize  = data.GetSize();
+
+    if (!settings->isIndexBuilt) {
+        LocalString<128> ls;
+        ProgressStatus::Init("Indexing rows...", oSize);
+        const auto onProgress = [&](uint64 processed) { return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] bytes", processed, oSize)); };
+        if (!settings->index.Build(data, settings->fieldSeparator, onProgress)) {
+            settings->index.Clear();
         }
+        settings->isIndexBuilt = true;
+    }
 
-        tokens.insert({ currentLine, std::move(lTokens) });
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
-
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+    settings->rows = settings->index.GetRowsCount();
+    settings->cols = settings->index.GetFieldsCount(0);
 }
 
 void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
@@ -2,7 +2,7 @@
 
 using namespace GView::View::GridViewer;
 
-SettingsData::SettingsData() : tokens({}), lines({})
+SettingsData::SettingsData()
 {
 }
 
@@ -15,6 +15,27 @@ void Settings::SetSeparator(char separator[2])
 {
     ((SettingsData*) (this->data))->separator[0] = separator[0];
     ((SettingsData*) (this->data))->separator[1] = separator[1];
+    ((SettingsData*) (this->data))->fieldSeparator.assign(1, separator[0]);
+}
+
+void Settings::SetSeparator(std::string_view separator)
+{
+    if (separator.empty())
+        return;
+    ((SettingsData*) (this->data))->separator[0] = separator[0];
+    ((SettingsData*) (this->data))->separator[1] = 0;
+    ((SettingsData*) (this->data))->fieldSeparator.assign(separator);
+}
+
+void Settings::SetIndex(GView::DelimitedText::Index&& index)
+{
+    auto data          = (SettingsData*) (this->data);
+    const auto sep     = index.GetSeparator();
+    data->separator[0] = sep.empty() ? ',' : sep[0];
+    data->separator[1] = 0;
+    data->fieldSeparator.assign(sep);
+    data->index        = std::move(index);
+    data->isIndexBuilt = true;
 }
 
 bool Settings::SetName(std::string_view name)
@@ -90,6 +90,7 @@ namespace View
             }
             GView::Utils::UnicodeString Release()
             {
+                EndAllBatches();
                 GView::Utils::UnicodeString result(this->text, this->size, this->allocated);
                 this->text      = nullptr;
                 this->size      = 0;
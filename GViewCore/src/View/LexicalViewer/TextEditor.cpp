@@ -34,14 +34,21 @@ const uint8 string_lowercase_table[256] = {
     {                                                                                                                                      \
         memcpy(this->text + offset, (source), (len) * sizeof(char16));                                                                     \
     }
+
+#define FLATTEN_BATCH()                                                                                                                    \
+    if ((this->batchLevel > 0) && (this->Flatten() == false))                                                                              \
+        return false;
 // max 1G char15 chars = 2G memory
 constexpr uint32 MAX_MEMORY_TO_ALLOCATE = 0x40000000;
 char16 indexOperatorTempChar            = 0;
 TextEditor::TextEditor()
 {
-    this->text      = nullptr;
-    this->size      = 0;
-    this->allocated = 0;
+    this->text        = nullptr;
+    this->size        = 0;
+    this->allocated   = 0;
+    this->batchLevel  = 0;
+    this->cursorPiece = 0;
+    this->cursorStart = 0;
 }
 bool TextEditor::Grow(size_t newSize)
 {
@@ -69,6 +76,7 @@ bool TextEditor::Grow(size_t newSize)
 }
 char16& TextEditor::operator[](uint32 index)
 {
+    Flatten();
     if (index < size)
         return text[index];
     else
@@ -84,6 +92,8 @@ std::optional<uint32> TextEditor::Find(uint32 startOffset, std::string_view text
         return std::nullopt;
     if ((startOffset + textToSearch.size()) > this->size)
         return std::nullopt;
+    if (Flatten() == false)
+        return std::nullopt;
 
     const auto* p      = this->text + startOffset;
     const auto* e      = this->text + size + 1 - textToSearch.size();
@@ -138,6 +148,8 @@ bool TextEditor::Insert(uint32 offset, std::string_view newText)
         return true;
     if (offset > size)
         return false;
+    if (batchLevel > 0)
+        return InsertPiece(offset, std::u16string(newText.begin(), newText.end()));
     if (offset == size)
         return Add(newText);
     GROW_TO(size + newText.size());
@@ -152,6 +164,8 @@ bool TextEditor::Insert(uint32 offset, std::u16string_view newText)
         return true;
     if (offset > size)
         return false;
+    if (batchLevel > 0)
+        return InsertPiece(offset, newText);
     if (offset == size)
         return Add(newText);
     GROW_TO(size + newText.size());
@@ -162,6 +176,8 @@ bool TextEditor::Insert(uint32 offset, std::u16string_view newText)
 }
 bool TextEditor::InsertChar(uint32 offset, char16 ch)
 {
+    if (batchLevel > 0)
+        return (offset <= size) && InsertPiece(offset, std::u16string_view(&ch, 1));
     GROW_TO(size + 1);
     if (offset > size)
         return false;
@@ -177,6 +193,11 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
 {
     if (offset > size)
         return false;
+    if (batchLevel > 0)
+    {
+        ErasePieces(offset, std::min<uint32>(count, size - offset));
+        return InsertPiece(offset, std::u16string(newText.begin(), newText.end()));
+    }
     if (offset + count >= size)
     {
         this->size = offset;
@@ -200,6 +221,11 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newTex
 {
     if (offset > size)
         return false;
+    if (batchLevel > 0)
+    {
+        ErasePieces(offset, std::min<uint32>(count, size - offset));
+        return InsertPiece(offset, newText);
+    }
     if (offset + count >= size)
     {
         this->size = offset;
@@ -242,6 +268,11 @@ bool TextEditor::DeleteChar(uint32 offset)
 {
     if (offset >= size)
         return false;
+    if (batchLevel > 0)
+    {
+        ErasePieces(offset, 1);
+        return true;
+    }
     if (offset + 1 < size)
     {
         memmove(this->text + offset, this->text + offset + 1, (this->size - (offset + 1)) * sizeof(char16));
@@ -253,6 +284,11 @@ bool TextEditor::Delete(uint32 offset, uint32 charactersCount)
 {
     if (offset > size)
         return false;
+    if (batchLevel > 0)
+    {
+        ErasePieces(offset, std::min<uint32>(charactersCount, size - offset));
+        return true;
+    }
     if ((offset + charactersCount) >= size)
     {
         // last characters to delete
@@ -265,6 +301,8 @@ bool TextEditor::Delete(uint32 offset, uint32 charactersCount)
 }
 bool TextEditor::Add(std::string_view newText)
 {
+    if (batchLevel > 0)
+        return InsertPiece(size, std::u16string(newText.begin(), newText.end()));
     GROW_TO(newText.size() + size);
     COPY_ASCII(size, newText.data(), newText.size());
     size += static_cast<uint32>(newText.size());
@@ -272,6 +310,8 @@ bool TextEditor::Add(std::string_view newText)
 }
 bool TextEditor::Add(std::u16string_view newText)
 {
+    if (batchLevel > 0)
+        return InsertPiece(size, newText);
     GROW_TO(newText.size() + size);
     COPY_UNICODE16(size, newText.data(), newText.size());
     size += static_cast<uint32>(newText.size());
@@ -279,22 +319,37 @@ bool TextEditor::Add(std::u16string_view newText)
 }
 bool TextEditor::Set(std::string_view newText)
 {
+    FLATTEN_BATCH();
     GROW_TO(newText.size());
     COPY_ASCII(0, newText.data(), newText.size());
     this->size = static_cast<uint32>(newText.size());
+    if (batchLevel > 0)
+        ResetPieces();
     return true;
 }
 bool TextEditor::Set(std::u16string_view newText)
 {
+    FLATTEN_BATCH();
     GROW_TO(newText.size());
     COPY_UNICODE16(0, newText.data(), newText.size());
     this->size = static_cast<uint32>(newText.size());
+    if (batchLevel > 0)
+        ResetPieces();
     return true;
 }
 bool TextEditor::Resize(uint32 newSize, char16 fillChar)
 {
     if (newSize == size)
         return true;
+    if (batchLevel > 0)
+    {
+        if (newSize < size)
+        {
+            ErasePieces(newSize, size - newSize);
+            return true;
+        }
+        return InsertPiece(size, std::u16string(newSize - size, fillChar));
+    }
     if (newSize < size)
     {
         size = newSize;
@@ -311,12 +366,207 @@ bool TextEditor::Resize(uint32 newSize, char16 fillChar)
 void TextEditor::Clear()
 {
     this->size = 0;
+    if (batchLevel > 0)
+        ResetPieces();
 }
 bool TextEditor::Reserve(uint32 newSize)
 {
+    FLATTEN_BATCH();
     GROW_TO(newSize);
     return true;
 }
+bool TextEditor::GetText(uint32 offset, uint32 charactersCount, std::u16string& result)
+{
+    result.clear();
+    if ((size_t) offset + (size_t) charactersCount > size)
+        return false;
+    if (charactersCount == 0)
+        return true;
+    if (batchLevel == 0)
+    {
+        result.assign(this->text + offset, charactersCount);
+        return true;
+    }
+
+    result.reserve(charactersCount);
+    auto index = FindPiece(offset);
+    auto skip  = offset - cursorStart;
+    while (charactersCount > 0)
+    {
+        const auto& piece = pieces[index];
+        const auto len    = std::min<uint32>(piece.length - skip, charactersCount);
+        const auto* src   = (piece.added ? added.data() : this->text) + piece.start + skip;
+        result.append(src, len);
+        charactersCount -= len;
+        skip = 0;
+        index++;
+    }
+    return true;
+}
+
+// ================= Piece table (batched edits)
+void TextEditor::BeginBatch()
+{
+    if (batchLevel == 0)
+        ResetPieces();
+    batchLevel++;
+}
+bool TextEditor::CommitBatch()
+{
+    if (batchLevel == 0)
+        return false;
+    if (batchLevel > 1)
+    {
+        batchLevel--;
+        return true;
+    }
+    if (Flatten() == false)
+        return false; // the batch stays open (the pieces are still valid)
+    batchLevel = 0;
+    pieces.clear();
+    added = std::u16string();
+    return true;
+}
+void TextEditor::EndAllBatches()
+{
+    if (batchLevel == 0)
+        return;
+    batchLevel = 1;
+    if (CommitBatch() == false)
+    {
+        // out of memory - the pending edits are lost, but the flat buffer must not be exposed with a larger size
+        batchLevel = 0;
+        pieces.clear();
+        added = std::u16string();
+        size  = std::min<uint32>(size, allocated);
+    }
+}
+void TextEditor::ResetPieces()
+{
+    pieces.clear();
+    added.clear();
+    if (size > 0)
+        pieces.push_back({ 0, size, false });
+    cursorPiece = 0;
+    cursorStart = 0;
+}
+uint32 TextEditor::FindPiece(uint32 offset)
+{
+    // offset must be smaller than size; the search starts from the last located piece
+    if (offset < cursorStart / 2)
+    {
+        cursorPiece = 0;
+        cursorStart = 0;
+    }
+    while (offset < cursorStart)
+    {
+        cursorPiece--;
+        cursorStart -= pieces[cursorPiece].length;
+    }
+    while (offset >= cursorStart + pieces[cursorPiece].length)
+    {
+        cursorStart += pieces[cursorPiece].length;
+        cursorPiece++;
+    }
+    return cursorPiece;
+}
+uint32 TextEditor::SplitPieceAt(uint32 offset)
+{
+    // returns the index of the piece that starts at offset (pieces.size() if offset is the end of the text)
+    if (offset >= size)
+        return static_cast<uint32>(pieces.size());
+    const auto index = FindPiece(offset);
+    if (offset == cursorStart)
+        return index;
+
+    auto& piece      = pieces[index];
+    const auto delta = offset - cursorStart;
+    const Piece tail = { piece.start + delta, piece.length - delta, piece.added };
+    piece.length     = delta;
+    pieces.insert(pieces.begin() + index + 1, tail);
+    return index + 1;
+}
+bool TextEditor::InsertPiece(uint32 offset, std::u16string_view newText)
+{
+    if (newText.empty())
+        return true;
+    if ((size_t) size + newText.size() > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+
+    const auto len   = static_cast<uint32>(newText.size());
+    const auto index = SplitPieceAt(offset);
+    const auto start = static_cast<uint32>(added.size());
+    try
+    {
+        added.append(newText);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // consecutive insertions (e.g. a delete + insert of a generated text) extend the previous added piece
+    auto next = index;
+    if ((index > 0) && (pieces[index - 1].added) && (pieces[index - 1].start + pieces[index - 1].length == start))
+    {
+        pieces[index - 1].length += len;
+    }
+    else
+    {
+        pieces.insert(pieces.begin() + index, { start, len, true });
+        next++;
+    }
+    size += len;
+    // the cursor moves to the piece that follows the inserted text
+    cursorPiece = next;
+    cursorStart = offset + len;
+    return true;
+}
+void TextEditor::ErasePieces(uint32 offset, uint32 count)
+{
+    if (count == 0)
+        return;
+    const auto first = SplitPieceAt(offset);
+    const auto last  = SplitPieceAt(offset + count);
+    pieces.erase(pieces.begin() + first, pieces.begin() + last);
+    size -= count;
+    cursorPiece = first;
+    cursorStart = offset;
+}
+bool TextEditor::Flatten()
+{
+    if (batchLevel == 0)
+        return true;
+    if ((pieces.size() == 1) && (pieces[0].added == false) && (pieces[0].start == 0))
+        return true; // nothing was changed (or the text was already flattened)
+    if (pieces.empty())
+    {
+        ResetPieces();
+        return true;
+    }
+
+    const auto newAllocated = static_cast<uint32>((size | 0xFF) + 1);
+    char16* temp            = nullptr;
+    try
+    {
+        temp = new char16[newAllocated];
+    }
+    catch (...)
+    {
+        return false;
+    }
+    auto* p = temp;
+    for (const auto& piece : pieces)
+    {
+        memcpy(p, (piece.added ? added.data() : this->text) + piece.start, piece.length * sizeof(char16));
+        p += piece.length;
+    }
+    delete[] this->text;
+    this->text      = temp;
+    this->allocated = newAllocated;
+    ResetPieces();
+    return true;
+}
 
 // ================= Builder specific
 bool TextEditorBuilder::Set(const CharacterBuffer& chars)
@@ -327,6 +577,7 @@ bool TextEditorBuilder::Set(const CharacterBuffer& chars)
         return true;
     }
 
+    FLATTEN_BATCH();
     GROW_TO(chars.Len());
     auto* p  = this->text;
     auto* e  = this->text + chars.Len();
@@ -338,6 +589,8 @@ bool TextEditorBuilder::Set(const CharacterBuffer& chars)
         ch++;
     }
     this->size = chars.Len();
+    if (batchLevel > 0)
+        ResetPieces();
     return true;
 }
 
@@ -5,6 +5,7 @@
 #include <set>
 #include <span>
 #include <array>
+#include <capstone/capstone.h>
 
 using namespace AppCUI::Controls;
 using namespace AppCUI::Graphics;
@@ -281,6 +282,74 @@ namespace Utils
     };
 } // namespace Utils
 
+namespace Dissasembly
+{
+    // Instructions decoded by CapstoneHandle::DissasembleBatch, kept as a structure of arrays owned by the caller.
+    // The arrays only grow, so a batch that is reused does not allocate anything once it reached its largest size.
+    struct InstructionsBatch {
+        uint32 count{ 0 };
+        std::vector<uint64> addresses;
+        std::vector<uint16> sizes;
+        std::vector<uint32> ids;
+        std::vector<char> mnemonics; // MNEMONIC_SIZE characters per instruction (NULL terminated)
+        std::vector<char> opStrs;    // OP_STR_SIZE characters per instruction (NULL terminated)
+
+        void Clear()
+        {
+            count = 0;
+        }
+        void Reserve(uint32 instructionsCount);
+        const char* GetMnemonic(uint32 index) const
+        {
+            return mnemonics.data() + static_cast<size_t>(index) * MNEMONIC_SIZE;
+        }
+        const char* GetOpStr(uint32 index) const
+        {
+            return opStrs.data() + static_cast<size_t>(index) * OP_STR_SIZE;
+        }
+    };
+
+    // A Capstone handle (and its cs_insn) borrowed from a process wide pool, for a given (arch, mode, detail) configuration.
+    // A handle is opened and configured only when no idle handle with the same configuration exists; it goes back to the
+    // pool when this object is destroyed. Each object is meant to be used by a single thread at a time.
+    class CapstoneHandle
+    {
+        csh handle{ 0 };
+        cs_insn* insn{ nullptr };
+        uint64 key{ 0 };
+        cs_err error{ CS_ERR_OK };
+
+      public:
+        CapstoneHandle(cs_arch arch, cs_mode mode, bool detail = false);
+        ~CapstoneHandle();
+
+        CapstoneHandle(const CapstoneHandle&)            = delete;
+        CapstoneHandle& operator=(const CapstoneHandle&) = delete;
+
+        inline bool IsValid() const
+        {
+            return insn != nullptr;
+        }
+        inline cs_err GetError() const
+        {
+            return error;
+        }
+        inline csh GetHandle() const
+        {
+            return handle;
+        }
+        // the instruction filled by DissasembleNext - owned by the handle, overwritten by the next decode
+        inline cs_insn* GetInstruction() const
+        {
+            return insn;
+        }
+
+        bool DissasembleNext(const uint8*& code, size_t& size, uint64& address);
+        // decodes up to maxCount instructions and appends them to batch; returns the number of decoded instructions
+        uint32 DissasembleBatch(const uint8*& code, size_t& size, uint64& address, uint32 maxCount, InstructionsBatch& batch);
+    };
+} // namespace Dissasembly
+
 namespace Generic
 {
     constexpr uint32 MAX_PLUGINS_COMMANDS = 8;
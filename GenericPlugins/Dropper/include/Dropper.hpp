@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <filesystem>
 #include <set>
+#include <atomic>
 
 #include "SpecialStrings.hpp"
 #include "Executables.hpp"
@@ -15,6 +16,7 @@
 #include "Images.hpp"
 #include "Archives.hpp"
 #include "Cryptographic.hpp"
+#include "SignatureScanner.hpp"
 
 using namespace GView::Utils;
 using namespace GView::GenericPlugins::Droppper::SpecialStrings;
@@ -37,6 +39,32 @@ struct PluginClassification {
     Subcategory subcategory{};
 };
 
+// the scanned range is split in shards of this size, scanned in parallel
+constexpr uint64 SHARD_SIZE = 0x400000;
+
+struct ShardResult {
+    uint64 start{ 0 };
+    uint64 end{ 0 };
+    uint64 exitOffset{ 0 };                           // where the scan stopped (past end when the last finding was skipped)
+    bool completed{ false };                          // false if the scan was canceled
+    std::vector<std::pair<uint64, Finding>> findings; // scan offset -> finding
+    std::vector<std::pair<uint64, uint64>> skips;     // scan offset -> next scan offset (non recursive scans)
+};
+
+// shared by all the shards of a scan (the droppers and the automaton are only read)
+struct ScanContext {
+    std::vector<std::unique_ptr<IDrop>*> droppers;
+    std::vector<std::vector<std::string_view>> signatures;
+    bool hasUnanchoredPlugins{ false };
+    SignatureScanner scanner;
+    bool recursive{ false };
+    ArtefactIdentificationCallback identify{ nullptr };
+
+    std::atomic<uint64> scannedBytes{ 0 };
+    std::atomic<uint32> objectsCount{ 0 };
+    std::atomic<bool> stop{ false };
+};
+
 class Instance
 {
   private:
@@ -76,6 +104,7 @@ class Instance
   private:
     bool ProcessBinaryDataCharset(std::string_view include, std::string_view exclude);
     bool FillCharSetMatrix(bool binaryCharSetMatrix[BINARY_CHARSET_MATRIX_SIZE], std::string_view s, bool value);
+    void ScanShard(DataCache& cache, ScanContext& sc, ShardResult& shard);
 
   public:
     Instance() = default;
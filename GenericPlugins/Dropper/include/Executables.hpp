@@ -18,5 +18,6 @@ class MZPE : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual std::vector<std::string_view> GetSignatures() const override;
 };
 } // namespace GView::GenericPlugins::Droppper::Executables
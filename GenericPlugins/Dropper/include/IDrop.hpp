@@ -20,6 +20,13 @@ class IDrop
     // prechachedBufferSize -> max 8
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) = 0;
 
+    // magic prefixes -> Check is called only on the offsets where one of them matches
+    // no prefixes -> Check is called on every offset
+    virtual std::vector<std::string_view> GetSignatures() const
+    {
+        return {};
+    }
+
     // helpers
     inline bool IsMagicU16(BufferView precachedBuffer, uint16 magic) const
     {
@@ -45,6 +52,12 @@ class IDrop
         return false;
     }
 
+    template <typename T>
+    inline static std::string_view MagicToSignature(const T& magic)
+    {
+        return { reinterpret_cast<const char*>(&magic), sizeof(T) };
+    }
+
     inline static bool IsAsciiPrintable(char c)
     {
         return 0x20 <= c && c <= 0x7e;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "IDrop.hpp"
+
+#include <array>
+
+using namespace GView::Utils;
+
+namespace GView::GenericPlugins::Droppper
+{
+/*
+ * Aho-Corasick automaton built over the magic prefixes declared by the droppers (IDrop::GetSignatures).
+ * The whole range is scanned once and only the offsets where at least one prefix matches are reported back
+ * together with a mask of droppers (bit index == dropper index given to Build) whose prefix matched there.
+ */
+class SignatureScanner
+{
+  public:
+    static constexpr uint32 MAX_DROPPERS = 64;
+
+  private:
+    static constexpr uint32 ALPHABET_SIZE = 256;
+    static constexpr uint32 ROOT          = 0;
+
+    struct Pattern {
+        uint32 length;
+        uint64 mask;
+    };
+
+    struct Candidate {
+        uint64 offset;
+        uint64 mask;
+    };
+
+    std::vector<std::array<uint32, ALPHABET_SIZE>> transitions;
+    std::vector<std::vector<Pattern>> outputs; // per node, including the outputs reachable through the fail links
+    uint32 maxLength{ 0 };
+
+    uint32 state{ ROOT };
+    uint64 scanOffset{ 0 }; // next byte fed to the automaton
+    uint64 limit{ 0 };      // candidates must start before this offset
+    std::vector<Candidate> candidates;
+    std::vector<Candidate> carried; // candidates that may still receive prefixes from the next chunk
+    size_t candidateIndex{ 0 };
+
+    bool Feed(DataCache& cache);
+    void Flush(uint64 finalizeUpTo);
+
+  public:
+    SignatureScanner() = default;
+
+    // signatures[i] -> prefixes of dropper i; droppers without prefixes are simply not part of the automaton
+    bool Build(const std::vector<std::vector<std::string_view>>& signatures);
+    bool IsEmpty() const;
+    uint32 GetMaxSignatureLength() const;
+
+    // (re)starts the scan at offset; candidates will be reported for [offset, end)
+    void Reset(uint64 offset, uint64 end);
+    // reports the next candidate offset (in increasing order) and the droppers that should be checked there
+    bool Next(DataCache& cache, uint64& offset, uint64& mask);
+};
+} // namespace GView::GenericPlugins::Droppper
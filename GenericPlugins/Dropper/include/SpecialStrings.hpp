@@ -98,12 +98,10 @@ class URL : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual std::vector<std::string_view> GetSignatures() const override;
 };
 class Wallet : public SpecialStrings
 {
-  public:
-    WalletType checkResult{};
-
   public:
     Wallet(bool caseSensitive, bool unicode);
 
@@ -112,8 +110,7 @@ class Wallet : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
-
-    WalletType GetLastCheckResult() const;
+    virtual std::vector<std::string_view> GetSignatures() const override;
 };
 class Registry : public SpecialStrings
 {
@@ -125,6 +122,7 @@ class Registry : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual std::vector<std::string_view> GetSignatures() const override;
 };
 
 // text class has a separate purpose
@@ -5,6 +5,7 @@
 #include <array>
 #include <regex>
 #include <charconv>
+#include <algorithm>
 
 using namespace AppCUI;
 using namespace AppCUI::Utils;
@@ -270,49 +271,154 @@ bool Instance::DropObjects(
 bool Instance::ProcessObjects(
       const std::vector<PluginClassification>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify)
 {
-    DataCache& cache  = object->GetData();
-    uint64 nextOffset = offset;
+    DataCache& cache = object->GetData();
 
-    std::vector<std::unique_ptr<IDrop>*> whitelistedPlugins;
-    whitelistedPlugins.reserve(context.objectDroppers.size());
+    ScanContext sc{ .recursive = recursive, .identify = identify };
+    sc.droppers.reserve(context.objectDroppers.size());
     if (plugins.size() == 1 && context.textDropper->GetCategory() == plugins[0].category && context.textDropper->GetSubcategory() == plugins[0].subcategory) {
-        whitelistedPlugins.push_back(&context.textDropper);
+        sc.droppers.push_back(&context.textDropper);
     } else {
         for (auto& d : context.objectDroppers) {
             for (const auto& p : plugins) {
                 if (d->GetCategory() == p.category && d->GetSubcategory() == p.subcategory) {
-                    whitelistedPlugins.push_back(&d);
+                    sc.droppers.push_back(&d);
                     break;
                 }
             }
         }
     }
     if (identify != nullptr && plugins.size() > 1) {
-        whitelistedPlugins.push_back(&context.textDropper);
+        sc.droppers.push_back(&context.textDropper);
+    }
+
+    // droppers declaring magic prefixes are checked only on the offsets reported by the automaton
+    sc.signatures.reserve(sc.droppers.size());
+    for (auto& dropper : sc.droppers) {
+        const auto& s = sc.signatures.emplace_back((*dropper)->GetSignatures());
+        sc.hasUnanchoredPlugins |= s.empty();
+    }
+    CHECK(sc.scanner.Build(sc.signatures), false, "");
+
+    // shards are scanned independently (each one with its own cache view) and merged afterwards in offset order
+    std::vector<ShardResult> shards;
+    for (uint64 start = offset; start < size; start += SHARD_SIZE) {
+        shards.push_back({ .start = start, .end = std::min<uint64>(start + SHARD_SIZE, size) });
+    }
+    if (shards.empty()) {
+        return true;
+    }
+
+    const auto workersCount = std::min<uint32>(GetWorkersCount(), static_cast<uint32>(shards.size()));
+    std::vector<DataCache> views(workersCount);
+    for (auto& view : views) {
+        CHECK(view.InitView(cache), false, "");
     }
 
     ProgressStatus::Init("Searching...", size);
     LocalString<512> ls;
-    const char* format          = "[%llu/%llu] bytes... Found [%u] object(s).";
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+
+    ParallelFor(
+          static_cast<uint32>(shards.size()),
+          [&](uint32 index, uint32 workerIndex) { ScanShard(views[workerIndex], sc, shards[index]); },
+          [&]() {
+              const auto scanned = std::min<uint64>(offset + sc.scannedBytes.load(std::memory_order_relaxed), size);
+              if (ProgressStatus::Update(scanned, ls.Format(format, scanned, size, sc.objectsCount.load(std::memory_order_relaxed)))) {
+                  sc.stop.store(true, std::memory_order_relaxed);
+                  return false;
+              }
+              return true;
+          });
+
+    // the scan of a shard can be reused from the offset where the previous shards resume (the end of their last skipped finding)
+    // as long as that offset is not itself skipped by the shard => otherwise rescan the shard from there
+    uint64 resumeOffset = offset;
+    for (auto& shard : shards) {
+        if (!shard.completed) {
+            break;
+        }
+        if (resumeOffset >= shard.end) {
+            continue;
+        }
+
+        const auto isSkipped = std::any_of(shard.skips.begin(), shard.skips.end(), [resumeOffset](const std::pair<uint64, uint64>& s) {
+            return s.first < resumeOffset && resumeOffset < s.second;
+        });
+        if (isSkipped) {
+            shard = ShardResult{ .start = resumeOffset, .end = shard.end };
+            ScanShard(cache, sc, shard);
+            CHECKBK(shard.completed, "");
+        }
+
+        for (const auto& [scanOffset, f] : shard.findings) {
+            if (scanOffset < resumeOffset) {
+                continue;
+            }
+            context.findings.push_back(f);
+            context.occurences[f.dropperName] += 1;
+            context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+        }
+
+        resumeOffset = shard.exitOffset;
+        if (shard.exitOffset < shard.end) {
+            break; // no more data to scan
+        }
+    }
+
+    uint32 objectsCount = 0;
+    for (const auto& [_, v] : context.occurences) {
+        objectsCount += v;
+    }
+    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
+
+    return true;
+}
+
+void Instance::ScanShard(DataCache& cache, ScanContext& sc, ShardResult& shard)
+{
+    auto offset     = shard.start;
+    auto nextOffset = offset;
+    auto scanner    = sc.scanner;
+
+    scanner.Reset(offset, shard.end);
+    uint64 candidateOffset = 0;
+    uint64 candidateMask   = 0;
+    bool hasCandidate      = scanner.Next(cache, candidateOffset, candidateMask);
+
     constexpr uint64 CHUNK_SIZE = 10000;
-    uint64 chunks               = offset / CHUNK_SIZE;
-    uint64 toUpdate             = chunks * CHUNK_SIZE;
-    while (offset < size) {
-        if (offset >= toUpdate) {
-            uint32 objectsCount = 0;
-            for (const auto& [_, v] : context.occurences) {
-                objectsCount += v;
+    uint64 reported             = offset;
+    while (offset < shard.end) {
+        // nothing left to check between candidates => jump directly to the next one
+        if (!sc.hasUnanchoredPlugins) {
+            if (!hasCandidate) {
+                offset = shard.end;
+                break;
             }
+            offset = std::max<uint64>(offset, candidateOffset);
+        }
+
+        if (offset >= reported + CHUNK_SIZE) {
+            CHECKBK(sc.stop.load(std::memory_order_relaxed) == false, "");
+            sc.scannedBytes.fetch_add(offset - reported, std::memory_order_relaxed);
+            reported = offset;
 
-            CHECKBK(ProgressStatus::Update(offset, ls.Format(format, offset, size, objectsCount)) == false, "");
-            chunks += 1;
-            toUpdate = chunks * CHUNK_SIZE;
+            if (sc.hasUnanchoredPlugins) {
+                cache.Get(offset, cache.GetCacheSize(), false); // optimization
+            }
+        }
 
-            cache.Get(offset, cache.GetCacheSize(), false); // optimization
+        while (hasCandidate && candidateOffset < offset) {
+            hasCandidate = scanner.Next(cache, candidateOffset, candidateMask);
+        }
+        const uint64 matchedMask = hasCandidate && candidateOffset == offset ? candidateMask : 0;
+        if (!sc.hasUnanchoredPlugins && matchedMask == 0) {
+            continue;
         }
 
         auto buffer = GetPrecachedBuffer(offset, cache);
-        CHECKBK(buffer.GetLength() > 0, "");
+        if (buffer.GetLength() == 0) {
+            break; // end of data => the whole scan stops here
+        }
         nextOffset = offset + 1;
 
         for (uint32 i = 0; i < static_cast<uint32>(Priority::Count); i++) {
@@ -323,19 +429,23 @@ bool Instance::ProcessObjects(
                 }
             }
 
-            for (auto& dropper : whitelistedPlugins) {
+            for (uint32 j = 0; j < static_cast<uint32>(sc.droppers.size()); j++) {
+                auto& dropper = sc.droppers[j];
                 if ((*dropper)->GetPriority() != priority) {
                     continue;
                 }
+                if (!sc.signatures[j].empty() && (matchedMask & (1ULL << j)) == 0) {
+                    continue;
+                }
 
                 Finding finding{ .dropperName = (*dropper)->GetName(), .category = (*dropper)->GetCategory(), .subcategory = (*dropper)->GetSubcategory() };
                 const auto result = (*dropper)->Check(offset, cache, buffer, finding);
 
                 if (result && finding.result != Result::NotFound) {
-                    auto& f = context.findings.emplace_back(finding);
-                    context.occurences[f.dropperName] += 1;
+                    auto& f = shard.findings.emplace_back(offset, finding).second;
+                    sc.objectsCount.fetch_add(1, std::memory_order_relaxed);
 
-                    if (!recursive) {
+                    if (!sc.recursive) {
                         nextOffset = f.end;
                     }
 
@@ -347,10 +457,9 @@ bool Instance::ProcessObjects(
                     } else {
                         f.end += 1;
                     }
-                    context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
 
-                    if (identify != nullptr) {
-                        f.artefact = identify(cache, f.subcategory, f.start, f.end, f.result);
+                    if (sc.identify != nullptr) {
+                        f.artefact = sc.identify(cache, f.subcategory, f.start, f.end, f.result);
                     }
 
                     break;
@@ -358,16 +467,22 @@ bool Instance::ProcessObjects(
             }
         }
 
-        offset = nextOffset;
-    }
+        if (nextOffset > offset + 1) {
+            shard.skips.emplace_back(offset, nextOffset);
 
-    uint32 objectsCount = 0;
-    for (const auto& [_, v] : context.occurences) {
-        objectsCount += v;
+            // the skipped range is not fed to the automaton anymore
+            if (nextOffset < shard.end && !scanner.IsEmpty()) {
+                scanner.Reset(nextOffset, shard.end);
+                hasCandidate = scanner.Next(cache, candidateOffset, candidateMask);
+            }
+        }
+
+        offset = nextOffset;
     }
-    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
 
-    return true;
+    sc.scannedBytes.fetch_add(std::min<uint64>(offset, shard.end) - std::min<uint64>(reported, shard.end), std::memory_order_relaxed);
+    shard.exitOffset = offset;
+    shard.completed  = offset >= shard.end || sc.stop.load(std::memory_order_relaxed) == false;
 }
 
 bool Instance::SetHighlighting(bool value, bool warn)
@@ -199,6 +199,11 @@ bool MZPE::ShouldGroupInOneFile() const
     return false;
 }
 
+std::vector<std::string_view> MZPE::GetSignatures() const
+{
+    return { MagicToSignature(IMAGE_DOS_SIGNATURE) };
+}
+
 bool MZPE::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(IsMagicU16(precachedBuffer, IMAGE_DOS_SIGNATURE), false, "");
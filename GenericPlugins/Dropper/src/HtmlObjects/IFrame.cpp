@@ -35,6 +35,11 @@ bool IFrame::ShouldGroupInOneFile() const
     return false;
 }
 
+std::vector<std::string_view> IFrame::GetSignatures() const
+{
+    return { START };
+}
+
 bool IFrame::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
@@ -35,6 +35,11 @@ bool Script::ShouldGroupInOneFile() const
     return false;
 }
 
+std::vector<std::string_view> Script::GetSignatures() const
+{
+    return { START };
+}
+
 bool Script::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
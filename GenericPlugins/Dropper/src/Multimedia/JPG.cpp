@@ -34,6 +34,11 @@ bool JPG::ShouldGroupInOneFile() const
     return false;
 }
 
+std::vector<std::string_view> JPG::GetSignatures() const
+{
+    return { MagicToSignature(IMAGE_JPG_MAGIC_SOI) };
+}
+
 bool JPG::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(IsMagicU16(precachedBuffer, IMAGE_JPG_MAGIC_SOI), false, "");
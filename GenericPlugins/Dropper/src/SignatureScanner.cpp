@@ -0,0 +1,183 @@
+#include "SignatureScanner.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace GView::GenericPlugins::Droppper
+{
+bool SignatureScanner::Build(const std::vector<std::vector<std::string_view>>& signatures)
+{
+    CHECK(signatures.size() <= MAX_DROPPERS, false, "");
+
+    transitions.clear();
+    outputs.clear();
+    maxLength = 0;
+
+    transitions.emplace_back().fill(ROOT);
+    outputs.emplace_back();
+
+    // trie (a transition to ROOT means "no child" while building it - ROOT is never a child)
+    for (uint32 i = 0; i < static_cast<uint32>(signatures.size()); i++) {
+        const uint64 mask = 1ULL << i;
+        for (const auto& signature : signatures[i]) {
+            CHECK(!signature.empty(), false, "");
+
+            uint32 node = ROOT;
+            for (const auto c : signature) {
+                auto& next = transitions[node][static_cast<uint8>(c)];
+                if (next == ROOT) {
+                    next = static_cast<uint32>(transitions.size());
+                    transitions.emplace_back().fill(ROOT);
+                    outputs.emplace_back();
+                }
+                node = next;
+            }
+
+            const auto length = static_cast<uint32>(signature.size());
+            auto it           = std::find_if(outputs[node].begin(), outputs[node].end(), [length](const Pattern& p) { return p.length == length; });
+            if (it != outputs[node].end()) {
+                it->mask |= mask;
+            } else {
+                outputs[node].push_back({ length, mask });
+            }
+            maxLength = std::max<uint32>(maxLength, length);
+        }
+    }
+
+    // fail links (BFS) folded directly into the transition table => a complete DFA
+    std::vector<uint32> fail(transitions.size(), ROOT);
+    std::deque<uint32> queue;
+    for (uint32 c = 0; c < ALPHABET_SIZE; c++) {
+        const auto child = transitions[ROOT][c];
+        if (child != ROOT) {
+            queue.push_back(child);
+        }
+    }
+
+    while (!queue.empty()) {
+        const auto node = queue.front();
+        queue.pop_front();
+
+        const auto& inherited = outputs[fail[node]];
+        outputs[node].insert(outputs[node].end(), inherited.begin(), inherited.end());
+
+        for (uint32 c = 0; c < ALPHABET_SIZE; c++) {
+            const auto child = transitions[node][c];
+            if (child != ROOT) {
+                fail[child] = transitions[fail[node]][c];
+                queue.push_back(child);
+            } else {
+                transitions[node][c] = transitions[fail[node]][c];
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SignatureScanner::IsEmpty() const
+{
+    return maxLength == 0;
+}
+
+uint32 SignatureScanner::GetMaxSignatureLength() const
+{
+    return maxLength;
+}
+
+void SignatureScanner::Reset(uint64 offset, uint64 end)
+{
+    state      = ROOT;
+    scanOffset = offset;
+    limit      = end;
+    candidates.clear();
+    carried.clear();
+    candidateIndex = 0;
+}
+
+bool SignatureScanner::Feed(DataCache& cache)
+{
+    // a prefix starting right before the limit may end after it
+    const auto feedEnd = std::min<uint64>(limit + maxLength - 1, cache.GetSize());
+    if (scanOffset >= feedEnd) {
+        return false;
+    }
+
+    const auto size = static_cast<uint32>(std::min<uint64>(cache.GetCacheSize(), feedEnd - scanOffset));
+    auto buffer     = cache.Get(scanOffset, size, false);
+    if (buffer.GetLength() == 0) {
+        return false;
+    }
+
+    const auto data   = buffer.GetData();
+    const auto length = buffer.GetLength();
+    for (uint32 i = 0; i < length; i++) {
+        state = transitions[state][data[i]];
+        for (const auto& p : outputs[state]) {
+            const auto start = scanOffset + i + 1 - p.length;
+            if (start < limit) {
+                candidates.push_back({ start, p.mask });
+            }
+        }
+    }
+    scanOffset += length;
+
+    if (scanOffset >= feedEnd || length < size) {
+        Flush(UINT64_MAX);
+        scanOffset = feedEnd;
+    } else {
+        // every prefix starting before (scanOffset - maxLength + 1) has already been fed
+        Flush(scanOffset + 1 >= maxLength ? scanOffset + 1 - maxLength : 0);
+    }
+
+    return true;
+}
+
+void SignatureScanner::Flush(uint64 finalizeUpTo)
+{
+    // matches are reported in the order of their end offsets => sort by start offset and merge the masks
+    candidates.insert(candidates.begin(), carried.begin(), carried.end());
+    carried.clear();
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.offset < b.offset; });
+
+    size_t count = 0;
+    for (const auto& c : candidates) {
+        if (count > 0 && candidates[count - 1].offset == c.offset) {
+            candidates[count - 1].mask |= c.mask;
+        } else {
+            candidates[count++] = c;
+        }
+    }
+    candidates.resize(count);
+
+    auto it = std::lower_bound(candidates.begin(), candidates.end(), finalizeUpTo, [](const Candidate& c, uint64 offset) { return c.offset < offset; });
+    carried.assign(it, candidates.end());
+    candidates.erase(it, candidates.end());
+    candidateIndex = 0;
+}
+
+bool SignatureScanner::Next(DataCache& cache, uint64& offset, uint64& mask)
+{
+    if (IsEmpty()) {
+        return false;
+    }
+
+    while (candidateIndex >= candidates.size()) {
+        candidates.clear();
+        candidateIndex = 0;
+
+        if (!Feed(cache)) {
+            if (carried.empty()) {
+                return false;
+            }
+            candidates.swap(carried);
+        }
+    }
+
+    const auto& c = candidates[candidateIndex++];
+    offset        = c.offset;
+    mask          = c.mask;
+
+    return true;
+}
+} // namespace GView::GenericPlugins::Droppper
@@ -10,6 +10,8 @@ static const std::string_view REGISTRY_REGEX_ASCII{
 static const std::string_view REGISTRY_REGEX_UNICODE{
     R"(^((H\x00K\x00E\x00Y\x00_\x00L\x00O\x00C\x00A\x00L\x00_\x00M\x00A\x00C\x00H\x00I\x00N\x00E\x00|H\x00K\x00L\x00M\x00|H\x00K\x00E\x00Y\x00_\x00C\x00U\x00R\x00R\x00E\x00N\x00T\x00_\x00U\x00S\x00E\x00R\x00|H\x00K\x00C\x00U\x00|H\x00K\x00E\x00Y\x00_\x00U\x00S\x00E\x00R\x00S\x00|H\x00K\x00U\x00|H\x00K\x00E\x00Y\x00_\x00C\x00L\x00A\x00S\x00S\x00E\x00S\x00_\x00R\x00O\x00O\x00T\x00|H\x00K\x00C\x00R\x00|H\x00K\x00E\x00Y\x00_\x00C\x00U\x00R\x00R\x00E\x00N\x00T\x00_\x00C\x00O\x00N\x00F\x00I\x00G\x00|H\x00K\x00C\x00C\x00)\\x00\\x00([a-zA-Z .0-9\_\\]\x00)+))"
 };
+static constexpr std::string_view REGISTRY_PREFIX_ASCII{ "HK" };
+static constexpr std::string_view REGISTRY_PREFIX_UNICODE{ "H\0K\0", 4 };
 
 Registry::Registry(bool caseSensitive, bool unicode)
 {
@@ -34,6 +36,20 @@ Subcategory Registry::GetSubcategory() const
     return Subcategory::Registry;
 }
 
+std::vector<std::string_view> Registry::GetSignatures() const
+{
+    // the matchers are anchored on this literal only when they are case sensitive
+    if (!caseSensitive) {
+        return {};
+    }
+
+    std::vector<std::string_view> signatures{ REGISTRY_PREFIX_ASCII };
+    if (unicode) {
+        signatures.push_back(REGISTRY_PREFIX_UNICODE);
+    }
+    return signatures;
+}
+
 bool Registry::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
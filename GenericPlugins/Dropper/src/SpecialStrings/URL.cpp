@@ -8,6 +8,10 @@ static const std::string_view URL_REGEX_ASCII{ R"(^(((https*:\/\/)|((https*:\/\/
 static const std::string_view URL_REGEX_UNICODE{
     R"(^(((h\x00t\x00t\x00p\x00(s\x00)*:\x00\/\x00\/\x00)|((h\x00t\x00t\x00p\x00(s\x00)*:\x00\/\x00\/\x00w\x00w\x00w\x00)|(w\x00w\x00w\x00)\.\x00))([a-zA-Z0-9_]\x00)+\.\x00([a-zA-Z0-9_\.]\x00)+(\/\x00([a-zA-Z0-9_\.]\x00)*)*))"
 };
+static constexpr std::string_view URL_PREFIX_HTTP_ASCII{ "http" };
+static constexpr std::string_view URL_PREFIX_WWW_ASCII{ "www" };
+static constexpr std::string_view URL_PREFIX_HTTP_UNICODE{ "h\0t\0t\0p\0", 8 };
+static constexpr std::string_view URL_PREFIX_WWW_UNICODE{ "w\0w\0w\0", 6 };
 
 URL::URL(bool caseSensitive, bool unicode)
 {
@@ -32,6 +36,21 @@ Subcategory URL::GetSubcategory() const
     return Subcategory::URL;
 }
 
+std::vector<std::string_view> URL::GetSignatures() const
+{
+    // the matchers are anchored on these literals only when they are case sensitive
+    if (!caseSensitive) {
+        return {};
+    }
+
+    std::vector<std::string_view> signatures{ URL_PREFIX_HTTP_ASCII, URL_PREFIX_WWW_ASCII };
+    if (unicode) {
+        signatures.push_back(URL_PREFIX_HTTP_UNICODE);
+        signatures.push_back(URL_PREFIX_WWW_UNICODE);
+    }
+    return signatures;
+}
+
 bool URL::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
@@ -12,6 +12,8 @@ constexpr std::string_view Bitcoin_P2TR_MAGIC{ "bc1p" };
 constexpr std::string_view Ethereum_MAGIC{ "0x" };
 constexpr std::string_view Stellar_MEMO_MAGIC{ "G" };
 constexpr std::string_view Stellar_MUXED_MAGIC{ "M" };
+constexpr std::string_view Bitcoin_P2WPKH_MAGIC_UNICODE{ "b\0c\0" "1\0q\0", 8 };
+constexpr std::string_view Bitcoin_P2TR_MAGIC_UNICODE{ "b\0c\0" "1\0p\0", 8 };
 
 static std::map<WalletType, uint32> WALLET_ADDRESS_LENGTH{
     { WalletType::Bitcoin_P2WPKH, 42 }, { WalletType::Bitcoin_P2WSH, 62 }, { WalletType::Bitcoin_P2TR, 62 },
@@ -45,6 +47,17 @@ Subcategory Wallet::GetSubcategory() const
     return Subcategory::Wallet;
 }
 
+std::vector<std::string_view> Wallet::GetSignatures() const
+{
+    // only the 4 bytes prefixes can match (the magic is always compared on 4 characters)
+    std::vector<std::string_view> signatures{ Bitcoin_P2WPKH_MAGIC, Bitcoin_P2TR_MAGIC };
+    if (unicode) {
+        signatures.push_back(Bitcoin_P2WPKH_MAGIC_UNICODE);
+        signatures.push_back(Bitcoin_P2TR_MAGIC_UNICODE);
+    }
+    return signatures;
+}
+
 bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
@@ -95,18 +108,12 @@ bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
 
     for (const auto& [k, v] : WALLET_PREFIX) {
         if (sMagic == v && length == WALLET_ADDRESS_LENGTH.at(k)) {
-            this->checkResult = k;
-            finding.result    = isUnicode ? Result::Unicode : Result::Ascii;
-            finding.details   = static_cast<uint32>(k);
+            finding.result  = isUnicode ? Result::Unicode : Result::Ascii;
+            finding.details = static_cast<uint32>(k);
             return true;
         }
     }
 
     return true;
 }
-
-WalletType Wallet::GetLastCheckResult() const
-{
-    return this->checkResult;
-}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
@@ -17,6 +17,7 @@ static const uint32 EMBEDDED_OBJECTS_MAX_VALUE                      = 6;
 static const uint32 EMBEDDED_OBJECTS_LEGEND_HEIGHT                  = 12 + 8;
 static const std::string_view EMBEDDED_OBJECTS_OPTION_NAME          = "Embedded Objects";
 static const uint32 MINIMUM_BLOCK_SIZE                              = 4;
+static const uint64 MAXIMUM_HISTOGRAMS_COUNT                        = 64 * 1024; // 1 KB each
 
 static const uint32 COMBO_BOX_ITEM_SHANNON_ENTROPY           = 0;
 static const uint32 COMBO_BOX_ITEM_RENYI_ENTROPY             = 1;
@@ -46,6 +47,21 @@ class Plugin : public Window
     uint32 blockSize  = MINIMUM_BLOCK_SIZE;
     double renyiAlpha = 0.5;
 
+    // entropy of every block => redrawing or switching the entropy type does not read the object again
+    struct {
+        uint32 blockSize  = 0; // 0 => nothing computed yet
+        double renyiAlpha = 0.0;
+        std::vector<float> shannon;
+        std::vector<float> renyi;
+    } blocksEntropy;
+
+    // histogram of every block => the entropy of blocks of a multiple of this size (resizing the canvas doubles the block size) or
+    // with another alpha is computed by adding the histograms, without reading the object again
+    struct {
+        uint32 blockSize = 0; // 0 => nothing computed yet
+        std::vector<GView::Entropy::Histogram> values;
+    } blocksHistograms;
+
   private:
     void ResizeLegendCanvas();
     static Color ShannonEntropyValueToColor(int32 value);
@@ -54,6 +70,7 @@ class Plugin : public Window
     static double ComputeEpsilon(uint64 size);
     static Color EmbeddedObjectValueToColor(std::string_view name);
     bool InitializeBlocksForCanvas();
+    bool UpdateBlocksEntropy();
 
   public:
     Plugin(Reference<Object> object);
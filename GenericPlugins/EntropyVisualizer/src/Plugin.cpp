@@ -150,19 +150,11 @@ bool Plugin::DrawEntropy(EntropyType type)
     canvas->Resize(maxX, maxY, 'X', color);
     canvas->ClearEntireSurface('X', color);
 
+    CHECK(UpdateBlocksEntropy(), false, "");
+    const auto& values = type == EntropyType::Renyi ? blocksEntropy.renyi : blocksEntropy.shannon;
+
     for (uint32 i = 0; i < blocksCount; i++) {
-        auto bf    = cache.Get(i * static_cast<uint64>(this->blockSize), this->blockSize, false);
-        auto value = 0.0;
-        switch (type) {
-        case EntropyType::Shannon:
-        case EntropyType::ShannonDataType:
-            value = GView::Entropy::ShannonEntropy(bf);
-            break;
-        case EntropyType::Renyi:
-            value = GView::Entropy::RenyiEntropy(bf, this->renyiAlpha);
-        default:
-            break;
-        }
+        const auto value = i < values.size() ? static_cast<double>(values[i]) : 0.0;
 
         auto fColor = Color::Black;
         switch (type) {
@@ -186,6 +178,61 @@ bool Plugin::DrawEntropy(EntropyType type)
     return true;
 }
 
+bool Plugin::UpdateBlocksEntropy()
+{
+    if (blocksEntropy.blockSize == this->blockSize && blocksEntropy.renyiAlpha == this->renyiAlpha) {
+        return true;
+    }
+    blocksEntropy.blockSize = 0;
+
+    auto& cache              = object->GetData();
+    const uint64 size        = cache.GetSize();
+    const uint64 blocksCount = (size + this->blockSize - 1) / this->blockSize;
+
+    // the object is read again only if the blocks are not made of the blocks with histograms
+    if (blocksHistograms.blockSize == 0 || this->blockSize % blocksHistograms.blockSize != 0) {
+        LocalString<128> ls;
+        ProgressStatus::Init("Computing entropy...", blocksCount);
+        const auto onProgress = [&](uint64 computed) { return !ProgressStatus::Update(computed, ls.Format("[%llu/%llu] blocks", computed, blocksCount)); };
+        if (blocksCount > MAXIMUM_HISTOGRAMS_COUNT) {
+            // too many histograms to keep => only the entropy of the blocks
+            CHECK(GView::Entropy::ComputeBlocksEntropy(cache, this->blockSize, this->renyiAlpha, blocksEntropy.shannon, blocksEntropy.renyi, onProgress),
+                  false,
+                  "");
+            blocksEntropy.blockSize  = this->blockSize;
+            blocksEntropy.renyiAlpha = this->renyiAlpha;
+            return true;
+        }
+
+        blocksHistograms.blockSize = 0;
+        CHECK(GView::Entropy::ComputeBlocksHistograms(cache, this->blockSize, blocksHistograms.values, onProgress), false, "");
+        blocksHistograms.blockSize = this->blockSize;
+    }
+
+    const uint64 parts     = this->blockSize / blocksHistograms.blockSize;
+    const auto& histograms = blocksHistograms.values;
+    blocksEntropy.shannon.resize(blocksCount);
+    blocksEntropy.renyi.resize(blocksCount);
+    GView::Entropy::Histogram frequency;
+    for (uint64 block = 0; block < blocksCount; block++) {
+        frequency.fill(0);
+        const uint64 last = std::min<uint64>((block + 1) * parts, histograms.size());
+        for (uint64 part = block * parts; part < last; part++) {
+            for (uint32 i = 0; i < frequency.size(); i++) {
+                frequency[i] += histograms[part][i];
+            }
+        }
+
+        const uint64 length          = std::min<uint64>(this->blockSize, size - block * this->blockSize);
+        blocksEntropy.shannon[block] = static_cast<float>(GView::Entropy::ShannonEntropy(frequency, length));
+        blocksEntropy.renyi[block]   = static_cast<float>(GView::Entropy::RenyiEntropy(frequency, length, this->renyiAlpha));
+    }
+
+    blocksEntropy.blockSize  = this->blockSize;
+    blocksEntropy.renyiAlpha = this->renyiAlpha;
+    return true;
+}
+
 bool Plugin::DrawEntropyLegend(EntropyType type)
 {
     CHECK(this->canvasLegend.IsValid(), false, "");
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "GView.hpp"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace GView::GenericPlugins::SyncCompare
+{
+// A chunk cut by content: its boundaries depend only on the bytes around them (gear rolling hash, FastCDC) => an inserted or
+// deleted byte changes only the chunks around it and the chunks after it are found again in the other object.
+struct Chunk
+{
+    uint64 offset;
+    uint32 size;
+    uint64 fingerprint; // hash of the content of the chunk
+};
+
+enum class RegionType : uint8
+{
+    Aligned,  // same content in both objects
+    Deleted,  // only in the reference object
+    Inserted, // only in the other object
+};
+
+// A region of an object relative to the reference object. A deleted region has size 0 and an inserted one has referenceSize 0,
+// their offset (in the object without them) is where they were removed from / inserted to.
+struct AlignedRegion
+{
+    RegionType type;
+    uint64 referenceOffset;
+    uint64 referenceSize;
+    uint64 offset;
+    uint64 size;
+};
+
+// Aligns N objects on their content: every object is chunked once (sequentially, in parallel with the others), the chunks
+// are matched with the chunks of the reference object (the first one) in linear time and the bounds of every region that
+// is not matched are refined byte by byte.
+class ContentAlignment
+{
+    std::vector<std::vector<AlignedRegion>> regions; // for every object (the reference object has none), sorted by offsets
+
+  public:
+    static bool ComputeChunks(GView::Utils::DataCache& cache, std::vector<Chunk>& chunks, std::atomic<uint64>& bytesProcessed, const std::atomic<bool>& stop);
+    static bool AlignChunks(
+          GView::Utils::DataCache& reference,
+          const std::vector<Chunk>& referenceChunks,
+          GView::Utils::DataCache& other,
+          const std::vector<Chunk>& otherChunks,
+          std::vector<AlignedRegion>& result);
+
+    bool Compute(const std::vector<GView::Utils::DataCache*>& caches, const std::function<bool(uint64 bytesProcessed)>& onProgress);
+    void Clear();
+
+    uint32 GetObjectsCount() const
+    {
+        return static_cast<uint32>(regions.size());
+    }
+    const std::vector<AlignedRegion>& GetRegions(uint32 objectIndex) const
+    {
+        return regions.at(objectIndex);
+    }
+
+    // offset in object 'to' with the same content as 'offset' in object 'from' (or the closest one if that content is missing)
+    uint64 MapOffset(uint32 from, uint64 offset, uint32 to) const;
+};
+} // namespace GView::GenericPlugins::SyncCompare
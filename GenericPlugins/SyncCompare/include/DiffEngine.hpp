@@ -0,0 +1,53 @@
+#pragma once
+
+#include "GView.hpp"
+
+#include <vector>
+
+namespace GView::GenericPlugins::SyncCompare
+{
+// Compares the same window of N objects (every object with its own start offset) and keeps the ranges, relative to the
+// start of the window, where the bytes are not identical in all of them.
+// Identical chunks are skipped with memcmp (vectorized by the C runtime), only the chunks that differ are compared byte by byte.
+class DiffEngine
+{
+  public:
+    struct Range
+    {
+        uint64 start; // relative to the start of the window
+        uint64 end;   // exclusive
+    };
+
+  private:
+    std::vector<uint64> starts;
+    std::vector<std::vector<uint8>> windows; // bytes of every object inside the compared window
+    std::vector<Range> differences;          // sorted, not overlapping
+    uint64 length{ 0 };
+
+  public:
+    bool Compare(const std::vector<GView::Utils::DataCache*>& caches, const std::vector<uint64>& starts, uint64 length);
+    void Clear();
+
+    bool IsComputedFor(const std::vector<uint64>& starts, uint64 length) const
+    {
+        return this->starts == starts && this->length >= length;
+    }
+    uint64 GetLength() const
+    {
+        return length;
+    }
+    const std::vector<Range>& GetDifferences() const
+    {
+        return differences;
+    }
+
+    bool IsDifferent(uint64 delta) const;
+    // number of objects that have the given byte at start + delta
+    uint32 CountMatches(uint64 delta, uint8 byte) const;
+
+    // first delta (>= 0) where the objects differ or where one of them ends, false if none was found
+    static bool FindFirstDifference(const std::vector<GView::Utils::DataCache*>& caches, const std::vector<uint64>& starts, uint64& delta);
+    // first offset (>= start) of a byte different from value
+    static bool FindFirstDifferentByte(GView::Utils::DataCache& cache, uint64 start, uint8 value, uint64& offset);
+};
+} // namespace GView::GenericPlugins::SyncCompare
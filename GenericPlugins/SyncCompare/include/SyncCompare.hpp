@@ -1,6 +1,8 @@
 #pragma once
 
 #include "GView.hpp"
+#include "DiffEngine.hpp"
+#include "ContentAlignment.hpp"
 #include <cmath>
 
 namespace GView::GenericPlugins::SyncCompare
@@ -8,10 +10,30 @@ namespace GView::GenericPlugins::SyncCompare
 using namespace AppCUI::Graphics;
 using namespace GView::View;
 
+// Lists the regions found by the content alignment, the pressed one is shown in all the views
+class AlignedRegionsWindow : public Window, public Handlers::OnListViewItemPressedInterface
+{
+    Reference<ListView> list;
+    std::vector<std::pair<uint32, AlignedRegion>> regions; // object index, region
+    uint64 selected{ GView::Utils::INVALID_OFFSET };
+
+  public:
+    AlignedRegionsWindow(const ContentAlignment& alignment);
+
+    bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    void OnListViewItemPressed(Reference<ListView> lv, ListViewItem item) override;
+    bool GetSelectedRegion(uint32& objectIndex, AlignedRegion& region) const;
+};
+
 class Plugin : public Window, public Handlers::OnButtonPressedInterface, public BufferColorInterface, public OnStartViewMoveInterface
 {
     Reference<ListView> list;
     Reference<CheckBox> sync;
+    DiffEngine visibleDifferences;    // differences between the windows currently shown by all the views
+    ContentAlignment contentAlignment; // empty => the views are moved with the same delta
+
+    bool UpdateVisibleDifferences();
+    bool MoveViewsToAlignedOffset(uint32 objectIndex, uint64 offset);
 
   public:
     Plugin();
@@ -25,6 +47,7 @@ class Plugin : public Window, public Handlers::OnButtonPressedInterface, public
     void SetUpCallbackForViews(bool remove);
     bool ToggleSync();
     bool FindNextDifference();
+    bool ToggleContentAlignment();
     static bool FindNextDifferentCharacter();
 };
 } // namespace GView::GenericPlugins::SyncCompare
@@ -0,0 +1,346 @@
+#include "ContentAlignment.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+using namespace GView::Utils;
+
+constexpr uint32 CHUNK_MIN_SIZE     = 2 * 1024;
+constexpr uint32 CHUNK_AVERAGE_SIZE = 8 * 1024;
+constexpr uint32 CHUNK_MAX_SIZE     = 64 * 1024;
+constexpr uint64 CHUNK_MASK_SMALL   = 0xFFFE000000000000ULL; // 15 bits => a cut is less likely below the average size
+constexpr uint64 CHUNK_MASK_LARGE   = 0xFFE0000000000000ULL; // 11 bits => a cut is more likely above the average size
+constexpr uint64 FNV_OFFSET_BASIS   = 0xCBF29CE484222325ULL;
+constexpr uint64 FNV_PRIME          = 0x00000100000001B3ULL;
+constexpr uint64 REFINE_BLOCK_SIZE  = 4096;
+constexpr uint32 NO_CHUNK           = 0xFFFFFFFF;
+
+namespace GView::GenericPlugins::SyncCompare
+{
+// random values for every byte (splitmix64 with a fixed seed => the chunks of the same content are the same on every run)
+static const std::array<uint64, 256>& GetGearTable()
+{
+    static const auto table = []() {
+        std::array<uint64, 256> values{};
+        uint64 state = 0x5EED5EED5EED5EEDULL;
+        for (auto& value : values)
+        {
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64 z = state;
+            z        = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z        = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            value    = z ^ (z >> 31);
+        }
+        return values;
+    }();
+    return table;
+}
+
+static uint64 GetChunkKey(const Chunk& chunk)
+{
+    return chunk.fingerprint ^ (static_cast<uint64>(chunk.size) * 0x9E3779B97F4A7C15ULL);
+}
+
+bool ContentAlignment::ComputeChunks(DataCache& cache, std::vector<Chunk>& chunks, std::atomic<uint64>& bytesProcessed, const std::atomic<bool>& stop)
+{
+    const auto& gear     = GetGearTable();
+    const uint64 size    = cache.GetSize();
+    const uint32 setSize = std::max<uint32>(cache.GetCacheSize(), 1);
+
+    chunks.clear();
+    chunks.reserve(static_cast<size_t>(size / CHUNK_AVERAGE_SIZE + 1));
+
+    // the state of the current chunk is kept between the reads => the object is read only once
+    Chunk current{ 0, 0, FNV_OFFSET_BASIS };
+    uint64 hash = 0;
+    for (uint64 offset = 0; offset < size;)
+    {
+        CHECK(stop.load(std::memory_order_relaxed) == false, false, "");
+
+        const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(setSize, size - offset)), false);
+        CHECK(buffer.IsValid() && buffer.GetLength() > 0, false, "");
+
+        const auto data = buffer.GetData();
+        for (uint32 i = 0; i < buffer.GetLength(); i++)
+        {
+            current.fingerprint = (current.fingerprint ^ data[i]) * FNV_PRIME;
+            current.size++;
+            if (current.size <= CHUNK_MIN_SIZE)
+            {
+                continue; // no cut before the minimum size => the rolling hash starts there
+            }
+
+            hash              = (hash << 1) + gear[data[i]];
+            const uint64 mask = current.size < CHUNK_AVERAGE_SIZE ? CHUNK_MASK_SMALL : CHUNK_MASK_LARGE;
+            if ((hash & mask) == 0 || current.size == CHUNK_MAX_SIZE)
+            {
+                chunks.push_back(current);
+                current = { current.offset + current.size, 0, FNV_OFFSET_BASIS };
+                hash    = 0;
+            }
+        }
+
+        offset += buffer.GetLength();
+        bytesProcessed.fetch_add(buffer.GetLength(), std::memory_order_relaxed);
+    }
+    if (current.size > 0)
+    {
+        chunks.push_back(current);
+    }
+
+    return true;
+}
+
+// number of identical bytes starting at aStart / bStart (at most maxSize)
+static uint64 GetCommonPrefix(DataCache& a, uint64 aStart, DataCache& b, uint64 bStart, uint64 maxSize)
+{
+    uint64 common = 0;
+    while (common < maxSize)
+    {
+        const auto size     = static_cast<uint32>(std::min<uint64>(REFINE_BLOCK_SIZE, maxSize - common));
+        const auto bufferA  = a.Get(aStart + common, size, false);
+        const auto bufferB  = b.Get(bStart + common, size, false);
+        const uint32 length = std::min<uint32>(bufferA.GetLength(), bufferB.GetLength());
+        if (!bufferA.IsValid() || !bufferB.IsValid() || length == 0)
+        {
+            break;
+        }
+
+        if (memcmp(bufferA.GetData(), bufferB.GetData(), length) != 0)
+        {
+            uint32 i = 0;
+            while (bufferA.GetData()[i] == bufferB.GetData()[i])
+            {
+                i++;
+            }
+            return common + i;
+        }
+        common += length;
+    }
+    return common;
+}
+
+// number of identical bytes ending right before aEnd / bEnd (at most maxSize)
+static uint64 GetCommonSuffix(DataCache& a, uint64 aEnd, DataCache& b, uint64 bEnd, uint64 maxSize)
+{
+    uint64 common = 0;
+    while (common < maxSize)
+    {
+        const auto size    = static_cast<uint32>(std::min<uint64>(REFINE_BLOCK_SIZE, maxSize - common));
+        const auto bufferA = a.Get(aEnd - common - size, size, true);
+        const auto bufferB = b.Get(bEnd - common - size, size, true);
+        if (bufferA.GetLength() < size || bufferB.GetLength() < size)
+        {
+            break;
+        }
+
+        for (uint32 i = size; i > 0; i--)
+        {
+            if (bufferA.GetData()[i - 1] != bufferB.GetData()[i - 1])
+            {
+                return common + (size - i);
+            }
+        }
+        common += size;
+    }
+    return common;
+}
+
+static void AddRegion(std::vector<AlignedRegion>& result, const AlignedRegion& region)
+{
+    if (region.referenceSize == 0 && region.size == 0)
+    {
+        return;
+    }
+
+    // consecutive aligned regions are merged
+    if (region.type == RegionType::Aligned && !result.empty() && result.back().type == RegionType::Aligned &&
+        result.back().referenceOffset + result.back().referenceSize == region.referenceOffset && result.back().offset + result.back().size == region.offset)
+    {
+        result.back().referenceSize += region.referenceSize;
+        result.back().size += region.size;
+        return;
+    }
+    result.push_back(region);
+}
+
+bool ContentAlignment::AlignChunks(
+      DataCache& reference,
+      const std::vector<Chunk>& referenceChunks,
+      DataCache& other,
+      const std::vector<Chunk>& otherChunks,
+      std::vector<AlignedRegion>& result)
+{
+    CHECK(referenceChunks.size() < NO_CHUNK && otherChunks.size() < NO_CHUNK, false, "");
+    result.clear();
+
+    // first reference chunk with a given content, the next ones are chained => every chunk is visited once
+    std::unordered_map<uint64, uint32> firstChunk;
+    std::vector<uint32> nextChunk(referenceChunks.size(), NO_CHUNK);
+    firstChunk.reserve(referenceChunks.size());
+    for (uint32 i = static_cast<uint32>(referenceChunks.size()); i > 0; i--)
+    {
+        auto [it, inserted] = firstChunk.try_emplace(GetChunkKey(referenceChunks[i - 1]), i - 1);
+        if (!inserted)
+        {
+            nextChunk[i - 1] = it->second;
+            it->second       = i - 1;
+        }
+    }
+
+    // greedy matching in the order of both objects: a chunk that jumps over reference chunks is accepted only if the next
+    // chunk matches as well (a common chunk far away must not break the alignment), the last chunks have no next one => they
+    // can not jump. The fingerprints only select the candidates, the bytes of a candidate are compared before it is accepted.
+    std::vector<std::pair<uint32, uint32>> matches; // reference chunk, other chunk
+    uint32 lastReference = NO_CHUNK;
+    for (uint32 j = 0; j < otherChunks.size(); j++)
+    {
+        auto it = firstChunk.find(GetChunkKey(otherChunks[j]));
+        if (it == firstChunk.end())
+        {
+            continue;
+        }
+        while (it->second != NO_CHUNK && lastReference != NO_CHUNK && it->second <= lastReference)
+        {
+            it->second = nextChunk[it->second];
+        }
+
+        // the next candidates are tried only if the bytes differ (same fingerprint, other content)
+        for (uint32 r = it->second; r != NO_CHUNK; r = nextChunk[r])
+        {
+            const bool isNext      = lastReference == NO_CHUNK ? r == 0 : r == lastReference + 1;
+            const bool isConfirmed = j + 1 < otherChunks.size() && r + 1 < referenceChunks.size() &&
+                                     GetChunkKey(referenceChunks[r + 1]) == GetChunkKey(otherChunks[j + 1]);
+            if (!isNext && !isConfirmed)
+            {
+                break;
+            }
+
+            const auto& referenceChunk = referenceChunks[r];
+            const auto& otherChunk     = otherChunks[j];
+            if (referenceChunk.size == otherChunk.size &&
+                GetCommonPrefix(reference, referenceChunk.offset, other, otherChunk.offset, otherChunk.size) == otherChunk.size)
+            {
+                matches.emplace_back(r, j);
+                lastReference = r;
+                break;
+            }
+        }
+    }
+
+    // the gaps between the matched chunks: their common start / end is aligned, the rest was deleted and / or inserted
+    uint64 referencePosition = 0;
+    uint64 otherPosition     = 0;
+    const auto addGap        = [&](uint64 referenceEnd, uint64 otherEnd) {
+        const uint64 maxCommon = std::min<uint64>(referenceEnd - referencePosition, otherEnd - otherPosition);
+        const uint64 prefix    = GetCommonPrefix(reference, referencePosition, other, otherPosition, maxCommon);
+        const uint64 suffix    = GetCommonSuffix(reference, referenceEnd, other, otherEnd, maxCommon - prefix);
+
+        AddRegion(result, { RegionType::Aligned, referencePosition, prefix, otherPosition, prefix });
+        AddRegion(result, { RegionType::Deleted, referencePosition + prefix, referenceEnd - suffix - referencePosition - prefix, otherPosition + prefix, 0 });
+        AddRegion(result, { RegionType::Inserted, referenceEnd - suffix, 0, otherPosition + prefix, otherEnd - suffix - otherPosition - prefix });
+        AddRegion(result, { RegionType::Aligned, referenceEnd - suffix, suffix, otherEnd - suffix, suffix });
+    };
+
+    for (const auto& [r, j] : matches)
+    {
+        const auto& referenceChunk = referenceChunks[r];
+        const auto& otherChunk     = otherChunks[j];
+        addGap(referenceChunk.offset, otherChunk.offset);
+        AddRegion(result, { RegionType::Aligned, referenceChunk.offset, referenceChunk.size, otherChunk.offset, otherChunk.size });
+        referencePosition = referenceChunk.offset + referenceChunk.size;
+        otherPosition     = otherChunk.offset + otherChunk.size;
+    }
+    addGap(reference.GetSize(), other.GetSize());
+
+    return true;
+}
+
+void ContentAlignment::Clear()
+{
+    regions.clear();
+}
+
+bool ContentAlignment::Compute(const std::vector<DataCache*>& caches, const std::function<bool(uint64 bytesProcessed)>& onProgress)
+{
+    Clear();
+    CHECK(caches.size() > 1, false, "");
+
+    // every object is chunked by a worker, through its own view of the cache
+    const auto objectsCount = static_cast<uint32>(caches.size());
+    std::vector<DataCache> views(objectsCount);
+    for (uint32 i = 0; i < objectsCount; i++)
+    {
+        CHECK(views[i].InitView(*caches[i]), false, "");
+    }
+
+    std::vector<std::vector<Chunk>> chunks(objectsCount);
+    std::atomic<uint64> bytesProcessed{ 0 };
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> failed{ false };
+    const bool completed = GView::Utils::ParallelFor(
+          objectsCount,
+          [&](uint32 index, uint32) {
+              if (!ComputeChunks(views[index], chunks[index], bytesProcessed, stop))
+              {
+                  failed.store(true, std::memory_order_relaxed);
+              }
+          },
+          [&]() {
+              if (onProgress != nullptr && !onProgress(bytesProcessed.load(std::memory_order_relaxed)))
+              {
+                  stop.store(true, std::memory_order_relaxed);
+                  return false;
+              }
+              return true;
+          });
+    CHECK(completed && !failed.load(std::memory_order_relaxed), false, "");
+
+    std::vector<std::vector<AlignedRegion>> result(objectsCount);
+    for (uint32 i = 1; i < objectsCount; i++)
+    {
+        CHECK(AlignChunks(*caches[0], chunks[0], *caches[i], chunks[i], result[i]), false, "");
+    }
+    regions = std::move(result);
+
+    return true;
+}
+
+// maps an offset from one side of the regions to the other one
+static uint64 MapOffsetThroughRegions(const std::vector<AlignedRegion>& regions, uint64 offset, bool fromReference)
+{
+    const auto fromStart = [fromReference](const AlignedRegion& region) { return fromReference ? region.referenceOffset : region.offset; };
+    const auto fromSize  = [fromReference](const AlignedRegion& region) { return fromReference ? region.referenceSize : region.size; };
+
+    // last region that starts before offset and has content on the 'from' side
+    auto it = std::upper_bound(regions.begin(), regions.end(), offset, [&](uint64 value, const AlignedRegion& region) { return value < fromStart(region); });
+    while (it != regions.begin() && fromSize(*(it - 1)) == 0)
+    {
+        --it;
+    }
+    if (it == regions.begin())
+    {
+        return offset;
+    }
+    --it;
+
+    const uint64 delta   = std::min<uint64>(offset - fromStart(*it), fromSize(*it) - 1);
+    const uint64 toStart = fromReference ? it->offset : it->referenceOffset;
+    const uint64 toSize  = fromReference ? it->size : it->referenceSize;
+    return toSize > 0 ? toStart + std::min<uint64>(delta, toSize - 1) : toStart;
+}
+
+uint64 ContentAlignment::MapOffset(uint32 from, uint64 offset, uint32 to) const
+{
+    CHECK(from < regions.size() && to < regions.size(), offset, "");
+    if (from == to)
+    {
+        return offset;
+    }
+
+    const uint64 referenceOffset = from == 0 ? offset : MapOffsetThroughRegions(regions[from], offset, false);
+    return to == 0 ? referenceOffset : MapOffsetThroughRegions(regions[to], referenceOffset, true);
+}
+} // namespace GView::GenericPlugins::SyncCompare
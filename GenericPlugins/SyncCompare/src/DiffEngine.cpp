@@ -0,0 +1,225 @@
+#include "DiffEngine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+using namespace GView::Utils;
+
+constexpr uint64 COMPARE_CHUNK_SIZE = 4096;
+
+namespace GView::GenericPlugins::SyncCompare
+{
+static bool AreEqualAt(const std::vector<const uint8*>& buffers, uint64 position)
+{
+    for (size_t i = 1; i < buffers.size(); i++)
+    {
+        if (buffers[i][position] != buffers[0][position])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// first position where one of the buffers differs from the first one (size if they are identical)
+static uint64 FindFirstMismatch(const std::vector<const uint8*>& buffers, uint64 size)
+{
+    for (uint64 start = 0; start < size; start += COMPARE_CHUNK_SIZE)
+    {
+        const uint64 chunkSize = std::min<uint64>(COMPARE_CHUNK_SIZE, size - start);
+
+        bool identical = true;
+        for (size_t i = 1; i < buffers.size() && identical; i++)
+        {
+            identical = memcmp(buffers[0] + start, buffers[i] + start, static_cast<size_t>(chunkSize)) == 0;
+        }
+        if (identical)
+        {
+            continue;
+        }
+
+        for (uint64 position = start; position < start + chunkSize; position++)
+        {
+            if (!AreEqualAt(buffers, position))
+            {
+                return position;
+            }
+        }
+    }
+    return size;
+}
+
+void DiffEngine::Clear()
+{
+    starts.clear();
+    windows.clear();
+    differences.clear();
+    length = 0;
+}
+
+bool DiffEngine::Compare(const std::vector<DataCache*>& caches, const std::vector<uint64>& starts, uint64 length)
+{
+    Clear();
+    CHECK(caches.size() == starts.size() && caches.size() > 1, false, "");
+
+    // the window is copied => the caches can be used for other reads afterwards
+    uint64 commonLength = length;
+    windows.resize(caches.size());
+    for (size_t i = 0; i < caches.size(); i++)
+    {
+        auto& window          = windows[i];
+        const uint64 readSize = std::max<uint64>(caches[i]->GetCacheSize(), 1);
+        window.reserve(static_cast<size_t>(length));
+        while (window.size() < length)
+        {
+            const auto size   = static_cast<uint32>(std::min<uint64>(length - window.size(), readSize));
+            const auto buffer = caches[i]->Get(starts[i] + window.size(), size, false);
+            if (!buffer.IsValid() || buffer.GetLength() == 0)
+            {
+                break;
+            }
+            window.insert(window.end(), buffer.GetData(), buffer.GetData() + buffer.GetLength());
+        }
+        commonLength = std::min<uint64>(commonLength, window.size());
+    }
+    this->starts = starts;
+    this->length = length;
+
+    std::vector<const uint8*> buffers(windows.size());
+    uint64 delta = 0;
+    while (delta < commonLength)
+    {
+        for (size_t i = 0; i < windows.size(); i++)
+        {
+            buffers[i] = windows[i].data() + delta;
+        }
+        const uint64 first = delta + FindFirstMismatch(buffers, commonLength - delta);
+        if (first == commonLength)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < windows.size(); i++)
+        {
+            buffers[i] = windows[i].data();
+        }
+        uint64 end = first + 1;
+        while (end < commonLength && !AreEqualAt(buffers, end))
+        {
+            end++;
+        }
+        differences.push_back({ first, end });
+        delta = end;
+    }
+
+    // where some of the objects end, they are different
+    if (commonLength < length)
+    {
+        if (!differences.empty() && differences.back().end == commonLength)
+        {
+            differences.back().end = length;
+        }
+        else
+        {
+            differences.push_back({ commonLength, length });
+        }
+    }
+
+    return true;
+}
+
+bool DiffEngine::IsDifferent(uint64 delta) const
+{
+    auto it = std::upper_bound(differences.begin(), differences.end(), delta, [](uint64 value, const Range& range) { return value < range.start; });
+    if (it == differences.begin())
+    {
+        return false;
+    }
+    --it;
+    return delta < it->end;
+}
+
+uint32 DiffEngine::CountMatches(uint64 delta, uint8 byte) const
+{
+    uint32 count = 0;
+    for (const auto& window : windows)
+    {
+        if (delta < window.size() && window[static_cast<size_t>(delta)] == byte)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool DiffEngine::FindFirstDifference(const std::vector<DataCache*>& caches, const std::vector<uint64>& starts, uint64& delta)
+{
+    CHECK(caches.size() == starts.size() && caches.size() > 1, false, "");
+
+    uint64 readSize = GView::Utils::INVALID_OFFSET;
+    for (const auto cache : caches)
+    {
+        readSize = std::min<uint64>(readSize, cache->GetCacheSize());
+    }
+    CHECK(readSize > 0, false, "");
+
+    // every object has its own cache => the buffers read from them stay valid together
+    std::vector<const uint8*> buffers(caches.size());
+    delta = 0;
+    while (true)
+    {
+        uint64 available = readSize;
+        for (size_t i = 0; i < caches.size(); i++)
+        {
+            const auto buffer = caches[i]->Get(starts[i] + delta, static_cast<uint32>(readSize), false);
+            if (!buffer.IsValid() || buffer.GetLength() == 0)
+            {
+                return true;
+            }
+            buffers[i] = buffer.GetData();
+            available  = std::min<uint64>(available, buffer.GetLength());
+        }
+
+        const uint64 first = FindFirstMismatch(buffers, available);
+        delta += first;
+        if (first < available)
+        {
+            return true;
+        }
+    }
+}
+
+bool DiffEngine::FindFirstDifferentByte(DataCache& cache, uint64 start, uint8 value, uint64& offset)
+{
+    std::array<uint8, COMPARE_CHUNK_SIZE> pattern;
+    pattern.fill(value);
+
+    offset = start;
+    while (true)
+    {
+        const auto buffer = cache.Get(offset, cache.GetCacheSize(), false);
+        if (!buffer.IsValid() || buffer.GetLength() == 0)
+        {
+            return false;
+        }
+
+        const auto data   = buffer.GetData();
+        const uint64 size = buffer.GetLength();
+        uint64 i          = 0;
+        while (i + COMPARE_CHUNK_SIZE <= size && memcmp(data + i, pattern.data(), COMPARE_CHUNK_SIZE) == 0)
+        {
+            i += COMPARE_CHUNK_SIZE;
+        }
+        for (; i < size; i++)
+        {
+            if (data[i] != value)
+            {
+                offset += i;
+                return true;
+            }
+        }
+        offset += size;
+    }
+}
+} // namespace GView::GenericPlugins::SyncCompare
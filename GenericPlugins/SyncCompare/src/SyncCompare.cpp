@@ -1,6 +1,5 @@
 #include "SyncCompare.hpp"
 
-#include <unordered_map>
 #include <vector>
 
 using namespace AppCUI;
@@ -230,47 +229,85 @@ void Plugin::ArrangeFilteredWindows(const std::string_view& filterName)
     }
 }
 
-bool Plugin::GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp)
+bool Plugin::MoveViewsToAlignedOffset(uint32 objectIndex, uint64 offset)
 {
     auto desktop         = AppCUI::Application::GetDesktop();
     const auto windowsNo = desktop->GetChildrenCount();
-    CHECK(windowsNo > 1, false, "");
+    CHECK(windowsNo == contentAlignment.GetObjectsCount(), false, "");
 
-    std::unordered_map<unsigned char, uint32> bytes;
+    for (uint32 i = 0; i < windowsNo; i++)
+    {
+        auto window    = desktop->GetChild(i);
+        auto interface = window.ToObjectRef<GView::View::WindowInterface>();
+        auto view      = interface->GetCurrentView();
 
-    CHECK(vd.viewStartOffset <= offset, false, "");
-    const auto deltaOffset = offset - vd.viewStartOffset;
+        const auto viewOffset = contentAlignment.MapOffset(objectIndex, offset, i);
+
+        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, View::VIEW_COMMAND_DEACTIVATE_SYNC);
+
+        view->GoTo(viewOffset); // moves the cursor
+        view->GoTo(viewOffset); // moves the start view
+
+        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, sync->IsChecked() ? View::VIEW_COMMAND_ACTIVATE_SYNC : View::VIEW_COMMAND_DEACTIVATE_SYNC);
+    }
+
+    return true;
+}
+
+bool Plugin::UpdateVisibleDifferences()
+{
+    auto desktop         = AppCUI::Application::GetDesktop();
+    const auto windowsNo = desktop->GetChildrenCount();
+    CHECK(windowsNo > 1, false, "");
+
+    std::vector<DataCache*> caches;
+    std::vector<uint64> starts;
+    caches.reserve(windowsNo);
+    starts.reserve(windowsNo);
+    uint64 length = 0;
 
     for (uint32 i = 0; i < windowsNo; i++)
     {
         auto window    = desktop->GetChild(i);
         auto interface = window.ToObjectRef<GView::View::WindowInterface>();
-        auto& data     = interface->GetObject()->GetData();
 
         ViewData viewData{}; // we assume that current view is what we want (buffer view)
         CHECK(interface->GetCurrentView()->GetViewData(viewData, GView::Utils::INVALID_OFFSET), false, "");
 
-        uint64 thisOffset = viewData.viewStartOffset + deltaOffset;
-        const auto buffer = data.Get(thisOffset, 1, true);
-        if (buffer.IsValid())
-        {
-            ++bytes[buffer.GetData()[0]];
-        }
+        caches.push_back(&interface->GetObject()->GetData());
+        starts.push_back(viewData.viewStartOffset);
+        length = std::max<uint64>(length, viewData.viewSize);
+    }
+
+    if (visibleDifferences.IsComputedFor(starts, length))
+    {
+        return true;
+    }
+    return visibleDifferences.Compare(caches, starts, length);
+}
+
+bool Plugin::GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp)
+{
+    CHECK(vd.viewStartOffset <= offset, false, "");
+    const auto deltaOffset = offset - vd.viewStartOffset;
+
+    // painting a view starts with its first byte => only then the windows are compared again (if any of them moved)
+    if (deltaOffset == 0 || deltaOffset >= visibleDifferences.GetLength())
+    {
+        CHECK(UpdateVisibleDifferences(), false, "");
     }
+    CHECK(deltaOffset < visibleDifferences.GetLength(), false, "");
 
-    if (bytes.size() == 1 && bytes.at(vd.byte) == windowsNo)
+    if (visibleDifferences.IsDifferent(deltaOffset) == false)
     {
         cp = MATCH_COMPLETE;
         return true;
     }
 
-    if (bytes.size() < windowsNo)
+    if (visibleDifferences.CountMatches(deltaOffset, vd.byte) >= 2)
     {
-        if (bytes.at(vd.byte) >= 2)
-        {
-            cp = MATCH_PARTIAL;
-            return true;
-        }
+        cp = MATCH_PARTIAL;
+        return true;
     }
 
     return false;
@@ -284,6 +321,38 @@ bool Plugin::GenerateActionOnMove(Reference<Control> sender, int64 deltaStartVie
     const auto windowsNo = desktop->GetChildrenCount();
     CHECK(windowsNo > 1, false, "");
 
+    if (contentAlignment.GetObjectsCount() == windowsNo)
+    {
+        // the other views are moved to the content shown by the sender
+        uint32 senderIndex = windowsNo;
+        for (uint32 i = 0; i < windowsNo && senderIndex == windowsNo; i++)
+        {
+            auto interface = desktop->GetChild(i).ToObjectRef<GView::View::WindowInterface>();
+            if (interface->GetCurrentView().ToObjectRef<Control>() == sender)
+            {
+                senderIndex = i;
+            }
+        }
+        CHECK(senderIndex < windowsNo, false, "");
+
+        for (uint32 i = 0; i < windowsNo; i++)
+        {
+            auto interface = desktop->GetChild(i).ToObjectRef<GView::View::WindowInterface>();
+            auto view      = interface->GetCurrentView();
+            if (i == senderIndex)
+            {
+                continue;
+            }
+
+            ViewData viewData{};
+            CHECK(view->GetViewData(viewData, GView::Utils::INVALID_OFFSET), false, "");
+            const auto viewOffset = contentAlignment.MapOffset(senderIndex, vd.viewStartOffset, i);
+            view->AdvanceStartView(static_cast<int64>(viewOffset) - static_cast<int64>(viewData.viewStartOffset));
+        }
+
+        return true;
+    }
+
     for (uint32 i = 0; i < windowsNo; i++)
     {
         auto window    = desktop->GetChild(i);
@@ -370,75 +439,92 @@ bool Plugin::FindNextDifference()
         }
     }
 
-    uint64 bufferSize{ GView::Utils::INVALID_OFFSET };
+    std::vector<uint64> starts;
+    starts.reserve(viewsData.size());
     for (const auto& data : viewsData)
     {
-        if (data.viewSize > 0)
-        {
-            bufferSize = std::min<uint64>(bufferSize, data.viewSize);
-        }
+        starts.push_back(data.viewStartOffset);
     }
-    CHECK(bufferSize != GView::Utils::INVALID_OFFSET, false, "");
 
-    bool differenceNotFound{ true };
-    do
+    uint64 delta = 0;
+    CHECK(DiffEngine::FindFirstDifference(caches, starts, delta), false, "");
+    for (auto& data : viewsData)
     {
-        std::vector<BufferView> buffers;
-        buffers.reserve(windowsNo);
+        data.viewStartOffset += delta;
+    }
 
-        for (uint32 i = 0; i < windowsNo; i++)
-        {
-            auto& view             = views.at(i);
-            auto& data             = viewsData.at(i);
-            auto& cache            = caches.at(i);
-            buffers.emplace_back() = cache->Get(data.viewStartOffset, static_cast<uint32>(bufferSize), false);
-        }
+    for (uint32 i = 0; i < views.size(); i++)
+    {
+        auto& view = views.at(i);
 
-        uint32 i = 0;
-        std::vector<char> bytes;
-        bytes.reserve(windowsNo);
-        for (; i < bufferSize; i++)
-        {
-            for (const auto& buffer : buffers)
-            {
-                if (buffer.GetLength() <= i)
-                {
-                    differenceNotFound = false;
-                    break;
-                }
+        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, View::VIEW_COMMAND_DEACTIVATE_SYNC);
 
-                bytes.push_back(buffer.GetData()[i]);
-            }
+        view->GoTo(viewsData.at(i).viewStartOffset); // moves the cursor
+        view->GoTo(viewsData.at(i).viewStartOffset); // moves the start view
 
-            if (bytes.empty() || std::equal(bytes.begin() + 1, bytes.end(), bytes.begin()) == false)
-            {
-                differenceNotFound = false;
-                break;
-            }
+        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, sync->IsChecked() ? View::VIEW_COMMAND_ACTIVATE_SYNC : View::VIEW_COMMAND_DEACTIVATE_SYNC);
+    }
 
-            bytes.clear();
-        }
+    return true;
+}
 
-        for (auto& data : viewsData)
-        {
-            data.viewStartOffset += i;
-        }
+bool Plugin::ToggleContentAlignment()
+{
+    if (contentAlignment.GetObjectsCount() > 0)
+    {
+        contentAlignment.Clear();
+        return true;
+    }
 
-    } while (differenceNotFound);
+    auto desktop         = AppCUI::Application::GetDesktop();
+    const auto windowsNo = desktop->GetChildrenCount();
+    CHECK(windowsNo > 1, false, "");
 
+    std::vector<DataCache*> caches;
+    caches.reserve(windowsNo);
+    uint64 totalSize = 0;
     for (uint32 i = 0; i < windowsNo; i++)
     {
-        auto& view = views.at(i);
+        auto interface = desktop->GetChild(i).ToObjectRef<GView::View::WindowInterface>();
+        CHECK(interface->GetCurrentView()->GetName() == VIEW_NAME, false, "");
 
-        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, View::VIEW_COMMAND_DEACTIVATE_SYNC);
+        auto& cache = interface->GetObject()->GetData();
+        caches.push_back(&cache);
+        totalSize += cache.GetSize();
+    }
 
-        view->GoTo(viewsData.at(i).viewStartOffset); // moves the cursor
-        view->GoTo(viewsData.at(i).viewStartOffset); // moves the start view
+    LocalString<128> ls;
+    ProgressStatus::Init("Aligning content...", totalSize);
+    const auto onProgress = [&](uint64 processed) { return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] bytes", processed, totalSize)); };
+    CHECK(contentAlignment.Compute(caches, onProgress), false, "");
 
-        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, sync->IsChecked() ? View::VIEW_COMMAND_ACTIVATE_SYNC : View::VIEW_COMMAND_DEACTIVATE_SYNC);
+    if (sync->IsChecked() == false)
+    {
+        ToggleSync();
     }
 
-    return true;
+    // the views start from the content shown by the reference view unless a region is chosen
+    ViewData vd{};
+    CHECK(desktop->GetChild(0).ToObjectRef<GView::View::WindowInterface>()->GetCurrentView()->GetViewData(vd, GView::Utils::INVALID_OFFSET), false, "");
+    uint32 objectIndex = 0;
+    uint64 offset      = vd.viewStartOffset;
+
+    AlignedRegionsWindow regionsWindow(contentAlignment);
+    AlignedRegion region{};
+    if (regionsWindow.Show() == Dialogs::Result::Ok && regionsWindow.GetSelectedRegion(objectIndex, region))
+    {
+        if (region.type == RegionType::Deleted) // it exists only in the reference object
+        {
+            objectIndex = 0;
+            offset      = region.referenceOffset;
+        }
+        else
+        {
+            offset = region.offset;
+        }
+    }
+
+    return MoveViewsToAlignedOffset(objectIndex, offset);
 }
 
 bool Plugin::FindNextDifferentCharacter()
@@ -466,30 +552,86 @@ bool Plugin::FindNextDifferentCharacter()
             const auto bvc = dc.Get(vd.cursorStartOffset, 1, true);
             CHECK(bvc.IsValid(), false, "");
             const auto initial = bvc.GetData()[0];
-            vd.cursorStartOffset += 1;
 
-            while (true)
+            uint64 offset = 0;
+            if (DiffEngine::FindFirstDifferentByte(dc, vd.cursorStartOffset + 1, initial, offset))
             {
-                const auto bf = dc.Get(vd.cursorStartOffset, dc.GetCacheSize(), false);
-                for (uint64 i = 0; i < bf.GetLength(); i++)
-                {
-                    const auto c = bf.GetData()[i];
-                    if (c != initial)
-                    {
-                        view->GoTo(vd.cursorStartOffset + i); // moves the cursor
-                        return true;
-                    }
-                }
-                if (bf.IsValid() == false || bf.GetLength() == 0)
-                {
-                    break;
-                }
+                view->GoTo(offset); // moves the cursor
+                return true;
             }
         }
     }
 
     return true;
 }
+
+AlignedRegionsWindow::AlignedRegionsWindow(const ContentAlignment& alignment)
+    : Window("Aligned regions", "d:c,w:120,h:30", WindowFlags::ProcessReturn | WindowFlags::Sizeable)
+{
+    list = Factory::ListView::Create(
+          this,
+          "x:1,y:1,w:99%,h:90%",
+          { "n:Object,w:10%", "n:Type,w:14%", "n:Reference offset,w:19%", "n:Reference size,w:19%", "n:Offset,w:19%", "n:Size,w:19%" },
+          ListViewFlags::None);
+    list->Handlers()->OnItemPressed = this;
+
+    Factory::Button::Create(this, "&Close", "x:50%,y:100%,a:b,w:12", BTN_ID_CANCEL);
+
+    for (uint32 i = 1; i < alignment.GetObjectsCount(); i++)
+    {
+        for (const auto& region : alignment.GetRegions(i))
+        {
+            std::string_view type = "Aligned";
+            if (region.type == RegionType::Deleted)
+            {
+                type = "Deleted";
+            }
+            else if (region.type == RegionType::Inserted)
+            {
+                type = "Inserted";
+            }
+
+            LocalString<32> object;
+            LocalString<32> referenceOffset;
+            LocalString<32> referenceSize;
+            LocalString<32> offset;
+            LocalString<32> size;
+            auto item = list->AddItem({ object.Format("#%u", i),
+                                        type,
+                                        referenceOffset.Format("0x%llX", region.referenceOffset),
+                                        referenceSize.Format("%llu", region.referenceSize),
+                                        offset.Format("0x%llX", region.offset),
+                                        size.Format("%llu", region.size) });
+            item.SetData(regions.size());
+            regions.emplace_back(i, region);
+        }
+    }
+    list->SetFocus();
+}
+
+bool AlignedRegionsWindow::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if ((eventType == Event::ButtonClicked && ID == BTN_ID_CANCEL) || eventType == Event::WindowClose)
+    {
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+    return Window::OnEvent(control, eventType, ID);
+}
+
+void AlignedRegionsWindow::OnListViewItemPressed(Reference<ListView> lv, ListViewItem item)
+{
+    selected = item.GetData(GView::Utils::INVALID_OFFSET);
+    Exit(Dialogs::Result::Ok);
+}
+
+bool AlignedRegionsWindow::GetSelectedRegion(uint32& objectIndex, AlignedRegion& region) const
+{
+    CHECK(selected < regions.size(), false, "");
+    objectIndex = regions[selected].first;
+    region      = regions[selected].second;
+    return true;
+}
 } // namespace GView::GenericPlugins::SyncCompare
 
 // you're passing the callbacks - this needs to be statically allocated
@@ -527,6 +669,15 @@ extern "C"
             plugin->FindNextDifference();
             return true;
         }
+        if (command == "AlignContent")
+        {
+            if (plugin == nullptr)
+            {
+                plugin.reset(new GView::GenericPlugins::SyncCompare::Plugin());
+            }
+            plugin->ToggleContentAlignment();
+            return true;
+        }
         if (command == "FindNextDC")
         {
             GView::GenericPlugins::SyncCompare::Plugin::FindNextDifferentCharacter();
@@ -541,5 +692,6 @@ extern "C"
         sect["Command.ToggleSync"]         = Input::Key::Shift | Input::Key::Space;
         sect["Command.FindNextDifference"] = Input::Key::Shift | Input::Key::F11;
         sect["Command.FindNextDC"]         = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F11;
+        sect["Command.AlignContent"]       = Input::Key::Alt | Input::Key::Shift | Input::Key::F11;
     }
 }
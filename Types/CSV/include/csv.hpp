@@ -2,6 +2,10 @@
 
 #include "GView.hpp"
 
+#include <array>
+#include <string>
+#include <vector>
+
 namespace GView
 {
 namespace Type
@@ -16,6 +20,40 @@ namespace Type
             };
         };
 
+        enum class ColumnType : uint8
+        {
+            Empty,
+            Integer,
+            Float,
+            Text
+        };
+
+        // Statistics of the values of a column (a quoted value is used without its quotes, an empty value is a null)
+        struct ColumnStatistics
+        {
+            static constexpr uint32 DISTINCT_REGISTERS_BITS = 10;
+
+            uint64 values{ 0 }; // not empty
+            uint64 nulls{ 0 };
+            uint64 integers{ 0 };
+            uint64 numbers{ 0 }; // integers and floats
+            double min{ 0.0 };
+            double max{ 0.0 };
+            double sum{ 0.0 };
+            std::array<uint8, 1 << DISTINCT_REGISTERS_BITS> distinct{}; // HyperLogLog registers
+
+            // truncated => only the start of a long value is given (it is not a number)
+            void Add(std::string_view value, bool truncated);
+            void Merge(const ColumnStatistics& other);
+
+            ColumnType GetType() const;
+            double GetMean() const
+            {
+                return numbers > 0 ? sum / numbers : 0.0;
+            }
+            uint64 GetDistinctEstimate() const;
+        };
+
         class CSVFile : public TypeInterface
         {
           private:
@@ -24,6 +62,10 @@ namespace Type
             unsigned int rowsNo{ 0 };
             char separator[2]{""};
 
+            std::vector<ColumnStatistics> columns;
+            std::vector<std::string> columnNames; // empty if the first row is not a header
+            GView::DelimitedText::Index index;    // built with the statistics, then given to the grid viewer
+
             uint64_t panelsMask{ 0 };
 
           public:
@@ -46,6 +88,30 @@ namespace Type
             bool HasPanel(Panels::IDs id);
             void UpdateBufferViewZones(GView::View::BufferViewer::Settings& settings);
             void UpdateGrid(GView::View::GridViewer::Settings& settings);
+            // indexes the rows, then their ranges are processed in parallel; the first row is a header if it is text over numeric columns
+            bool ComputeColumnStatistics();
+
+            const std::vector<ColumnStatistics>& GetColumnStatistics() const
+            {
+                return columns;
+            }
+            const std::vector<std::string>& GetColumnNames() const
+            {
+                return columnNames;
+            }
+            bool HasHeader() const
+            {
+                return hasHeader;
+            }
+            // every row of the grid (including the header and the empty lines)
+            unsigned int GetRowsCount() const
+            {
+                return rowsNo;
+            }
+            unsigned int GetColumnsCount() const
+            {
+                return columnsNo;
+            }
 
           public:
             Reference<GView::Utils::SelectionZoneInterface> selectionZoneInterface;
@@ -75,6 +141,7 @@ namespace Type
               private:
                 Reference<GView::Type::CSV::CSVFile> csv;
                 Reference<AppCUI::Controls::ListView> general;
+                Reference<AppCUI::Controls::ListView> columns;
 
               public:
                 Information(Reference<GView::Type::CSV::CSVFile> csv);
@@ -84,6 +151,7 @@ namespace Type
 
               private:
                 void UpdateGeneralInformation();
+                void UpdateColumnsInformation();
                 void RecomputePanelsPositions();
             };
         }; // namespace Panels
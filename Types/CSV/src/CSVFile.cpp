@@ -95,6 +95,10 @@ void GView::Type::CSV::CSVFile::UpdateBufferViewZones(GView::View::BufferViewer:
 void GView::Type::CSV::CSVFile::UpdateGrid(GView::View::GridViewer::Settings& settings)
 {
     settings.SetSeparator(separator);
+    if (index.GetRowsCount() > 0)
+    {
+        settings.SetIndex(std::move(index));
+    }
 }
 
 GView::Utils::JsonBuilderInterface* CSVFile::GetSmartAssistantContext(const std::string_view& prompt, std::string_view displayPrompt)
@@ -0,0 +1,272 @@
+#include "csv.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+
+using namespace GView::Type::CSV;
+
+constexpr uint32 STATISTICS_ROWS_PER_TASK = 16 * 1024;
+constexpr uint64 MAX_FIELD_SIZE           = 256; // longer values are text, only their start is used
+constexpr uint64 FNV_OFFSET_BASIS         = 0xCBF29CE484222325ULL;
+constexpr uint64 FNV_PRIME                = 0x00000100000001B3ULL;
+
+static uint64 HashValue(std::string_view value)
+{
+    uint64 hash = FNV_OFFSET_BASIS;
+    for (const auto c : value)
+    {
+        hash = (hash ^ static_cast<uint8>(c)) * FNV_PRIME;
+    }
+    // FNV mixes the high bits poorly => a final avalanche before they are used as a register index
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+void ColumnStatistics::Add(std::string_view value, bool truncated)
+{
+    value = GView::DelimitedText::TrimValue(value);
+    if (value.empty() && !truncated)
+    {
+        nulls++;
+        return;
+    }
+    values++;
+
+    const uint64 hash  = HashValue(value);
+    const uint32 index = static_cast<uint32>(hash >> (64 - DISTINCT_REGISTERS_BITS));
+    const uint8 rank   = static_cast<uint8>(std::countl_zero((hash << DISTINCT_REGISTERS_BITS) | (1ULL << (DISTINCT_REGISTERS_BITS - 1))) + 1);
+    distinct[index]    = std::max<uint8>(distinct[index], rank);
+    if (truncated)
+    {
+        return;
+    }
+
+    // only the integer overload of from_chars is portable, the other numbers are parsed by the helper shared with the grid viewer
+    double number       = 0.0;
+    int64 integer       = 0;
+    const auto valueEnd = value.data() + value.size();
+    if (auto result = std::from_chars(value.data(), valueEnd, integer); result.ec == std::errc() && result.ptr == valueEnd)
+    {
+        integers++;
+        number = static_cast<double>(integer);
+    }
+    else if (!GView::DelimitedText::ParseNumber(value, number))
+    {
+        return;
+    }
+
+    min = numbers == 0 ? number : std::min<double>(min, number);
+    max = numbers == 0 ? number : std::max<double>(max, number);
+    sum += number;
+    numbers++;
+}
+
+void ColumnStatistics::Merge(const ColumnStatistics& other)
+{
+    if (other.numbers > 0)
+    {
+        min = numbers == 0 ? other.min : std::min<double>(min, other.min);
+        max = numbers == 0 ? other.max : std::max<double>(max, other.max);
+    }
+    values += other.values;
+    nulls += other.nulls;
+    integers += other.integers;
+    numbers += other.numbers;
+    sum += other.sum;
+    for (uint32 i = 0; i < distinct.size(); i++)
+    {
+        distinct[i] = std::max<uint8>(distinct[i], other.distinct[i]);
+    }
+}
+
+ColumnType ColumnStatistics::GetType() const
+{
+    if (values == 0)
+    {
+        return ColumnType::Empty;
+    }
+    if (integers == values)
+    {
+        return ColumnType::Integer;
+    }
+    return numbers == values ? ColumnType::Float : ColumnType::Text;
+}
+
+uint64 ColumnStatistics::GetDistinctEstimate() const
+{
+    const double registers = static_cast<double>(distinct.size());
+    double sum             = 0.0;
+    uint32 zeros           = 0;
+    for (const auto rank : distinct)
+    {
+        sum += std::ldexp(1.0, -rank);
+        zeros += rank == 0;
+    }
+
+    double estimate = (0.7213 / (1.0 + 1.079 / registers)) * registers * registers / sum;
+    if (estimate <= 2.5 * registers && zeros > 0)
+    {
+        estimate = registers * std::log(registers / zeros); // small cardinalities => linear counting
+    }
+    return std::min<uint64>(static_cast<uint64>(std::llround(estimate)), values);
+}
+
+// adds the fields of a row to the statistics of their columns
+static void AddRow(
+      GView::Utils::DataCache& cache,
+      const GView::DelimitedText::Index& index,
+      uint64 row,
+      std::vector<ColumnStatistics>& columns,
+      std::vector<std::string>* values = nullptr)
+{
+    uint64 start = 0;
+    uint64 end   = 0;
+    // an empty line is a row of the grid, but it has no values
+    if (!index.GetRow(row, start, end) || start == end)
+    {
+        return;
+    }
+
+    const uint32 fieldsCount = index.GetFieldsCount(row);
+    if (columns.size() < fieldsCount)
+    {
+        columns.resize(fieldsCount);
+    }
+    std::string field; // a value that is not in the cache at once
+    for (uint32 i = 0; i < fieldsCount; i++)
+    {
+        index.GetField(row, i, start, end);
+        const auto size   = static_cast<uint32>(std::min<uint64>(end - start, MAX_FIELD_SIZE));
+        const auto buffer = cache.Get(start, size, false);
+        std::string_view value{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+        if (value.size() < size)
+        {
+            field.assign(value);
+            while (field.size() < size)
+            {
+                const auto next = cache.Get(start + field.size(), size - static_cast<uint32>(field.size()), false);
+                if (next.GetLength() == 0)
+                {
+                    break;
+                }
+                field.append(reinterpret_cast<const char*>(next.GetData()), next.GetLength());
+            }
+            value = field;
+        }
+        columns[i].Add(value, value.size() < end - start);
+        if (values != nullptr)
+        {
+            values->emplace_back(GView::DelimitedText::TrimValue(value));
+        }
+    }
+}
+
+bool GView::Type::CSV::CSVFile::ComputeColumnStatistics()
+{
+    columns.clear();
+    columnNames.clear();
+    hasHeader = false;
+    rowsNo    = 0;
+    columnsNo = 0;
+
+    // the same index is given to the grid viewer => the object is parsed only once
+    auto& cache       = obj->GetData();
+    const uint64 size = cache.GetSize();
+    LocalString<128> ls;
+    ProgressStatus::Init("Indexing rows...", size);
+    const auto onIndexProgress = [&](uint64 processed) { return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] bytes", processed, size)); };
+    if (!index.Build(cache, separator, onIndexProgress))
+    {
+        index.Clear();
+        return false;
+    }
+
+    const uint64 rows = index.GetRowsCount();
+    rowsNo            = static_cast<unsigned int>(std::min<uint64>(rows, UINT32_MAX));
+    CHECK(rows > 0, true, "");
+
+    // the first row is kept apart until it is known if it is a header
+    std::vector<ColumnStatistics> firstRow;
+    std::vector<std::string> firstRowValues;
+    AddRow(cache, index, 0, firstRow, &firstRowValues);
+
+    // the other rows are split in ranges, every worker adds its ranges to its own statistics through its own view of the cache
+    const uint64 tasksCount = (rows - 1 + STATISTICS_ROWS_PER_TASK - 1) / STATISTICS_ROWS_PER_TASK;
+    CHECK(tasksCount <= UINT32_MAX, false, "");
+    const auto workersCount = std::max<uint32>(1, std::min<uint32>(GView::Utils::GetWorkersCount(), static_cast<uint32>(tasksCount)));
+    std::vector<GView::Utils::DataCache> views(workersCount);
+    for (auto& view : views)
+    {
+        CHECK(view.InitView(cache), false, "");
+    }
+    std::vector<std::vector<ColumnStatistics>> workersColumns(workersCount);
+
+    ProgressStatus::Init("Computing column statistics...", rows);
+    std::atomic<uint64> rowsProcessed{ 0 };
+    CHECK(GView::Utils::ParallelFor(
+                static_cast<uint32>(tasksCount),
+                [&](uint32 task, uint32 workerIndex) {
+                    const uint64 start = 1 + static_cast<uint64>(task) * STATISTICS_ROWS_PER_TASK;
+                    const uint64 end   = std::min<uint64>(start + STATISTICS_ROWS_PER_TASK, rows);
+                    for (uint64 row = start; row < end; row++)
+                    {
+                        AddRow(views[workerIndex], index, row, workersColumns[workerIndex]);
+                    }
+                    rowsProcessed.fetch_add(end - start, std::memory_order_relaxed);
+                },
+                [&]() {
+                    const auto processed = rowsProcessed.load(std::memory_order_relaxed);
+                    return !ProgressStatus::Update(processed, ls.Format("[%llu/%llu] rows", processed, rows));
+                }),
+          false,
+          "");
+
+    for (const auto& workerColumns : workersColumns)
+    {
+        if (columns.size() < workerColumns.size())
+        {
+            columns.resize(workerColumns.size());
+        }
+        for (size_t i = 0; i < workerColumns.size(); i++)
+        {
+            columns[i].Merge(workerColumns[i]);
+        }
+    }
+
+    // the first row is a header if it has no numbers and it has text over a numeric column
+    bool textOverNumbers = false;
+    bool hasNumbers      = false;
+    for (size_t i = 0; i < firstRow.size(); i++)
+    {
+        hasNumbers |= firstRow[i].numbers > 0;
+        if (i < columns.size() && firstRow[i].GetType() == ColumnType::Text)
+        {
+            const auto type = columns[i].GetType();
+            textOverNumbers |= type == ColumnType::Integer || type == ColumnType::Float;
+        }
+    }
+
+    hasHeader = textOverNumbers && !hasNumbers;
+    if (hasHeader)
+    {
+        columnNames = std::move(firstRowValues);
+    }
+    else
+    {
+        if (columns.size() < firstRow.size())
+        {
+            columns.resize(firstRow.size());
+        }
+        for (size_t i = 0; i < firstRow.size(); i++)
+        {
+            columns[i].Merge(firstRow[i]);
+        }
+    }
+
+    columnsNo = static_cast<unsigned int>(std::max<size_t>(columns.size(), columnNames.size()));
+    return true;
+}
@@ -8,6 +8,11 @@ Information::Information(Reference<GView::Type::CSV::CSVFile> csv) : TabPage("In
 {
     this->csv = csv;
     general   = Factory::ListView::Create(this, "x:0,y:0,w:100%,h:10", { "n:Field,w:12", "n:Value,w:100" }, ListViewFlags::None);
+    columns   = Factory::ListView::Create(
+          this,
+          "x:0,y:10,w:100%,h:10",
+          { "n:Column,w:20", "n:Type,w:10", "n:Nulls,a:r,w:12", "n:Distinct,a:r,w:12", "n:Min,a:r,w:16", "n:Max,a:r,w:16", "n:Mean,a:r,w:16" },
+          ListViewFlags::None);
 
     this->Update();
 }
@@ -20,6 +25,7 @@ void Information::OnAfterResize(int newWidth, int newHeight)
 void Information::Update()
 {
     UpdateGeneralInformation();
+    UpdateColumnsInformation();
     RecomputePanelsPositions();
 }
 
@@ -32,6 +38,47 @@ void Information::UpdateGeneralInformation()
     general->AddItem({ "Filename", csv->obj->GetName() });
     general->AddItem(
           { "Size", ls.Format("%s bytes", nf.ToString(csv->obj->GetData().GetSize(), { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    general->AddItem({ "Rows", ls.Format("%s", nf.ToString(csv->GetRowsCount(), { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    general->AddItem({ "Columns", ls.Format("%u", csv->GetColumnsCount()) });
+    general->AddItem({ "Header", csv->HasHeader() ? "Yes" : "No" });
+}
+
+void Information::UpdateColumnsInformation()
+{
+    columns->DeleteAllItems();
+
+    static const std::string_view typeNames[] = { "Empty", "Integer", "Float", "Text" };
+
+    LocalString<64> name;
+    LocalString<64> nulls;
+    LocalString<64> distinct;
+    LocalString<64> min;
+    LocalString<64> max;
+    LocalString<64> mean;
+    const auto& statistics = csv->GetColumnStatistics();
+    const auto& names      = csv->GetColumnNames();
+    for (size_t i = 0; i < statistics.size(); i++)
+    {
+        const auto& column = statistics[i];
+        const auto type    = column.GetType();
+        const bool numeric = type == ColumnType::Integer || type == ColumnType::Float;
+        if (i < names.size() && !names[i].empty())
+        {
+            name.Set(names[i]);
+        }
+        else
+        {
+            name.Format("#%zu", i);
+        }
+
+        columns->AddItem({ name.ToStringView(),
+                           typeNames[static_cast<uint8>(type)],
+                           nulls.Format("%llu", column.nulls),
+                           distinct.Format("~%llu", column.GetDistinctEstimate()),
+                           numeric ? min.Format("%g", column.min) : "",
+                           numeric ? max.Format("%g", column.max) : "",
+                           numeric ? mean.Format("%g", column.GetMean()) : "" });
+    }
 }
 
 void Information::RecomputePanelsPositions()
@@ -47,6 +94,12 @@ void Information::RecomputePanelsPositions()
             this->general->Resize(this->GetWidth(), this->general->GetItemsCount() + 3);
         }
     }
+    if (this->columns != nullptr && this->general != nullptr)
+    {
+        const int top = this->general->GetHeight();
+        this->columns->MoveTo(0, top);
+        this->columns->Resize(this->GetWidth(), std::max<int>(this->GetHeight() - top, 3));
+    }
 }
 
 } // namespace GView::Type::CSV::Panels
\ No newline at end of file
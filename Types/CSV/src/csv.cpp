@@ -45,6 +45,7 @@ extern "C"
     {
         auto csv = win->GetObject()->GetContentType<CSV::CSVFile>();
         csv->Update(win->GetObject());
+        csv->ComputeColumnStatistics();
 
         GView::View::GridViewer::Settings gridSettings;
         csv->UpdateGrid(gridSettings);
@@ -11,6 +11,8 @@ class ConstFolder : public AST::Plugin
     virtual AST::Action OnExitMemberAccess(AST::MemberAccess* node, AST::Expr*& replacement) override;
     virtual AST::Action OnExitCall(AST::Call* node, AST::Expr*& replacement);
 
+    virtual bool IsSubtreeLocal() override;
+
   private:
     AST::Expr* Fold(AST::Number* left, AST::Number* right, uint32 op);
     AST::Expr* Fold(AST::Number* left, AST::String* right, uint32 op);
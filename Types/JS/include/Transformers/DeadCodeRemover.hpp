@@ -27,5 +27,7 @@ class DeadCodeRemover : public AST::Plugin
     AST::Action OnExitIfStmt(AST::IfStmt* node, AST::Stmt*& replacement);
     AST::Action OnExitWhileStmt(AST::WhileStmt* node, AST::Stmt*& replacement);
     AST::Action OnExitReturnStmt(AST::ReturnStmt* node, AST::Stmt*& replacement);
+
+    bool IsSubtreeLocal() override;
 };
 }
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include "js.hpp"
 
+#include <cstddef>
 #include <fstream>
+#include <memory>
 
 namespace GView
 {
@@ -143,6 +145,10 @@ namespace Type
                 virtual Action OnExitNumber(Number* node, Expr*& replacement);
                 virtual Action OnExitString(AST::String* node, Expr*& replacement);
                 virtual Action OnExitBool(Bool* node, Expr*& replacement);
+
+                // true if the result of the plugin on a subtree only depends on that subtree (and on the current state of the
+                // plugin) - a subtree that was visited without changes can then be skipped until something inside it changes
+                virtual bool IsSubtreeLocal();
             };
 
             class PluginVisitor : public Visitor
@@ -151,10 +157,11 @@ namespace Type
                 Plugin* plugin;
                 TextEditor* editor;
                 int32 tokenOffset;
+                uint32 passMask; // bit used to mark the subtrees that were left unchanged by a local plugin (0 - no tracking)
 
                 bool dirty;
 
-                PluginVisitor(Plugin* plugin, TextEditor* editor);
+                PluginVisitor(Plugin* plugin, TextEditor* editor, uint32 passMask = 0);
 
                 virtual Action VisitFunDecl(FunDecl* node, Decl*& replacement) override;
                 virtual Action VisitVarDeclList(VarDeclList* node, Decl*& replacement) override;
@@ -188,6 +195,8 @@ namespace Type
                   void ReplaceNode(Node* parent, Node* child, uint32 oldChildSize, Node* replacement);
                   void RemoveNode(Node* parent, Node* child);
                   void AdjustSize(Node* node, int32 offset);
+                  bool IsSubtreeLocal();
+                  Action MarkUnchanged(Node* node, bool localOnEnter);
             };
 
             class DumpVisitor : public ConstVisitor
@@ -198,6 +207,9 @@ namespace Type
                 DumpVisitor(const char* file);
                 ~DumpVisitor();
 
+                // debugging aid for the plugins - writes the file only if "DumpAST" is enabled in the [Type.JS] settings
+                static void DumpIfEnabled(Block* script, const char* file);
+
                 virtual void VisitFunDecl(const FunDecl* node) override;
                 virtual void VisitVarDeclList(const VarDeclList* node) override;
                 virtual void VisitVarDecl(const VarDecl* node) override;
@@ -274,15 +286,71 @@ namespace Type
                 uint32 GetCurrentOffset();
             }; // namespace AST
 
+            // Nodes of an Instance are carved out of big blocks owned by the instance. Deleting a node only puts its slot on a
+            // per-size free list (reused by the next nodes of that size) and all the blocks are released at once with the instance.
+            // Nodes created while no instance is alive come from the heap.
+            class Arena
+            {
+                static constexpr size_t BLOCK_SIZE      = 64 * 1024;
+                static constexpr size_t ALIGNMENT       = alignof(std::max_align_t);
+                static constexpr size_t MAX_POOLED_SIZE = 512;
+
+                struct FreeSlot {
+                    FreeSlot* next;
+                };
+
+                std::vector<std::unique_ptr<uint8[]>> blocks;
+                uint8* current   = nullptr;
+                size_t remaining = 0;
+                FreeSlot* freeLists[MAX_POOLED_SIZE / ALIGNMENT + 1]{};
+
+              public:
+                struct Statistics {
+                    uint64 allocations = 0; // nodes allocated from the arena
+                    uint64 reused      = 0; // ... out of which were served from the free lists
+                    uint64 released    = 0; // nodes deleted before the arena
+                    uint64 blocks      = 0; // actual heap allocations
+                    uint64 bytes       = 0;
+                };
+
+                Arena()                        = default;
+                Arena(const Arena&)            = delete;
+                Arena& operator=(const Arena&) = delete;
+
+                void* Allocate(size_t size);
+                void Release(void* ptr, size_t size);
+                const Statistics& GetStatistics() const
+                {
+                    return stats;
+                }
+
+                // the arena used by Node::operator new on this thread
+                static Arena* GetCurrent();
+                static void SetCurrent(Arena* arena);
+
+              private:
+                Statistics stats;
+            };
+
             class Instance
             {
+                Arena arena;
+                Arena* previousArena;
+
               public:
-                Block* script;
+                Block* script = nullptr;
 
                 int32 tokenOffset;
 
+                uint64 parseDurationUs = 0;
+
                 void Create(TokensList& tokens);
+                const Arena::Statistics& GetArenaStatistics() const
+                {
+                    return arena.GetStatistics();
+                }
 
+                Instance();
                 ~Instance();
             };
 
@@ -296,6 +364,10 @@ namespace Type
               public:
                 virtual ~Node() = default;
 
+                // allocated from the arena of the current instance (see Arena)
+                static void* operator new(size_t size);
+                static void operator delete(void* ptr, size_t size);
+
                 virtual Action Accept(Visitor& visitor, Node*& replacement) = 0;
                 virtual void AcceptConst(ConstVisitor& visitor) = 0;
 
@@ -303,6 +375,8 @@ namespace Type
                 uint32 sourceSize  = 0;
                 int32 sourceOffset = 0;
 
+                uint32 unchangedPasses = 0; // PluginVisitor::passMask bits of the passes that found nothing to change in this subtree
+
                 void SetSource(Token start, Token end);
                 void SetSourceEnd(Token end);
 
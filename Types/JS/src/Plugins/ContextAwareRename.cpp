@@ -28,10 +28,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest ContextAwareRename::Execute
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
+
+    data.editor.BeginBatch();
 
     Transformer::ContextAwareRenamer renamer;
 
@@ -42,10 +41,7 @@ GView::View::LexicalViewer::PluginAfterActionRequest ContextAwareRename::Execute
     AST::Node* _rep;
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_intermediary.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_intermediary.json");
 
     // Prepare AST for a second visitor
     i.script->AdjustSourceOffset(0);
@@ -57,10 +53,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest ContextAwareRename::Execute
     // TODO: instance should also handle the action for the script block
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
@@ -1,6 +1,9 @@
 #include "js.hpp"
 #include "ast.hpp"
 
+#include <chrono>
+#include <memory>
+
 namespace GView::Type::JS::Plugins
 {
 using namespace GView::View::LexicalViewer;
@@ -21,12 +24,38 @@ bool DumpAST::CanBeAppliedOn(const GView::View::LexicalViewer::PluginData& data)
 
 GView::View::LexicalViewer::PluginAfterActionRequest DumpAST::Execute(GView::View::LexicalViewer::PluginData& data, Reference<Window> parent)
 {
+    // the same tokens are parsed first with every node taken from the heap (no arena) => the two parses can be compared
+    uint64 heapParseDurationUs = 0;
+    {
+        const auto previousArena = AST::Arena::GetCurrent();
+        AST::Arena::SetCurrent(nullptr);
+        const auto parseStart = std::chrono::steady_clock::now();
+        AST::Parser parser(data.tokens, data.tokens.Len());
+        std::unique_ptr<AST::Block> script(parser.ParseBlock());
+        heapParseDurationUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - parseStart).count();
+        script.reset();
+        AST::Arena::SetCurrent(previousArena);
+    }
+
     AST::Instance i;
     i.Create(data.tokens);
 
     AST::DumpVisitor dump("_ast.json");
     i.script->AcceptConst(dump);
 
+    const auto& stats = i.GetArenaStatistics();
+    AppCUI::Utils::LocalString<512> ls;
+    ls.Format(
+          "Heap allocations for %llu nodes: %llu without the arena, %llu with the arena (%llu KB)\nParse time: %llu us without the arena, %llu us "
+          "with the arena",
+          stats.allocations,
+          stats.allocations,
+          stats.blocks,
+          stats.bytes / 1024,
+          heapParseDurationUs,
+          i.parseDurationUs);
+    AppCUI::Dialogs::MessageBox::ShowNotification("AST statistics", ls.ToStringView());
+
     return PluginAfterActionRequest::None;
 }
 } // namespace GView::Type::JS::Plugins
\ No newline at end of file
@@ -806,10 +806,7 @@ GView::View::LexicalViewer::PluginAfterActionRequest Emulate::Execute(GView::Vie
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
 
     // return PluginAfterActionRequest::None;
 
@@ -854,10 +851,7 @@ GView::View::LexicalViewer::PluginAfterActionRequest Emulate::Execute(GView::Vie
 
     AppCUI::Dialogs::MessageBox::ShowNotification(title, value);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
 
     return PluginAfterActionRequest::Rescan;
 }
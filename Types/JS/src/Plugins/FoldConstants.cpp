@@ -25,13 +25,12 @@ GView::View::LexicalViewer::PluginAfterActionRequest FoldConstants::Execute(GVie
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
 
     // return PluginAfterActionRequest::None;
 
+    data.editor.BeginBatch();
+
     Transformer::ConstFolder folder;
     AST::PluginVisitor visitor(&folder, &data.editor);
 
@@ -39,10 +38,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest FoldConstants::Execute(GVie
     AST::Node* _rep;
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
@@ -28,10 +28,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest HoistFunctions::Execute(GVi
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
+
+    data.editor.BeginBatch();
 
     Transformer::FunctionHoister hoister;
 
@@ -58,7 +57,8 @@ GView::View::LexicalViewer::PluginAfterActionRequest HoistFunctions::Execute(GVi
         }
 
         // The destination can overlap with the source
-        std::u16string content = { ((std::u16string_view) data.editor).data() + fun->sourceStart, fun->sourceSize };
+        std::u16string content;
+        data.editor.GetText(fun->sourceStart, fun->sourceSize, content);
 
         data.editor.Insert(dest, content);
         data.editor.Delete(fun->sourceStart + fun->sourceSize, fun->sourceSize);
@@ -68,10 +68,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest HoistFunctions::Execute(GVi
         }
     }
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
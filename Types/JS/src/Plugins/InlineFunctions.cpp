@@ -29,10 +29,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest InlineFunctions::Execute(GV
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
+
+    data.editor.BeginBatch();
 
     Transformer::FunctionInliner inliner;
 
@@ -43,10 +42,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest InlineFunctions::Execute(GV
     AST::Node* _rep;
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
@@ -27,13 +27,12 @@ GView::View::LexicalViewer::PluginAfterActionRequest RemoveDeadCode::Execute(GVi
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
 
     // return PluginAfterActionRequest::None;
 
+    data.editor.BeginBatch();
+
     Transformer::DeadCodeRemover remover;
     AST::PluginVisitor visitor(&remover, &data.editor);
 
@@ -41,10 +40,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest RemoveDeadCode::Execute(GVi
     AST::Node* _rep;
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
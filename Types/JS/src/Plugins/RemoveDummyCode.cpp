@@ -28,10 +28,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest RemoveDummyCode::Execute(GV
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
+
+    data.editor.BeginBatch();
 
     Transformer::DummyCodeRemover remover;
 
@@ -48,10 +47,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest RemoveDummyCode::Execute(GV
 
     i.script->Accept(postVisitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
@@ -26,88 +26,91 @@ bool Simplify::CanBeAppliedOn(const GView::View::LexicalViewer::PluginData& data
     return true;
 }
 
-GView::View::LexicalViewer::PluginAfterActionRequest Simplify::Execute(GView::View::LexicalViewer::PluginData& data, Reference<Window> parent)
-{
-    AST::Instance i;
-    i.Create(data.tokens);
-
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
-
-    bool dirty;
-
-    do {
-        dirty = false;
-
-        {
-            i.script->AdjustSourceOffset(0);
+enum class SimplifyPass : uint32 { FoldConstants = 0, PropagateConstants, RemoveDeadCode, RemoveDummyCode, InlineFunctions, Count };
 
-            Transformer::ConstFolder folder;
-            AST::PluginVisitor visitor(&folder, &data.editor);
-
-            AST::Node* _rep;
-            i.script->Accept(visitor, _rep);
-
-            dirty |= visitor.dirty;
-        }
+// runs one transformation over the whole script, returns true if anything was changed
+static bool RunPass(AST::Instance& i, TextEditor& editor, SimplifyPass pass)
+{
+    const auto passMask = 1u << static_cast<uint32>(pass);
+    AST::Node* _rep;
 
-        {
-            i.script->AdjustSourceOffset(0);
+    i.script->AdjustSourceOffset(0);
 
-            Transformer::ConstPropagator propagator;
-            AST::PluginVisitor visitor(&propagator, &data.editor);
+    switch (pass) {
+    case SimplifyPass::FoldConstants: {
+        Transformer::ConstFolder folder;
+        AST::PluginVisitor visitor(&folder, &editor, passMask);
 
-            AST::Node* _rep;
-            i.script->Accept(visitor, _rep);
+        i.script->Accept(visitor, _rep);
+        return visitor.dirty;
+    }
+    case SimplifyPass::PropagateConstants: {
+        Transformer::ConstPropagator propagator;
+        AST::PluginVisitor visitor(&propagator, &editor, passMask);
 
-            dirty |= visitor.dirty;
-        }
+        i.script->Accept(visitor, _rep);
+        return visitor.dirty;
+    }
+    case SimplifyPass::RemoveDeadCode: {
+        Transformer::DeadCodeRemover remover;
+        AST::PluginVisitor visitor(&remover, &editor, passMask);
 
-        {
-            i.script->AdjustSourceOffset(0);
+        i.script->Accept(visitor, _rep);
+        return visitor.dirty;
+    }
+    case SimplifyPass::RemoveDummyCode: {
+        Transformer::DummyCodeRemover remover;
+        AST::PluginVisitor visitor(&remover, &editor, passMask);
 
-            Transformer::DeadCodeRemover remover;
-            AST::PluginVisitor visitor(&remover, &data.editor);
+        i.script->Accept(visitor, _rep);
 
-            AST::Node* _rep;
-            i.script->Accept(visitor, _rep);
+        i.script->AdjustSourceOffset(0);
 
-            dirty |= visitor.dirty;
-        }
+        Transformer::DummyCodePostRemover postRemover(remover.dummy);
+        AST::PluginVisitor postVisitor(&postRemover, &editor, passMask);
 
-        {
-            i.script->AdjustSourceOffset(0);
+        i.script->Accept(postVisitor, _rep);
+        return visitor.dirty;
+    }
+    case SimplifyPass::InlineFunctions: {
+        Transformer::FunctionInliner inliner;
+        AST::PluginVisitor visitor(&inliner, &editor, passMask);
 
-            Transformer::DummyCodeRemover remover;
-            AST::PluginVisitor visitor(&remover, &data.editor);
+        i.script->Accept(visitor, _rep);
+        return visitor.dirty;
+    }
+    default:
+        return false;
+    }
+}
 
-            AST::Node* _rep;
-            i.script->Accept(visitor, _rep);
+GView::View::LexicalViewer::PluginAfterActionRequest Simplify::Execute(GView::View::LexicalViewer::PluginData& data, Reference<Window> parent)
+{
+    AST::Instance i;
+    i.Create(data.tokens);
 
-            i.script->AdjustSourceOffset(0);
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
 
-            Transformer::DummyCodePostRemover postRemover(remover.dummy);
-            AST::PluginVisitor postVisitor(&postRemover, &data.editor);
+    // the passes below do many small edits - they are kept in a piece table and applied on the text once, at the end
+    data.editor.BeginBatch();
 
-            i.script->Accept(postVisitor, _rep);
+    // worklist of passes: a pass runs again only if the script was changed since its last run, and the local passes
+    // (see AST::Plugin::IsSubtreeLocal) skip the subtrees they have already seen unchanged
+    constexpr uint32 PASSES_COUNT = static_cast<uint32>(SimplifyPass::Count);
+    constexpr uint32 ALL_PASSES   = (1u << PASSES_COUNT) - 1;
 
-            dirty |= visitor.dirty;
+    uint32 pending = ALL_PASSES;
+    for (uint32 pass = 0; pending != 0; pass = (pass + 1) % PASSES_COUNT) {
+        const auto mask = 1u << pass;
+        if ((pending & mask) == 0) {
+            continue;
         }
 
-        {
-            i.script->AdjustSourceOffset(0);
-
-            Transformer::FunctionInliner inliner;
-            AST::PluginVisitor visitor(&inliner, &data.editor);
-
-            AST::Node* _rep;
-            i.script->Accept(visitor, _rep);
-
-            dirty |= visitor.dirty;
+        pending &= ~mask;
+        if (RunPass(i, data.editor, static_cast<SimplifyPass>(pass))) {
+            pending = ALL_PASSES;
         }
-    } while (dirty);
+    }
 
     // At the end, hoist
 
@@ -153,7 +156,8 @@ GView::View::LexicalViewer::PluginAfterActionRequest Simplify::Execute(GView::Vi
             }
 
             // The destination can overlap with the source
-            std::u16string content = { ((std::u16string_view) data.editor).data() + fun->sourceStart, fun->sourceSize };
+            std::u16string content;
+            data.editor.GetText(fun->sourceStart, fun->sourceSize, content);
 
             data.editor.Insert(dest, content);
             data.editor.Delete(fun->sourceStart + fun->sourceSize, fun->sourceSize);
@@ -164,10 +168,9 @@ GView::View::LexicalViewer::PluginAfterActionRequest Simplify::Execute(GView::Vi
         }
     }
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
+
+    data.editor.CommitBatch();
 
     return PluginAfterActionRequest::Rescan;
 }
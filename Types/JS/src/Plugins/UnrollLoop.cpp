@@ -376,10 +376,7 @@ GView::View::LexicalViewer::PluginAfterActionRequest UnrollLoop::Execute(GView::
     AST::Instance i;
     i.Create(data.tokens);
 
-    {
-        AST::DumpVisitor dump("_ast.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast.json");
 
     // return PluginAfterActionRequest::None;
 
@@ -396,10 +393,7 @@ GView::View::LexicalViewer::PluginAfterActionRequest UnrollLoop::Execute(GView::
     AST::Node* _rep;
     i.script->Accept(visitor, _rep);
 
-    {
-        AST::DumpVisitor dump("_ast_after.json");
-        i.script->AcceptConst(dump);
-    }
+    AST::DumpVisitor::DumpIfEnabled(i.script, "_ast_after.json");
 
     return PluginAfterActionRequest::Rescan;
 }
@@ -489,4 +489,10 @@ std::unordered_map<std::u16string_view, StringMemberAccessCallFn> constStringMem
 
         return AST::Action::None;
     }
+
+    // folding only looks at the folded node and its children
+    bool ConstFolder::IsSubtreeLocal()
+    {
+        return true;
+    }
 }
\ No newline at end of file
@@ -170,4 +170,10 @@ namespace GView::Type::JS::Transformer
 
         return AST::Action::None;
     }
+
+    // outside of a dead region, a subtree is only simplified based on its own content
+    bool DeadCodeRemover::IsSubtreeLocal()
+    {
+        return !dead;
+    }
 }
\ No newline at end of file
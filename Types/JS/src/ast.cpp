@@ -1,5 +1,7 @@
 #include "ast.hpp"
 
+#include <chrono>
+
 namespace GView
 {
 namespace Type
@@ -16,6 +18,94 @@ namespace Type
                 return str;
             }
 
+            static thread_local Arena* currentArena = nullptr;
+
+            // every node is preceded by the arena that owns it (nullptr for the nodes taken from the heap)
+            constexpr size_t NODE_HEADER_SIZE = alignof(std::max_align_t);
+
+            Arena* Arena::GetCurrent()
+            {
+                return currentArena;
+            }
+
+            void Arena::SetCurrent(Arena* arena)
+            {
+                currentArena = arena;
+            }
+
+            void* Arena::Allocate(size_t size)
+            {
+                size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+                stats.allocations++;
+
+                if (size <= MAX_POOLED_SIZE) {
+                    auto& slot = freeLists[size / ALIGNMENT];
+                    if (slot) {
+                        auto result = slot;
+                        slot        = slot->next;
+                        stats.reused++;
+                        return result;
+                    }
+                }
+
+                if (size > remaining) {
+                    const auto blockSize = std::max(BLOCK_SIZE, size);
+                    blocks.emplace_back(new uint8[blockSize]);
+                    current   = blocks.back().get();
+                    remaining = blockSize;
+                    stats.blocks++;
+                    stats.bytes += blockSize;
+                }
+
+                auto result = current;
+                current += size;
+                remaining -= size;
+                return result;
+            }
+
+            void Arena::Release(void* ptr, size_t size)
+            {
+                size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+                stats.released++;
+
+                // bigger slots are simply left in their block until the arena goes away
+                if (size <= MAX_POOLED_SIZE) {
+                    auto slot                   = reinterpret_cast<FreeSlot*>(ptr);
+                    slot->next                  = freeLists[size / ALIGNMENT];
+                    freeLists[size / ALIGNMENT] = slot;
+                }
+            }
+
+            void* Node::operator new(size_t size)
+            {
+                auto arena  = Arena::GetCurrent();
+                auto memory = reinterpret_cast<uint8*>(arena ? arena->Allocate(size + NODE_HEADER_SIZE) : ::operator new(size + NODE_HEADER_SIZE));
+
+                *reinterpret_cast<Arena**>(memory) = arena;
+                return memory + NODE_HEADER_SIZE;
+            }
+
+            void Node::operator delete(void* ptr, size_t size)
+            {
+                if (!ptr) {
+                    return;
+                }
+
+                auto memory = reinterpret_cast<uint8*>(ptr) - NODE_HEADER_SIZE;
+                auto arena  = *reinterpret_cast<Arena**>(memory);
+
+                if (arena) {
+                    arena->Release(memory, size + NODE_HEADER_SIZE);
+                } else {
+                    ::operator delete(memory);
+                }
+            }
+
+            Instance::Instance() : previousArena(Arena::GetCurrent()), tokenOffset(0)
+            {
+                Arena::SetCurrent(&arena);
+            }
+
             void Instance::Create(TokensList& tokens)
             {
                 tokenOffset = 0;
@@ -23,14 +113,21 @@ namespace Type
                 auto start = 0;
                 auto end   = tokens.Len();
 
+                const auto parseStart = std::chrono::steady_clock::now();
+
                 Parser parser(tokens, end);
 
                 script = parser.ParseBlock();
+
+                parseDurationUs =
+                      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - parseStart).count();
             }
 
             Instance::~Instance()
             {
+                // the destructors still run (names and child lists live on the heap), the memory of the nodes goes away with the arena
                 delete script;
+                Arena::SetCurrent(previousArena);
             }
 
             void Node::SetSource(Token start, Token end)
@@ -1811,6 +1908,11 @@ namespace Type
                 return Action::None;
             }
 
+            bool Plugin::IsSubtreeLocal()
+            {
+                return false;
+            }
+
             void PluginVisitor::UpdateNode(Node* parent, FunDecl* child)
             {
                 auto oldSize = child->nameSize;
@@ -1820,6 +1922,7 @@ namespace Type
 
                 // Update parent source range
                 parent->sourceSize += diffSize;
+                parent->unchangedPasses = 0;
 
                 // Replace in editor
                 editor->Delete(child->nameOffset, child->nameSize);
@@ -1833,6 +1936,7 @@ namespace Type
 
                 // The new node should not be re-adjusted in the future
                 child->AdjustSourceOffset(tokenOffset);
+                child->unchangedPasses = 0;
 
                 dirty = true;
             }
@@ -1846,6 +1950,7 @@ namespace Type
 
                 // Update parent source range
                 parent->sourceSize += diffSize;
+                parent->unchangedPasses = 0;
 
                 // Replace in editor
                 editor->Delete(child->sourceStart, child->nameSize);
@@ -1859,6 +1964,7 @@ namespace Type
 
                 // The new node should not be re-adjusted in the future
                 child->AdjustSourceOffset(tokenOffset);
+                child->unchangedPasses = 0;
 
                 dirty = true;
             }
@@ -1872,6 +1978,7 @@ namespace Type
 
                 // Update parent source range
                 parent->sourceSize += diffSize;
+                parent->unchangedPasses = 0;
 
                 // Replace in editor
                 editor->Delete(child->sourceStart, child->nameSize);
@@ -1885,6 +1992,7 @@ namespace Type
 
                 // The new node should not be re-adjusted in the future
                 child->AdjustSourceOffset(tokenOffset);
+                child->unchangedPasses = 0;
 
                 dirty = true;
             }
@@ -1916,6 +2024,7 @@ namespace Type
 
                 // Update parent source range
                 parent->sourceSize += diffSize;
+                parent->unchangedPasses = 0;
 
                 // Replace in editor
                 editor->Delete(child->sourceStart, child->sourceSize);
@@ -1926,6 +2035,7 @@ namespace Type
 
                 // The new node should not be re-adjusted in the future
                 child->AdjustSourceOffset(tokenOffset);
+                child->unchangedPasses = 0;
 
                 dirty = true;
             }
@@ -1948,7 +2058,7 @@ namespace Type
 
                 if (replacement->sourceSize != 0) {
                     // The replacement is a child of the child which already has everything set up
-                    newSource = std::u16string(&(*editor)[replacement->sourceStart], replacement->sourceSize);
+                    editor->GetText(replacement->sourceStart, replacement->sourceSize, newSource);
                 } else {
                     // Generate new source
                     newSource               = replacement->GenSourceCode();
@@ -1962,6 +2072,7 @@ namespace Type
 
                 // Update parent source range
                 parent->sourceSize += diffSize;
+                parent->unchangedPasses = 0;
 
                 // Replace in editor
                 editor->Delete(child->sourceStart, child->sourceSize);
@@ -1983,6 +2094,7 @@ namespace Type
             {
                 // Update parent size
                 parent->sourceSize -= child->sourceSize;
+                parent->unchangedPasses = 0;
 
                 // Delete in editor
                 editor->Delete(child->sourceStart, child->sourceSize);
@@ -1999,16 +2111,37 @@ namespace Type
             void PluginVisitor::AdjustSize(Node* node, int32 offset)
             {
                 node->sourceSize += offset;
+                node->unchangedPasses = 0;
+            }
+
+            PluginVisitor::PluginVisitor(Plugin* plugin, TextEditor* editor, uint32 passMask)
+                : plugin(plugin), tokenOffset(0), editor(editor), passMask(passMask), dirty(false)
+            {
             }
 
-            PluginVisitor::PluginVisitor(Plugin* plugin, TextEditor* editor) : plugin(plugin), tokenOffset(0), editor(editor), dirty(false)
+            bool PluginVisitor::IsSubtreeLocal()
             {
+                return (passMask != 0) && plugin->IsSubtreeLocal();
+            }
+
+            // a subtree is marked only if the plugin was local both when entering and when leaving it
+            Action PluginVisitor::MarkUnchanged(Node* node, bool localOnEnter)
+            {
+                if (localOnEnter && IsSubtreeLocal()) {
+                    node->unchangedPasses |= passMask;
+                }
+                return Action::None;
             }
 
             Action PluginVisitor::VisitFunDecl(FunDecl* node, Decl*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterFunDecl(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2119,16 +2252,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitVarDeclList(VarDeclList* node, Decl*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterVarDeclList(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2201,17 +2340,23 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitVarDecl(VarDecl* node, Decl*& replacement)
             {
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterVarDecl(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2267,11 +2412,12 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitBlock(Block* node, Block*& replacement)
             {
@@ -2351,6 +2497,7 @@ namespace Type
                 }
 
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
@@ -2361,6 +2508,11 @@ namespace Type
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterIfStmt(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2514,17 +2666,23 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitWhileStmt(WhileStmt* node, Stmt*& replacement)
             {
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterWhileStmt(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2624,17 +2782,23 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitForStmt(ForStmt* node, Stmt*& replacement)
             {
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterForStmt(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2835,11 +2999,12 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
 
             Action PluginVisitor::VisitReturnStmt(ReturnStmt* node, Stmt*& replacement)
@@ -2847,6 +3012,11 @@ namespace Type
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterReturnStmt(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2903,11 +3073,12 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
 
             Action PluginVisitor::VisitExprStmt(ExprStmt* node, Stmt*& replacement)
@@ -2915,6 +3086,11 @@ namespace Type
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterExprStmt(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -2975,11 +3151,12 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitIdentifier(Identifier* node, Expr*& replacement)
             {
@@ -2999,6 +3176,11 @@ namespace Type
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterUnop(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3052,16 +3234,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitBinop(Binop* node, Expr*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterBinop(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3157,16 +3345,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitTernary(Ternary* node, Expr*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterTernary(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3308,16 +3502,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitCall(Call* node, Expr*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterCall(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3415,16 +3615,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitLambda(Lambda* node, Expr*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterLambda(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3529,17 +3735,23 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitGrouping(Grouping* node, Expr*& replacement)
             {
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterGrouping(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3594,16 +3806,22 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitCommaList(CommaList* node, Expr*& replacement)
             {
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterCommaList(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3669,17 +3887,23 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitMemberAccess(MemberAccess* node, Expr*& replacement)
             {
                 // Update node source start if any nodes before it were modified
                 node->AdjustSourceStart(tokenOffset);
 
+                const auto local = IsSubtreeLocal();
+                if (local && ((node->unchangedPasses & passMask) != 0)) {
+                    return Action::None;
+                }
+
                 auto action = plugin->OnEnterMemberAccess(node, replacement);
                 if (action != Action::None) {
                     return action;
@@ -3775,11 +3999,12 @@ namespace Type
 
                 // Node wasn't altered, but children were
                 if (dirty) {
+                    node->unchangedPasses = 0;
                     return Action::_UpdateChild;
                 }
 
                 // Node and children weren't altered
-                return Action::None;
+                return MarkUnchanged(node, local);
             }
             Action PluginVisitor::VisitNumber(Number* node, Expr*& replacement)
             {
@@ -3830,6 +4055,21 @@ namespace Type
             {
             }
 
+            void DumpVisitor::DumpIfEnabled(Block* script, const char* file)
+            {
+                auto settings = AppCUI::Application::GetAppSettings();
+                if (!settings->HasSection("Type.JS")) {
+                    return;
+                }
+                const auto enabled = settings->GetSection("Type.JS")["DumpAST"].AsBool();
+                if (!enabled.has_value() || !enabled.value()) {
+                    return;
+                }
+
+                DumpVisitor dump(file);
+                script->AcceptConst(dump);
+            }
+
 #define DUMP(type)                                                                                                                                             \
     do {                                                                                                                                                       \
         file << "{\"type\": \"" type "\", \"source\": {\"start\": " << node->sourceStart << ", \"size\": " << node->sourceSize << "}";                         \
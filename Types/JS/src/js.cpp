@@ -63,6 +63,7 @@ extern "C"
         sect["Extension"]   = "js";
         sect["Priority"]    = 1;
         sect["Description"] = "JavaScript / ECMAScript language file (*.js)";
+        sect["DumpAST"]     = false;
     }
 }
 
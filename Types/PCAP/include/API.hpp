@@ -37,8 +37,40 @@ struct ConnectionCallbackInterface {
     virtual ~ConnectionCallbackInterface() = default;
 };
 
+/**
+ * \brief Reassembled payload of a connection. Nothing is materialized: the bytes are read from the capture on demand
+ * and only a window of the stream is kept in memory, so connections of any size can be parsed.
+ */
+class PayloadStream
+{
+    static constexpr uint32 WINDOW_SIZE = 0x10000;
+
+    const StreamData& stream;
+    GView::Utils::DataCache& cache;
+    Buffer window;
+    uint64 windowStart;
+    uint32 windowSize;
+
+  public:
+    PayloadStream(const StreamData& stream, GView::Utils::DataCache& cache);
+
+    /**
+     * \brief Size of the reassembled stream (both directions, in the order their data became available)
+     */
+    uint64 GetSize() const;
+    /**
+     * \brief Byte at the given position of the stream; sequential access is served from the current window
+     * \return false if the position is past the end of the stream or it can not be read
+     */
+    bool GetByte(uint64 offset, uint8& value);
+    /**
+     * \brief Copies size bytes starting at the given position of the stream
+     */
+    bool Read(uint64 offset, uint8* buffer, uint32 size);
+};
+
 struct PayloadInformation {
-    StreamPayload* payload;
+    PayloadStream* payload;
     std::vector<StreamPacketData>* packets;
 };
 
@@ -50,8 +82,8 @@ struct PayloadDataParserInterface {
     virtual std::string GetProtocolName() const = 0;
 
     /**
-     * \brief Try to parse the connection
-     * \param payloadInformation contains the full payload and a vector of packets
+     * \brief Try to parse the connection. Connections are parsed in parallel => this may be called concurrently (for different connections)
+     * \param payloadInformation contains the reassembled payload and a vector of packets
      * \param callbackInterface interface for sending data back to the to appear in StreamManager
      * \return nullptr if the parser is not able to parse the payload, otherwise a pointer to the parser
      */
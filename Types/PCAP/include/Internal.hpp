@@ -484,6 +484,26 @@ struct PacketHeader
 
 static_assert(sizeof(PacketHeader) == 16);
 
+static void Swap(PacketHeader& packetHeader)
+{
+    packetHeader.tsSec   = AppCUI::Endian::BigToNative(packetHeader.tsSec);
+    packetHeader.tsUsec  = AppCUI::Endian::BigToNative(packetHeader.tsUsec);
+    packetHeader.inclLen = AppCUI::Endian::BigToNative(packetHeader.inclLen);
+    packetHeader.origLen = AppCUI::Endian::BigToNative(packetHeader.origLen);
+}
+
+// an indexed packet: its header (already in native byte order) and the file offset where that header starts
+struct PacketEntry
+{
+    PacketHeader header;
+    uint64 offset;
+
+    uint64 GetDataOffset() const
+    {
+        return offset + sizeof(PacketHeader);
+    }
+};
+
 enum class EtherType : uint16 // https://www.liveaction.com/resources/glossary/ethertype-values
 {
     Unknown                                      = 0,
@@ -1933,9 +1953,10 @@ static void Swap(ICMPHeader_13_14& icmp13_14)
     icmp13_14.transmitTimestamp  = AppCUI::Endian::BigToNative(icmp13_14.transmitTimestamp);
 }
 
+// a range of the reassembled byte stream of a connection (see StreamData::ReadPayload)
 struct StreamPayload
 {
-    uint8* location;
+    uint64 offset;
     uint32 size;
 };
 
@@ -1967,10 +1988,10 @@ struct PacketData {
 };
 
 struct StreamPacketData {
-    const PacketHeader* header;
-    StreamPayload payload;
+    uint32 packetIndex;   // index in PCAPFile::packetHeaders
+    uint64 payloadOffset; // file offset of the transport layer payload
+    uint32 payloadSize;
     StreamTCPOrder order;
-    PacketData packetData;
 
     // TODO
     bool operator<(const StreamPacketData& other) const
@@ -2031,6 +2052,96 @@ struct StreamTcpLayer
     }
 };
 
+// one side of a connection, in native byte order (an IPv4 address is stored as its uint32 value in the first 4 bytes)
+struct FlowEndpoint
+{
+    uint16 address[8];
+    uint16 port;
+};
+
+// direction independent identification of a connection - endpoint a is the lower one (compared as raw bytes)
+// the structure has no padding so it is hashed and compared as raw bytes
+struct FlowKey
+{
+    FlowEndpoint a;
+    FlowEndpoint b;
+    uint16 ipProtocol; // EtherType
+    uint8 transportProtocol;
+    uint8 reserved;
+
+    // returns true if the packet travels from b to a
+    bool Set(const FlowEndpoint& source, const FlowEndpoint& destination, uint16 ipProto, IP_Protocol transport)
+    {
+        const auto reversed = memcmp(&source, &destination, sizeof(FlowEndpoint)) > 0;
+        a                   = reversed ? destination : source;
+        b                   = reversed ? source : destination;
+        ipProtocol          = ipProto;
+        transportProtocol   = static_cast<uint8>(transport);
+        reserved            = 0;
+        return reversed;
+    }
+
+    bool operator==(const FlowKey& other) const
+    {
+        return memcmp(this, &other, sizeof(FlowKey)) == 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40);
+
+struct FlowKeyHash
+{
+    size_t operator()(const FlowKey& key) const noexcept
+    {
+        uint64 words[sizeof(FlowKey) / sizeof(uint64)];
+        memcpy(words, &key, sizeof(FlowKey));
+
+        uint64 hash = 0x9E3779B97F4A7C15ULL;
+        for (const auto word : words)
+        {
+            hash ^= word;
+            hash *= 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 31;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+// a piece of the reassembled byte stream of a connection - the bytes are not copied, they stay in the capture file
+struct StreamChunk
+{
+    uint64 fileOffset;
+    uint64 streamOffset; // position in the reassembled stream
+    uint32 size;
+    uint8 direction; // 0 - sent by flow.a, 1 - sent by flow.b
+};
+
+// TCP reassembly state of one direction of a connection
+// sequence numbers are kept relative to the first data byte (as 64 bit values, so wrapping around 2^32 is not an issue)
+struct TCPReassemblyState
+{
+    // segments received ahead of a missing one wait here until the gap is filled (or given up on)
+    static constexpr uint32 MAX_PENDING_SEGMENTS = 1024;
+
+    struct Segment
+    {
+        uint64 fileOffset;
+        uint32 size;
+    };
+
+    bool initialized  = false;
+    uint32 initialSeq = 0; // sequence number of the first data byte
+    uint64 nextOffset = 0; // the next expected byte
+    std::map<uint64, Segment> pending;
+
+    // relative offset of a sequence number, as close as possible to the next expected byte
+    int64 ToRelative(uint32 seq) const
+    {
+        const auto expected = initialSeq + static_cast<uint32>(nextOffset);
+        return static_cast<int64>(nextOffset) + static_cast<int32>(seq - expected);
+    }
+};
+
 // TODO: for the future maybe change structure for a more generic structure
 constexpr uint32 PCAP_MAX_SUMMARY_SIZE = 100;
 struct StreamData
@@ -2040,8 +2151,12 @@ struct StreamData
     std::vector<StreamPacketData> packetsOffsets             = {};
     uint16 ipProtocol                                        = INVALID_IP_PROTOCOL_VALUE;
     uint16 transportProtocol                                 = INVALID_TRANSPORT_PROTOCOL_VALUE;
-    uint64 totalPayload                                      = 0;
+    uint64 totalPayload                                      = 0; // size of the reassembled stream
+    uint32 gapsFound                                         = 0; // holes in the TCP sequence space that were never filled
+    uint64 missingBytes                                      = 0;
     std::string name                                         = {};
+    FlowKey flow                                             = {};
+    bool initiatedFromB                                      = false; // the first packet went from flow.b to flow.a
     bool isFinished                                          = false;
     uint8 finFlagsFound                                      = 0;
     std::string appLayerName                                 = "";
@@ -2050,7 +2165,9 @@ struct StreamData
     std::deque<StreamTcpLayer> applicationLayers;
     struct PayloadDataParserInterface* payloadParserFound = nullptr;
 
-    StreamPayload connPayload;
+    std::vector<StreamChunk> chunks; // the reassembled stream, both directions in the order their data became available
+    TCPReassemblyState reassembly[2];
+
     // Delete copy constructor and assignment operator
     StreamData(const StreamData&)            = delete;
     StreamData& operator=(const StreamData&) = delete;
@@ -2093,8 +2210,18 @@ struct StreamData
         std::sort(packetsOffsets.begin(), packetsOffsets.end());
     }
 
-    void ComputeFinalPayload();
-    //void TryParsePayload();
+    void ComputeName();
+
+    void AddTCPSegment(uint8 direction, uint32 seq, bool hasSynFlag, uint64 fileOffset, uint32 size);
+    void AddDatagram(uint8 direction, uint64 fileOffset, uint32 size);
+    // delivers the segments still waiting behind a gap - called once all the packets were added
+    void FinishReassembly();
+    // copies size bytes starting at offset (in the reassembled stream) from the capture file
+    bool ReadPayload(GView::Utils::DataCache& cache, uint64 offset, uint8* buffer, uint32 size) const;
+
+  private:
+    void AppendChunk(uint8 direction, uint64 fileOffset, uint32 size);
+    void DeliverPending(TCPReassemblyState& state, uint8 direction);
 };
 
 } // namespace GView::Type::PCAP
@@ -8,11 +8,11 @@ namespace GView::Type::PCAP
 {
 class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
-  public:
-    Buffer data; // it's maximum 0xFFFF so just save it here
+    Buffer largePacket; // packets that do not fit in the object's cache are copied here
 
+  public:
     Header header;
-    std::vector<std::pair<PacketHeader*, uint32>> packetHeaders;
+    std::vector<PacketEntry> packetHeaders; // only offsets and headers - packet bodies are read on demand
     StreamManager streamManager;
 
 	uint32 currentItemIndex{ 0 };
@@ -24,6 +24,9 @@ class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateIn
 
     bool Update();
 
+    // packet bytes (without its PacketHeader) - valid until the next read from the object
+    BufferView GetPacketData(uint32 index);
+
     std::string_view GetTypeName() override
     {
         return "PCAP";
@@ -113,6 +116,7 @@ namespace Panels
         inline static const auto hexUint64 = NumericFormat{ NumericFormatFlags::HexPrefix, 16, 0, ' ', 8 };
 
         void UpdateGeneralInformation();
+        void UpdateDissectionStatistics();
         void UpdatePcapHeader();
         void UpdateIssues();
         void RecomputePanelsPositions();
@@ -6,28 +6,77 @@ namespace GView::Type::PCAP
 {
 class StreamManager
 {
-    std::unordered_map<std::string, std::deque<StreamData>> streams;
+  public:
+    struct DissectionStatistics {
+        uint32 packets; // dissected packets (fewer than the packets of the capture if the user cancelled)
+        uint32 workers;
+        uint64 durationMs;
+    };
+
+  private:
+    using FlowTable = std::unordered_map<FlowKey, std::deque<StreamData>, FlowKeyHash>;
+
+    // packets are decoded in parallel (in blocks) and then assigned to streams by shards - a flow always lands in the
+    // same shard, so the packets of a flow are still added in capture order
+    static constexpr uint32 BLOCK_SIZE        = 0x1000;
+    static constexpr uint32 BLOCKS_PER_WORKER = 4; // blocks decoded per worker before the shards consume them
+    // the link, network and transport headers always fit in the first bytes of a packet (14 + 60 + 60 at most)
+    static constexpr uint32 MAX_HEADERS_SIZE = 0x100;
+
     std::vector<StreamData> finalStreams;
     std::vector<std::string> protocolsFound;
     std::vector<unique_ptr<PayloadDataParserInterface>> payloadParsers;
     Reference<GView::View::WindowInterface> window;
+    DissectionStatistics statistics{};
+
+    // everything needed to add a packet to its stream
+    struct DecodedPacket {
+        FlowKey key;
+        uint64 payloadOffset; // file offset of the transport layer payload
+        uint32 index;         // index in PCAPFile::packetHeaders
+        uint32 payloadSize;
+        uint32 seq;
+        uint32 ack;
+        uint8 tcpFlags;
+        bool fromB;
+        bool valid;
+    };
+
+    // the packet being decoded - its bytes are only valid during DecodePacket so streams keep file offsets instead of pointers
+    struct PacketSource {
+        const uint8* data; // packet bytes (after the PacketHeader)
+        uint64 dataOffset; // file offset of data
+        DecodedPacket* result;
+    };
 
     // TODO: maybe sync functions with those used in Panels?
-    void Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet);
-    void Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet);
+    static void Decode_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketSource& source);
+    static void Decode_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketSource& source);
+
+    static void Decode_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketSource& source);
+    static void Decode_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketSource& source);
+
+    static void Decode_TCPHeader(
+          PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& source);
+    static void Decode_UDPHeader(
+          PacketData* packetData, const UDPHeader* udp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& source);
 
-    void Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet);
-    void Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet);
+    static bool GetFlowEndpoints(const void* ipHeader, uint32 ipProto, FlowEndpoint& source, FlowEndpoint& destination);
+    static void DecodePacket(const PacketEntry& entry, BufferView headers, LinkType network, DecodedPacket& result);
 
-    void Add_TCPHeader(PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet);
+    // the connection the packet belongs to (a new one is started if the previous connection between the endpoints is finished)
+    static StreamData& GetStream(FlowTable& streams, const DecodedPacket& packet);
+    static void AddToStream(FlowTable& streams, const DecodedPacket& packet);
 
+    void FinishedAdding(std::vector<FlowTable>& shards, std::vector<GView::Utils::DataCache>& views);
     void AddToKnownProtocols(const std::string& layerName);
 
   public:
     StreamManager() = default;
 
-    void AddPacket(const PacketHeader* packet, LinkType network);
-    void FinishedAdding();
+    // decodes the packets, assigns them to streams and runs the payload parsers - on all the available cores
+    // returns false if the user canceled the operation (the streams found until then are kept)
+    bool AddPackets(const std::vector<PacketEntry>& packets, LinkType network);
     bool RegisterPayloadParser(unique_ptr<PayloadDataParserInterface> parser);
 
     void InitStreamManager(Reference<GView::View::WindowInterface> windowParam);
@@ -36,6 +85,11 @@ class StreamManager
         return window;
     }
 
+    const DissectionStatistics& GetDissectionStatistics() const
+    {
+        return statistics;
+    }
+
     bool empty() const noexcept
     {
         return finalStreams.empty();
@@ -1,11 +1,15 @@
 #include "API.hpp"
 #include "StreamManager.hpp"
 
+#include <mutex>
+
 using namespace GView::Type::PCAP;
 
 struct ConnectionCallbackInterfaceImpl : public ConnectionCallbackInterface {
     StreamData* streamData;
-    StreamManager* streamManager;
+    // the parsers run on worker threads - panels are collected and added to the window once they are all done
+    std::vector<std::pair<Pointer<TabPage>, bool>>* panels;
+    std::mutex* panelsLock;
 
     virtual bool AddConnectionAppLayerName(std::string appLayerName) override
     {
@@ -19,7 +23,9 @@ struct ConnectionCallbackInterfaceImpl : public ConnectionCallbackInterface {
     }
     virtual bool AddPanel(Pointer<TabPage> panel, bool isVertical) override
     {
-        return streamManager->GetWindow()->AddPanel(std::move(panel), isVertical);
+        std::scoped_lock guard(*panelsLock);
+        panels->emplace_back(std::move(panel), isVertical);
+        return true;
     }
 
     std::deque<StreamTcpLayer>& GetApplicationLayers() override
@@ -28,38 +34,56 @@ struct ConnectionCallbackInterfaceImpl : public ConnectionCallbackInterface {
     }
 };
 
-void StreamManager::FinishedAdding()
+void StreamManager::FinishedAdding(std::vector<FlowTable>& shards, std::vector<GView::Utils::DataCache>& views)
 {
-    if (streams.empty())
+    for (auto& shard : shards) {
+        for (auto& [flow, connections] : shard)
+            for (auto& conn : connections)
+                finalStreams.emplace_back(std::move(conn));
+        shard.clear();
+    }
+    if (finalStreams.empty())
         return;
 
-    finalStreams.reserve(streams.size());
+    // the shards (and their hash tables) have no meaningful order => streams are listed in the order of their first packet
+    std::sort(finalStreams.begin(), finalStreams.end(), [](const StreamData& a, const StreamData& b) {
+        return a.packetsOffsets.front().packetIndex < b.packetsOffsets.front().packetIndex;
+    });
 
-    for (auto& [streamName, connections] : streams) {
-        for (auto& conn : connections) {
-            conn.name = streamName;
-            // conn.SortPackets();
-            conn.ComputeFinalPayload();
+    std::vector<std::pair<Pointer<TabPage>, bool>> panels;
+    std::mutex panelsLock;
 
-            ConnectionCallbackInterfaceImpl callbackInterface = {};
-            callbackInterface.streamData                      = &conn;
+    GView::Utils::ParallelFor((uint32) finalStreams.size(), [&](uint32 index, uint32 workerIndex) {
+        auto& conn = finalStreams[index];
+        conn.ComputeName();
+        conn.FinishReassembly();
 
-            if (conn.connPayload.size) {
-                PayloadInformation payloadInfo{ &conn.connPayload, &conn.packetsOffsets };
-                for (auto& parser : payloadParsers) {
-                    auto result = parser->ParsePayload(payloadInfo, &callbackInterface);
-                    if (result) {
-                        conn.payloadParserFound = result;
-                        break;
-                    }
+        ConnectionCallbackInterfaceImpl callbackInterface = {};
+        callbackInterface.streamData                      = &conn;
+        callbackInterface.panels                          = &panels;
+        callbackInterface.panelsLock                      = &panelsLock;
+
+        if (conn.totalPayload) {
+            // the parsers read the reassembled stream straight from the capture
+            PayloadStream payload(conn, views[workerIndex]);
+            PayloadInformation payloadInfo{ &payload, &conn.packetsOffsets };
+            for (auto& parser : payloadParsers) {
+                auto result = parser->ParsePayload(payloadInfo, &callbackInterface);
+                if (result) {
+                    conn.payloadParserFound = result;
+                    break;
                 }
             }
+        }
 
-            if (!conn.appLayerName.empty())
-                AddToKnownProtocols(conn.appLayerName);
-            finalStreams.emplace_back(std::move(conn));
+        if (conn.gapsFound) {
+            LocalString<64> gaps;
+            conn.AddDataToSummary(gaps.Format("%u gaps (%llu bytes missing)", conn.gapsFound, conn.missingBytes));
         }
-    }
+    });
 
-    streams.clear();
-}
\ No newline at end of file
+    for (auto& [panel, isVertical] : panels)
+        window->AddPanel(std::move(panel), isVertical);
+    for (const auto& conn : finalStreams)
+        AddToKnownProtocols(conn.appLayerName);
+}
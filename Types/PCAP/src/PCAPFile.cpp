@@ -8,28 +8,55 @@ PCAPFile::PCAPFile()
 
 bool PCAPFile::Update()
 {
-    auto offset = 0;
+    uint64 offset = 0;
     CHECK(obj->GetData().Copy<Header>(offset, header), false, "");
     offset += sizeof(Header);
-    if (header.magicNumber == Magic::Swapped)
+    const auto swapped = header.magicNumber == Magic::Swapped;
+    if (swapped)
     {
         Swap(header);
     }
 
-    // TODO: check for future, is this really ok? test with big pcap files
-    data = obj->GetData().CopyToBuffer(offset, (uint32) obj->GetData().GetSize() - offset);
-    CHECK(data.IsValid(), false, "");
-
-    const auto delta = offset;
-    do
+    // index only the packet headers - the bodies stay in the file and are read through the cache when needed
+    packetHeaders.clear();
+    const auto fileSize = obj->GetData().GetSize();
+    while (offset + sizeof(PacketHeader) <= fileSize)
     {
-        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (data.GetData() + offset - delta), offset);
-        offset += (sizeof(PacketHeader) + header->origLen);
-    } while (offset < obj->GetData().GetSize());
+        PacketEntry entry{ {}, offset };
+        CHECKBK(obj->GetData().Copy<PacketHeader>(offset, entry.header), "");
+        if (swapped)
+        {
+            Swap(entry.header);
+        }
+
+        const auto next = entry.GetDataOffset() + entry.header.inclLen;
+        CHECKBK(next <= fileSize, "Packet #%u is truncated!", (uint32) packetHeaders.size());
+
+        packetHeaders.push_back(entry);
+        offset = next;
+    }
 
     return true;
 }
 
+BufferView PCAPFile::GetPacketData(uint32 index)
+{
+    CHECK(index < packetHeaders.size(), BufferView(), "");
+    const auto& entry = packetHeaders[index];
+    if (entry.header.inclLen == 0)
+    {
+        return BufferView();
+    }
+
+    if (entry.header.inclLen <= obj->GetData().GetCacheSize())
+    {
+        return obj->GetData().Get(entry.GetDataOffset(), entry.header.inclLen, true);
+    }
+
+    largePacket = obj->GetData().CopyToBuffer(entry.GetDataOffset(), entry.header.inclLen);
+    return BufferView{ largePacket.GetData(), largePacket.GetLength() };
+}
+
 constexpr uint64 ITEM_INVALID_VALUE = static_cast<uint64>(-1);
 
 bool PCAPFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
@@ -156,8 +183,10 @@ void PCAPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIt
     if (layer.payload.size == 0)
         return;
 
-    uint8* payload = new uint8[layer.payload.size];
-    memcpy(payload, layer.payload.location, layer.payload.size);
+    Buffer buffer;
+    buffer.Resize(layer.payload.size);
+    if (!stream->ReadPayload(obj->GetData(), layer.payload.offset, buffer.GetData(), layer.payload.size))
+        return;
 
     std::string extractionName;
     if (!layer.extractionName.empty())
@@ -165,8 +194,6 @@ void PCAPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIt
     else
         extractionName = (const char*) layer.name.get();
 
-    const Buffer buffer = { payload, layer.payload.size };
-
     GView::App::OpenBuffer(buffer, extractionName, extractionName, GView::App::OpenMethod::BestMatch);
 }
 
@@ -30,6 +30,23 @@ void Information::UpdateGeneralInformation()
     UpdatePcapHeader();
 
     AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packetHeaders.size()).SetType(ListViewItem::Type::Emphasized_1);
+
+    general->AddItem("Dissection").SetType(ListViewItem::Type::Category);
+    UpdateDissectionStatistics();
+}
+
+void Information::UpdateDissectionStatistics()
+{
+    LocalString<1024> ls;
+    NumericFormatter nf;
+
+    const auto& statistics = pcap->streamManager.GetDissectionStatistics();
+    AddDecAndHexElement("Streams #", "%-20s (%s)", (uint32) pcap->streamManager.size());
+    general->AddItem({ "Workers", ls.Format("%s", nf.ToString(statistics.workers, dec).data()) });
+    general->AddItem({ "Duration", ls.Format("%s ms", nf.ToString(statistics.durationMs, dec).data()) });
+
+    const auto packetsPerSecond = (uint64) statistics.packets * 1000 / std::max<uint64>(statistics.durationMs, 1);
+    general->AddItem({ "Packets/s", ls.Format("%s", nf.ToString(packetsPerSecond, dec).data()) }).SetType(ListViewItem::Type::Emphasized_2);
 }
 
 void Information::UpdatePcapHeader()
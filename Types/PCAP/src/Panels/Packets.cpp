@@ -16,6 +16,8 @@ enum class ObjectAction : int32
     OpenPacket = 8,
 };
 
+constexpr uint64 INVALID_PACKET_INDEX = static_cast<uint64>(-1);
+
 Packets::Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> _win) : TabPage("&Packets")
 {
     pcap = _pcap;
@@ -48,19 +50,19 @@ std::string_view Packets::GetValue(NumericFormatter& n, uint64 value)
 
 void Panels::Packets::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
+    const auto index = list->GetCurrentItem().GetData(INVALID_PACKET_INDEX);
+    CHECKRET(index < pcap->packetHeaders.size(), "");
 
-    win->GetCurrentView()->GoTo(offset);
+    win->GetCurrentView()->GoTo(pcap->packetHeaders[index].offset);
 }
 
 void Panels::Packets::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
-    const auto size   = record->first->inclLen + sizeof(PacketHeader);
+    const auto index = list->GetCurrentItem().GetData(INVALID_PACKET_INDEX);
+    CHECKRET(index < pcap->packetHeaders.size(), "");
 
-    win->GetCurrentView()->Select(offset, size);
+    const auto& record = pcap->packetHeaders[index];
+    win->GetCurrentView()->Select(record.offset, record.header.inclLen + sizeof(PacketHeader));
 }
 
 std::string_view Packets::PacketDialog::GetValue(NumericFormatter& n, uint64 value)
@@ -690,8 +692,19 @@ Panels::Packets::PacketDialog::PacketDialog(
 
 void Panels::Packets::OpenPacket()
 {
-    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto& packet = itemData->first;
+    const auto index = list->GetCurrentItem().GetData(INVALID_PACKET_INDEX);
+    CHECKRET(index < pcap->packetHeaders.size(), "");
+
+    // the dialog parses the header and the packet bytes as one block (header in native byte order)
+    const auto data = pcap->GetPacketData(static_cast<uint32>(index));
+    Buffer packetBuffer;
+    packetBuffer.Resize(sizeof(PacketHeader) + data.GetLength());
+    memcpy(packetBuffer.GetData(), &pcap->packetHeaders[index].header, sizeof(PacketHeader));
+    if (data.GetLength() > 0)
+    {
+        memcpy(packetBuffer.GetData() + sizeof(PacketHeader), data.GetData(), data.GetLength());
+    }
+    const auto packet = reinterpret_cast<const PacketHeader*>(packetBuffer.GetData());
 
     LocalString<128> ls;
     ls.Format("d:c,w:80,h:50", this->GetHeight());
@@ -708,22 +721,21 @@ void Panels::Packets::Update()
 
     for (auto i = 0ULL; i < pcap->packetHeaders.size(); i++)
     {
-        auto& record                 = pcap->packetHeaders[i];
-        const auto& [header, offset] = record;
+        const auto& header = pcap->packetHeaders[i].header;
 
-        auto timestamp = header->tsSec * (uint64) 1000000 + header->tsUsec;
+        auto timestamp = header.tsSec * (uint64) 1000000 + header.tsUsec;
         timestamp /= 1000000;
         AppCUI::OS::DateTime dt;
         dt.CreateFromTimestamp(timestamp);
 
         auto item = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
         item.SetText(1, tmp.Format("%s", dt.GetStringRepresentation().data()));
-        item.SetText(2, tmp.Format("%s", GetValue(n, header->tsSec).data()));
-        item.SetText(3, tmp.Format("%s", GetValue(n, header->tsUsec).data()));
-        item.SetText(4, tmp.Format("%s", GetValue(n, header->inclLen).data()));
-        item.SetText(5, tmp.Format("%s", GetValue(n, header->origLen).data()));
+        item.SetText(2, tmp.Format("%s", GetValue(n, header.tsSec).data()));
+        item.SetText(3, tmp.Format("%s", GetValue(n, header.tsUsec).data()));
+        item.SetText(4, tmp.Format("%s", GetValue(n, header.inclLen).data()));
+        item.SetText(5, tmp.Format("%s", GetValue(n, header.origLen).data()));
 
-        item.SetData<std::pair<PacketHeader*, uint32>>(&record);
+        item.SetData(i);
     }
 }
 
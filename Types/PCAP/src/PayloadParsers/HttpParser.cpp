@@ -27,38 +27,44 @@ void GetFileExtracted(StreamTcpLayer& output)
 
 PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformation& payloadInformation, ConnectionCallbackInterface* callbackInterface)
 {
-    const auto connPayload = payloadInformation.payload;
-    if (payloadInformation.payload->size < 3)
+    auto& connPayload = *payloadInformation.payload;
+    const auto size   = connPayload.GetSize();
+    if (size < 3)
         return nullptr;
+    uint8 c = 0;
     for (int i = 0; i < 3; i++)
-        if (!isalpha(connPayload->location[i]))
+        if (!connPayload.GetByte(i, c) || !isalpha(c))
             return nullptr;
 
     auto& applicationLayers = callbackInterface->GetApplicationLayers();
 
-    uint8 buffer[300]     = {};
-    uint32 bufferSize     = 0;
-    const uint8* startPtr = connPayload->location;
-    const uint8* endPtr   = connPayload->location + connPayload->size;
-    bool wasEndline       = false;
-    uint32 spaces         = 0;
+    // the stream is walked byte by byte - PayloadStream only keeps a window of it in memory
+    uint8 buffer[300] = {};
+    uint32 bufferSize = 0;
+    uint64 position   = 0;
+    bool wasEndline   = false;
+    uint32 spaces     = 0;
 
     bool identified = false;
 
     StreamTcpLayer layer = {};
 
-    while (startPtr < endPtr) {
-        if (*startPtr == 0x0D || *startPtr == 0x0a) {
+    while (position < size) {
+        if (!connPayload.GetByte(position, c))
+            break;
+        if (c == 0x0D || c == 0x0a) {
             wasEndline = true;
             ++spaces;
         } else if (wasEndline) {
             if (spaces >= 4) {
                 if (identified) {
                     if (layer.payload.size) {
-                        layer.payload.location = (uint8*) startPtr;
-                        // push
+                        // the body stays in the capture, only its position in the stream is kept
+                        layer.payload.offset = position;
+                        if (layer.payload.size > size - position)
+                            layer.payload.size = (uint32) (size - position);
 
-                        startPtr += layer.payload.size;
+                        position += layer.payload.size;
                         bufferSize         = 0;
                         buffer[bufferSize] = '\0';
                         identified         = false;
@@ -111,17 +117,17 @@ PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformat
 
             if (bufferSize >= maxWaitUntilEndLine - 1)
                 break;
-            buffer[bufferSize++] = *startPtr;
+            buffer[bufferSize++] = c;
         } else {
             if (bufferSize >= maxWaitUntilEndLine - 1)
                 return nullptr;
-            buffer[bufferSize++] = *startPtr;
+            buffer[bufferSize++] = c;
         }
 
-        startPtr++;
+        position++;
     }
 
-    if (startPtr >= endPtr) {
+    if (position >= size) {
         callbackInterface->AddConnectionAppLayerName("HTTP");
     }
 
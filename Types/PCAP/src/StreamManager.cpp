@@ -1,30 +1,224 @@
 #include "StreamManager.hpp"
 #include "Utils.hpp"
 
+#include <chrono>
+
 using namespace GView::Type::PCAP;
 
-void StreamData::ComputeFinalPayload()
+void StreamData::ComputeName()
+{
+    LocalString<64> addresses[2], ports[2];
+    NumericFormatter n;
+
+    const FlowEndpoint* endpoints[2] = { &flow.a, &flow.b };
+    for (uint32 i = 0; i < 2; i++)
+    {
+        if (static_cast<EtherType>(flow.ipProtocol) == EtherType::IPv4)
+        {
+            uint32 address;
+            memcpy(&address, endpoints[i]->address, sizeof(address));
+            Utils::IPv4ElementToStringNoHex(address, addresses[i]);
+        }
+        else
+        {
+            Utils::IPv6ElementToString(endpoints[i]->address, addresses[i]);
+        }
+        ports[i].Format("%s", n.ToString(endpoints[i]->port, { NumericFormatFlags::None, 10, 3, '.' }).data());
+    }
+
+    // named from the perspective of the endpoint that sent the first packet
+    const auto src = initiatedFromB ? 1 : 0;
+    const auto dst = 1 - src;
+    LocalString<256> streamName;
+    name = streamName.Format("%s:%s -> %s:%s", addresses[src].GetText(), ports[src].GetText(), addresses[dst].GetText(), ports[dst].GetText());
+}
+
+void StreamData::AppendChunk(uint8 direction, uint64 fileOffset, uint32 size)
+{
+    if (size == 0)
+        return;
+
+    // consecutive pieces of the same direction that are also consecutive in the file are merged
+    if (!chunks.empty())
+    {
+        auto& last = chunks.back();
+        if (last.direction == direction && last.fileOffset + last.size == fileOffset && last.size <= UINT32_MAX - size)
+        {
+            last.size += size;
+            totalPayload += size;
+            return;
+        }
+    }
+
+    chunks.push_back({ fileOffset, totalPayload, size, direction });
+    totalPayload += size;
+}
+
+void StreamData::DeliverPending(TCPReassemblyState& state, uint8 direction)
 {
-    if (totalPayload == 0)
+    while (!state.pending.empty())
+    {
+        auto it                  = state.pending.begin();
+        const auto segmentOffset = it->first;
+        const auto segment       = it->second;
+        if (segmentOffset > state.nextOffset)
+            return;
+        state.pending.erase(it);
+
+        // overlaps with what was already delivered are trimmed (the first copy wins)
+        const auto end = segmentOffset + segment.size;
+        if (end <= state.nextOffset)
+            continue;
+        const auto skip = static_cast<uint32>(state.nextOffset - segmentOffset);
+        AppendChunk(direction, segment.fileOffset + skip, segment.size - skip);
+        state.nextOffset = end;
+    }
+}
+
+void StreamData::AddTCPSegment(uint8 direction, uint32 seq, bool hasSynFlag, uint64 fileOffset, uint32 size)
+{
+    auto& state = reassembly[direction];
+
+    // the SYN consumes a sequence number => the data starts right after it
+    const auto dataSeq = hasSynFlag ? seq + 1 : seq;
+    if (!state.initialized)
+    {
+        // a capture might start in the middle of a connection - the first segment seen gives the origin
+        state.initialized = true;
+        state.initialSeq  = dataSeq;
+        state.nextOffset  = 0;
+    }
+
+    if (size == 0)
         return;
 
-    uint8* payload = new uint8[totalPayload];
+    const auto segmentOffset = state.ToRelative(dataSeq);
+    if (segmentOffset + static_cast<int64>(size) <= static_cast<int64>(state.nextOffset))
+        return; // retransmission of data already delivered
+
+    if (segmentOffset <= static_cast<int64>(state.nextOffset))
+    {
+        const auto skip = static_cast<uint32>(static_cast<int64>(state.nextOffset) - segmentOffset);
+        AppendChunk(direction, fileOffset + skip, size - skip);
+        state.nextOffset += size - skip;
+        DeliverPending(state, direction);
+        return;
+    }
+
+    // out of order - kept (only its location) until the missing bytes arrive; for duplicates the longest one is kept
+    auto& segment = state.pending[static_cast<uint64>(segmentOffset)];
+    if (segment.size < size)
+        segment = { fileOffset, size };
 
-    auto payloadPtr = payload;
-    for (const auto& packet : packetsOffsets)
-        if (packet.payload.location)
+    if (state.pending.size() > TCPReassemblyState::MAX_PENDING_SEGMENTS)
+    {
+        // the missing bytes were most likely never captured - skip the gap instead of buffering forever
+        const auto next = state.pending.begin()->first;
+        gapsFound++;
+        missingBytes += next - state.nextOffset;
+        state.nextOffset = next;
+        DeliverPending(state, direction);
+    }
+}
+
+void StreamData::AddDatagram(uint8 direction, uint64 fileOffset, uint32 size)
+{
+    // datagrams have no ordering information - they are delivered in capture order
+    AppendChunk(direction, fileOffset, size);
+}
+
+void StreamData::FinishReassembly()
+{
+    for (uint8 direction = 0; direction < 2; direction++)
+    {
+        auto& state = reassembly[direction];
+        while (!state.pending.empty())
         {
-            memcpy(payloadPtr, packet.payload.location, packet.payload.size);
-            payloadPtr += packet.payload.size;
+            const auto next = state.pending.begin()->first;
+            if (next > state.nextOffset)
+            {
+                gapsFound++;
+                missingBytes += next - state.nextOffset;
+                state.nextOffset = next;
+            }
+            DeliverPending(state, direction);
         }
+        state = {};
+    }
+    chunks.shrink_to_fit();
+}
+
+bool StreamData::ReadPayload(GView::Utils::DataCache& cache, uint64 offset, uint8* buffer, uint32 size) const
+{
+    CHECK(offset <= totalPayload && size <= totalPayload - offset, false, "");
+
+    auto it = std::upper_bound(
+          chunks.begin(), chunks.end(), offset, [](uint64 value, const StreamChunk& chunk) { return value < chunk.streamOffset; });
+    CHECK(it != chunks.begin(), false, "");
+    --it;
+
+    while (size > 0)
+    {
+        CHECK(it != chunks.end(), false, "");
+        const auto skip   = offset - it->streamOffset;
+        auto fileOffset   = it->fileOffset + skip;
+        const auto toCopy = static_cast<uint32>(std::min<uint64>(it->size - skip, size));
+
+        // the piece is read in cache sized parts - a chunk might be bigger than the cache
+        for (uint32 copied = 0; copied < toCopy;)
+        {
+            const auto part = std::min<uint32>(toCopy - copied, cache.GetCacheSize());
+            const auto view = cache.Get(fileOffset, part, true);
+            CHECK(view.IsValid(), false, "");
+            memcpy(buffer + copied, view.GetData(), part);
+            copied += part;
+            fileOffset += part;
+        }
+
+        buffer += toCopy;
+        offset += toCopy;
+        size -= toCopy;
+        ++it;
+    }
 
-    connPayload.size     = (uint32) totalPayload;
-    connPayload.location = payload;
+    return true;
+}
+
+PayloadStream::PayloadStream(const StreamData& stream, GView::Utils::DataCache& cache) : stream(stream), cache(cache), windowStart(0), windowSize(0)
+{
+}
 
-    //CallTransportLayerPlugins();
+uint64 PayloadStream::GetSize() const
+{
+    return stream.totalPayload;
 }
 
-void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet)
+bool PayloadStream::Read(uint64 offset, uint8* buffer, uint32 size)
+{
+    return stream.ReadPayload(cache, offset, buffer, size);
+}
+
+bool PayloadStream::GetByte(uint64 offset, uint8& value)
+{
+    if (offset < windowStart || offset >= windowStart + windowSize)
+    {
+        if (offset >= stream.totalPayload)
+            return false;
+
+        const auto size = static_cast<uint32>(std::min<uint64>(WINDOW_SIZE, stream.totalPayload - offset));
+        if (window.GetLength() < WINDOW_SIZE)
+            window.Resize(WINDOW_SIZE);
+        windowSize = 0;
+        CHECK(stream.ReadPayload(cache, offset, window.GetData(), size), false, "");
+        windowStart = offset;
+        windowSize  = size;
+    }
+
+    value = window.GetData()[offset - windowStart];
+    return true;
+}
+
+void StreamManager::Decode_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketSource& source)
 {
     auto pehRef = *peh;
     Swap(pehRef);
@@ -34,169 +228,257 @@ void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Pac
     {
         auto ipv4 = (IPv4Header*) ((uint8*) peh + sizeof(Package_EthernetHeader));
         packetData->linkLayer = { LinkType::IPV4, ipv4 };
-        Add_IPv4Header(packetData, ipv4, length - sizeof(Package_EthernetHeader), packet);
+        Decode_IPv4Header(packetData, ipv4, length - sizeof(Package_EthernetHeader), source);
     }
     else if (etherType == EtherType::IPv6)
     {
         auto ipv6 = (IPv6Header*) ((uint8*) peh + sizeof(Package_EthernetHeader));
         packetData->linkLayer = { LinkType::IPV6, ipv6 };
-        Add_IPv6Header(packetData, ipv6, length - sizeof(Package_EthernetHeader), packet);
+        Decode_IPv6Header(packetData, ipv6, length - sizeof(Package_EthernetHeader), source);
     }
 }
 
-void StreamManager::Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet)
+void StreamManager::Decode_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketSource& source)
 {
     if (pnh->family_ip == NULL_FAMILY_IP)
     {
         auto ipv4 = (IPv4Header*) ((uint8*) pnh + sizeof(Package_NullHeader));
         packetData->linkLayer = { LinkType::IPV4, ipv4 };
-        Add_IPv4Header(packetData, ipv4, length - sizeof(Package_NullHeader), packet);
+        Decode_IPv4Header(packetData, ipv4, length - sizeof(Package_NullHeader), source);
     }
 }
 
-void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet)
+void StreamManager::Decode_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketSource& source)
 {
+    if (packetInclLen < sizeof(IPv4Header))
+        return;
+
+    // the header might carry options and the frame might be padded (Ethernet pads small frames up to 60 bytes)
+    const size_t headerLength = ipv4->headerLength * 4;
+    if (headerLength < sizeof(IPv4Header) || headerLength > packetInclLen)
+        return;
+    const size_t totalLength = AppCUI::Endian::BigToNative(ipv4->totalLength);
+    if (totalLength >= headerLength && totalLength < packetInclLen)
+        packetInclLen = totalLength;
+
     if (ipv4->protocol == IP_Protocol::TCP)
     {
-        auto tcp = (TCPHeader*) ((uint8*) ipv4 + sizeof(IPv4Header));
+        auto tcp = (TCPHeader*) ((uint8*) ipv4 + headerLength);
         packetData->transportLayer = { IP_Protocol::TCP, tcp };
-        Add_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv4Header), ipv4, static_cast<uint32>(EtherType::IPv4), packet);
+        Decode_TCPHeader(packetData, tcp, packetInclLen - headerLength, ipv4, static_cast<uint32>(EtherType::IPv4), source);
     }
-    // TODO: add support for UDP streams
-    /*else if (ipv4->protocol == IP_Protocol::UDP)
+    else if (ipv4->protocol == IP_Protocol::UDP)
     {
-        auto udp = (UDPHeader*) ((uint8*) ipv4 + sizeof(IPv4Header), static_cast<uint32>(EtherType::IPv4));
-        Add_UDPHeader(udp);
-    }*/
+        auto udp = (UDPHeader*) ((uint8*) ipv4 + headerLength);
+        packetData->transportLayer = { IP_Protocol::UDP, udp };
+        Decode_UDPHeader(packetData, udp, packetInclLen - headerLength, ipv4, static_cast<uint32>(EtherType::IPv4), source);
+    }
 }
 
-void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet)
+void StreamManager::Decode_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketSource& source)
 {
+    if (packetInclLen < sizeof(IPv6Header))
+        return;
+
+    // a zero payload length means a jumbo payload - the captured length is used in that case
+    const size_t payloadLength = AppCUI::Endian::BigToNative(ipv6->payloadLength);
+    if (payloadLength > 0 && payloadLength < packetInclLen - sizeof(IPv6Header))
+        packetInclLen = payloadLength + sizeof(IPv6Header);
+
     if (ipv6->nextHeader == IP_Protocol::TCP)
     {
-        auto tcp = (TCPHeader*) ((uint8*) ipv6 + sizeof(IPv4Header));
+        auto tcp = (TCPHeader*) ((uint8*) ipv6 + sizeof(IPv6Header));
         packetData->transportLayer = { IP_Protocol::TCP, tcp };
-        Add_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), packet);
+        Decode_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), source);
     }
-    // TODO: add support for UDP streams
-    /*else if (ipv6->nextHeader == IP_Protocol::UDP)
+    else if (ipv6->nextHeader == IP_Protocol::UDP)
     {
         auto udp = (UDPHeader*) ((uint8*) ipv6 + sizeof(IPv6Header));
-        Add_UDPHeader(udp);
-    }*/
+        packetData->transportLayer = { IP_Protocol::UDP, udp };
+        Decode_UDPHeader(packetData, udp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), source);
+    }
 }
 
-void StreamManager::Add_TCPHeader(
-      PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet)
+bool StreamManager::GetFlowEndpoints(const void* ipHeader, uint32 ipProto, FlowEndpoint& source, FlowEndpoint& destination)
 {
-    const auto etherProto = static_cast<EtherType>(ipProto);
-    LocalString<64> srcIp, dstIp, srcPort, dstPort;
-    NumericFormatter n;
-    switch (etherProto)
+    // the flow table is keyed on the binary endpoints - names are formatted once per connection in ComputeName
+    source      = {};
+    destination = {};
+    switch (static_cast<EtherType>(ipProto))
     {
     case EtherType::IPv4:
     {
         auto* ip = (const IPv4Header*) ipHeader;
 
-        auto ipv4Ref = *ip;
-        Swap(ipv4Ref);
-
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.sourceAddress, srcIp);
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.destinationAddress, dstIp);
-        break;
+        const auto sourceAddress      = AppCUI::Endian::BigToNative(ip->sourceAddress);
+        const auto destinationAddress = AppCUI::Endian::BigToNative(ip->destinationAddress);
+        memcpy(source.address, &sourceAddress, sizeof(sourceAddress));
+        memcpy(destination.address, &destinationAddress, sizeof(destinationAddress));
+        return true;
     }
     case EtherType::IPv6:
     {
         auto* ip = (const IPv6Header*) ipHeader;
 
-        auto ipv6Ref = *ip;
-        Swap(ipv6Ref);
-
-        Utils::IPv6ElementToString(ipv6Ref.sourceAddress, srcIp);
-        Utils::IPv6ElementToString(ipv6Ref.destinationAddress, dstIp);
-        break;
+        for (uint32 i = 0; i < 8; i++)
+        {
+            source.address[i]      = AppCUI::Endian::BigToNative(ip->sourceAddress[i]);
+            destination.address[i] = AppCUI::Endian::BigToNative(ip->destinationAddress[i]);
+        }
+        return true;
     }
     default:
         // TODO: in the future add an error
-        return;
+        return false;
     }
+}
 
-    const bool hasRstFlag = (tcp->flags & RST) > 0;
-    const bool hasFinFlag = (tcp->flags & FIN) > 0;
-    const bool hasSynFlag = (tcp->flags & SYN) > 0;
+void StreamManager::Decode_TCPHeader(
+      PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& source)
+{
+    if (packetInclLen < sizeof(TCPHeader))
+        return;
+
+    FlowEndpoint sourceEndpoint, destinationEndpoint;
+    if (!GetFlowEndpoints(ipHeader, ipProto, sourceEndpoint, destinationEndpoint))
+        return;
 
     auto tcpRef = *tcp;
     Swap(tcpRef);
 
     const uint32 tcp_header_len = tcpRef.dataOffset * 4;
-    const uint32 options_len    = tcp_header_len - sizeof(TCPHeader);
 
     if (tcp_header_len < sizeof(TCPHeader))
         return; // err: TODO improve this later
 
-    StreamPayload payload{};
+    if (packetInclLen < tcp_header_len)
+        return;
+
+    auto& result         = *source.result;
+    result.payloadSize   = 0;
+    result.payloadOffset = 0;
     if (packetInclLen > tcp_header_len)
     {
-        payload.size     = static_cast<uint32>(packetInclLen) - tcp_header_len;
-        payload.location = ((uint8*) tcp + sizeof(TCPHeader) + options_len);
+        result.payloadSize   = static_cast<uint32>(packetInclLen) - tcp_header_len;
+        result.payloadOffset = source.dataOffset + ((const uint8*) tcp + tcp_header_len - source.data);
     }
 
-    srcPort.Format("%s", n.ToString(tcpRef.sPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
-    dstPort.Format("%s", n.ToString(tcpRef.dPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
+    sourceEndpoint.port      = tcpRef.sPort;
+    destinationEndpoint.port = tcpRef.dPort;
 
-    StreamData* streamToAddTo = nullptr;
+    result.fromB    = result.key.Set(sourceEndpoint, destinationEndpoint, (uint16) ipProto, IP_Protocol::TCP);
+    result.seq      = tcpRef.seq;
+    result.ack      = tcpRef.ack;
+    result.tcpFlags = tcp->flags;
+    result.valid    = true;
+}
 
-    LocalString<256> streamName;
-    streamName.Format("%s:%s -> %s:%s", dstIp.GetText(), dstPort.GetText(), srcIp.GetText(), srcPort.GetText());
-    auto revStream = streams.find(streamName.GetText());
-    if (revStream != streams.end())
+void StreamManager::Decode_UDPHeader(
+      PacketData* packetData, const UDPHeader* udp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& source)
+{
+    if (packetInclLen < sizeof(UDPHeader))
+        return;
+
+    FlowEndpoint sourceEndpoint, destinationEndpoint;
+    if (!GetFlowEndpoints(ipHeader, ipProto, sourceEndpoint, destinationEndpoint))
+        return;
+
+    sourceEndpoint.port      = AppCUI::Endian::BigToNative(udp->srcPort);
+    destinationEndpoint.port = AppCUI::Endian::BigToNative(udp->destPort);
+
+    // the datagram length covers the UDP header as well
+    size_t datagramLength = AppCUI::Endian::BigToNative(udp->length);
+    if (datagramLength < sizeof(UDPHeader) || datagramLength > packetInclLen)
+        datagramLength = packetInclLen;
+
+    auto& result         = *source.result;
+    result.payloadSize   = 0;
+    result.payloadOffset = 0;
+    if (datagramLength > sizeof(UDPHeader))
     {
-        if (!revStream->second.back().isFinished)
-            streamToAddTo = &revStream->second.back();
-        else
-        {
-            revStream->second.emplace_back();
-            streamToAddTo                    = &revStream->second.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
+        result.payloadSize   = static_cast<uint32>(datagramLength - sizeof(UDPHeader));
+        result.payloadOffset = source.dataOffset + ((const uint8*) udp + sizeof(UDPHeader) - source.data);
     }
-    else
+
+    result.fromB    = result.key.Set(sourceEndpoint, destinationEndpoint, (uint16) ipProto, IP_Protocol::UDP);
+    result.seq      = 0;
+    result.ack      = 0;
+    result.tcpFlags = 0;
+    result.valid    = true;
+}
+
+StreamData& StreamManager::GetStream(FlowTable& streams, const DecodedPacket& packet)
+{
+    // both directions of a connection end up in the same entry
+    auto& connections = streams[packet.key];
+    if (connections.empty() || connections.back().isFinished)
     {
-        const auto name     = streamName.Format("%s:%s -> %s:%s", srcIp.GetText(), srcPort.GetText(), dstIp.GetText(), dstPort.GetText());
-        auto& currentStream = streams[name.data()];
-        if (currentStream.empty())
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
-        streamToAddTo = &currentStream.back();
-        if (streamToAddTo->isFinished)
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
+        auto& connection             = connections.emplace_back();
+        connection.ipProtocol        = packet.key.ipProtocol;
+        connection.transportProtocol = packet.key.transportProtocol;
+        connection.flow              = packet.key;
+        connection.initiatedFromB    = packet.fromB;
     }
+    return connections.back();
+}
 
-    if (hasRstFlag)
-        streamToAddTo->isFinished = true;
-    if (hasFinFlag)
-        ++streamToAddTo->finFlagsFound;
-    if (hasSynFlag && streamToAddTo->finFlagsFound >= 2)
-        streamToAddTo->isFinished = true;
+void StreamManager::AddToStream(FlowTable& streams, const DecodedPacket& packet)
+{
+    StreamData* streamToAddTo = &GetStream(streams, packet);
+    const uint8 direction     = packet.fromB ? 1 : 0;
 
     StreamTCPOrder order{};
-    order.seqNumber   = tcp->seq;
-    order.ackNumber   = tcp->ack;
-    order.maxNumber   = std::max(tcp->seq, tcp->ack);
     order.packetIndex = (uint32) streamToAddTo->packetsOffsets.size();
 
-    streamToAddTo->totalPayload += payload.size;
-    streamToAddTo->packetsOffsets.push_back({ packet, payload, order, *packetData });
+    if (packet.key.transportProtocol == static_cast<uint8>(IP_Protocol::TCP))
+    {
+        const bool hasRstFlag = (packet.tcpFlags & RST) > 0;
+        const bool hasFinFlag = (packet.tcpFlags & FIN) > 0;
+        const bool hasSynFlag = (packet.tcpFlags & SYN) > 0;
+
+        if (hasRstFlag)
+            streamToAddTo->isFinished = true;
+        if (hasFinFlag)
+            ++streamToAddTo->finFlagsFound;
+        if (hasSynFlag && streamToAddTo->finFlagsFound >= 2)
+            streamToAddTo->isFinished = true;
+
+        order.seqNumber = packet.seq;
+        order.ackNumber = packet.ack;
+        order.maxNumber = std::max(packet.seq, packet.ack);
+
+        streamToAddTo->AddTCPSegment(direction, packet.seq, hasSynFlag, packet.payloadOffset, packet.payloadSize);
+    }
+    else
+    {
+        // an UDP flow is never finished - every datagram between the same endpoints belongs to it
+        streamToAddTo->AddDatagram(direction, packet.payloadOffset, packet.payloadSize);
+    }
+
+    streamToAddTo->packetsOffsets.push_back({ packet.index, packet.payloadOffset, packet.payloadSize, order });
+}
+
+void StreamManager::DecodePacket(const PacketEntry& entry, BufferView headers, LinkType network, DecodedPacket& result)
+{
+    // only the first bytes of the packet are read (all the headers are inside them) - that is why the lengths
+    // are taken from the packet header while the pointers are checked against what was read
+    result.valid = false;
+
+    const PacketSource source{ headers.GetData(), entry.GetDataOffset(), &result };
+    PacketData packetData = {};
+    packetData.packet     = &entry.header;
+    if (network == LinkType::ETHERNET && entry.header.inclLen >= sizeof(Package_EthernetHeader))
+    {
+        auto peh = (Package_EthernetHeader*) headers.GetData();
+        packetData.physicalLayer = { LinkType::ETHERNET, peh };
+        Decode_Package_EthernetHeader(&packetData, peh, entry.header.inclLen, source);
+    }
+    if (network == LinkType::NULL_ && entry.header.inclLen >= sizeof(Package_NullHeader))
+    {
+        auto pnh = (Package_NullHeader*) headers.GetData();
+        packetData.physicalLayer = { LinkType::NULL_, pnh };
+        Decode_Package_NullHeader(&packetData, pnh, entry.header.inclLen, source);
+    }
 }
 
 void StreamManager::AddToKnownProtocols(const std::string& layerName)
@@ -209,22 +491,91 @@ void StreamManager::AddToKnownProtocols(const std::string& layerName)
     protocolsFound.push_back(layerName);
 }
 
-void StreamManager::AddPacket(const PacketHeader* packet, LinkType network)
+bool StreamManager::AddPackets(const std::vector<PacketEntry>& packets, LinkType network)
 {
-    PacketData packetData = {};
-    packetData.packet     = packet;
-    if (network == LinkType::ETHERNET)
-    {
-        auto peh = (Package_EthernetHeader*) ((uint8*) packet + sizeof(PacketHeader));
-        packetData.physicalLayer = { LinkType::ETHERNET, peh };
-        Add_Package_EthernetHeader(&packetData, peh, packet->inclLen, packet);
-    }
-    if (network == LinkType::NULL_)
+    CHECK(window.IsValid(), false, "");
+
+    const auto start        = std::chrono::steady_clock::now();
+    const auto workersCount = GView::Utils::GetWorkersCount();
+    const auto packetsCount = static_cast<uint32>(packets.size());
+
+    // every worker reads through its own view of the object's cache
+    std::vector<GView::Utils::DataCache> views(workersCount);
+    for (auto& view : views)
+        CHECK(view.InitView(window->GetObject()->GetData()), false, "");
+
+    std::vector<FlowTable> shards(workersCount);
+    // decoded[block][shard] - the packets of a block (from the current batch) that belong to a shard, in capture order
+    const uint32 batchBlocks = workersCount * BLOCKS_PER_WORKER;
+    std::vector<std::vector<std::vector<DecodedPacket>>> decoded(batchBlocks, std::vector<std::vector<DecodedPacket>>(workersCount));
+
+    ProgressStatus::Init("Dissecting packets", packetsCount);
+    LocalString<128> ls;
+    NumericFormatter n;
+
+    bool completed    = true;
+    uint32 batchStart = 0; // the packets before it are dissected
+    while (batchStart < packetsCount)
     {
-        auto pnh = (Package_NullHeader*) ((uint8*) packet + sizeof(PacketHeader));
-        packetData.physicalLayer = { LinkType::NULL_, pnh };
-        Add_Package_NullHeader(&packetData, pnh, packet->inclLen, packet);
+        const auto batchEnd    = static_cast<uint32>(std::min<uint64>(static_cast<uint64>(batchStart) + batchBlocks * BLOCK_SIZE, packetsCount));
+        const auto blocksCount = (batchEnd - batchStart + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+        GView::Utils::ParallelFor(
+              blocksCount,
+              [&](uint32 block, uint32 workerIndex)
+              {
+                  auto& result = decoded[block];
+                  for (auto& shardPackets : result)
+                      shardPackets.clear();
+
+                  const auto first = batchStart + block * BLOCK_SIZE;
+                  const auto last  = std::min<uint32>(first + BLOCK_SIZE, batchEnd);
+                  DecodedPacket packet;
+                  for (uint32 i = first; i < last; i++)
+                  {
+                      const auto& entry = packets[i];
+                      if (entry.header.inclLen == 0)
+                          continue;
+
+                      const auto headers = views[workerIndex].Get(entry.GetDataOffset(), std::min<uint32>(entry.header.inclLen, MAX_HEADERS_SIZE), true);
+                      if (headers.GetLength() == 0)
+                          continue;
+
+                      packet.index = i;
+                      DecodePacket(entry, headers, network, packet);
+                      if (packet.valid)
+                          result[FlowKeyHash()(packet.key) % workersCount].push_back(packet);
+                  }
+              });
+
+        GView::Utils::ParallelFor(
+              workersCount,
+              [&](uint32 shard, uint32)
+              {
+                  for (uint32 block = 0; block < blocksCount; block++)
+                      for (const auto& packet : decoded[block][shard])
+                          AddToStream(shards[shard], packet);
+              });
+
+        batchStart = batchEnd;
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        const auto speed   = n.ToString(static_cast<uint64>(batchStart) * 1000 / std::max<uint64>(elapsed, 1), { NumericFormatFlags::None, 10, 3, ',' });
+        if (ProgressStatus::Update(batchStart, ls.Format("[%u/%u] packets (%s packets/s)", batchStart, packetsCount, speed.data())))
+        {
+            completed = false;
+            break;
+        }
     }
+    decoded.clear();
+
+    FinishedAdding(shards, views);
+
+    statistics.packets    = batchStart;
+    statistics.workers    = workersCount;
+    statistics.durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    return completed;
 }
 
 bool StreamManager::RegisterPayloadParser(unique_ptr<PayloadDataParserInterface> parser)
@@ -8,6 +8,10 @@
 
 #include "GView.hpp"
 
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace GView
 {
 namespace Type
@@ -380,6 +384,49 @@ namespace Type
 
 #pragma pack(pop) // Back to default packing
 
+        // O(1) lookup of the objects by (number, generation) - built once all the objects of the file are known
+        // an object redefined by an incremental update resolves to its newest definition (the one closest to the end of the file)
+        class ObjectsIndex
+        {
+            std::vector<PDFObject>* objects = nullptr;
+            std::unordered_map<ObjectNums, size_t, ObjectNumsHash> index;
+
+          public:
+            void Build(std::vector<PDFObject>& pdfObjects);
+            PDFObject* Find(const ObjectNums& key) const;
+            // a specific definition of the object (objects are sorted by their offset)
+            PDFObject* FindAt(const ObjectNums& key, uint64 startBuffer) const;
+            // position of that definition in the objects vector (or NOT_FOUND)
+            size_t PositionAt(const ObjectNums& key, uint64 startBuffer) const;
+
+            static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+        };
+
+        // streams are decoded only when they are needed (opened or used for metadata) and the results are kept here
+        // once the total size of the decoded data exceeds the limit, the least recently used streams are dropped
+        class DecodedStreamsCache
+        {
+            struct Entry {
+                uint64 streamOffset;
+                Buffer data;
+            };
+            std::list<Entry> entries; // most recently used first
+            std::unordered_map<uint64, std::list<Entry>::iterator> index;
+            uint64 totalSize = 0;
+            uint64 maxSize;
+
+          public:
+            static constexpr uint64 DEFAULT_MAX_SIZE = 64 * 1024 * 1024;
+
+            DecodedStreamsCache(uint64 maxSize = DEFAULT_MAX_SIZE) : maxSize(maxSize)
+            {
+            }
+
+            bool Get(uint64 streamOffset, Buffer& output);
+            void Add(uint64 streamOffset, const Buffer& data);
+            void Clear();
+        };
+
         class PDFFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
         {
           public:
@@ -393,7 +440,9 @@ namespace Type
             uint32 currentItemIndex = 0;
             std::vector<PDF::ObjectNode*> currentChildNodes;
             std::vector<PDFObject> pdfObjects;
-            std::vector<PDF::ObjectNums> processedObjects;
+            PDF::ObjectsIndex objectsIndex;
+            std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash> processedObjects;
+            DecodedStreamsCache decodedStreams;
             Reference<GView::Utils::SelectionZoneInterface> selectionZoneInterface;
             PDFStats pdfStats;
             MalformedStats malformedStats;
@@ -425,7 +474,9 @@ namespace Type
 
             // View::ContainerViewer::OpenItemInterface
             virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
-            void DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size);
+            bool DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size);
+            bool ReadStream(ObjectNode* node, Buffer& buffer);
+            bool GetDecodedStream(ObjectNode* node, Buffer& buffer);
 
             uint32 GetSelectionZonesCount() override
             {
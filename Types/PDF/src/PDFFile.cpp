@@ -40,6 +40,81 @@ void PDFFile::AddPDFObject(Reference<GView::Type::PDF::PDFFile> pdf, const PDFOb
     pdf->pdfObjects.insert(it, obj);
 }
 
+void ObjectsIndex::Build(std::vector<PDFObject>& pdfObjects)
+{
+    objects = &pdfObjects;
+    index.clear();
+    index.reserve(pdfObjects.size());
+    // the objects are sorted by offset => a later definition of the same object overwrites the previous ones
+    for (size_t i = 0; i < pdfObjects.size(); i++) {
+        index[{ pdfObjects[i].number, pdfObjects[i].generation }] = i;
+    }
+}
+
+PDFObject* ObjectsIndex::Find(const ObjectNums& key) const
+{
+    CHECK(objects, nullptr, "");
+    const auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    return &(*objects)[it->second];
+}
+
+PDFObject* ObjectsIndex::FindAt(const ObjectNums& key, uint64 startBuffer) const
+{
+    const auto position = PositionAt(key, startBuffer);
+    if (position == NOT_FOUND) {
+        return nullptr;
+    }
+    return &(*objects)[position];
+}
+
+size_t ObjectsIndex::PositionAt(const ObjectNums& key, uint64 startBuffer) const
+{
+    CHECK(objects, NOT_FOUND, "");
+    auto it = std::lower_bound(objects->begin(), objects->end(), startBuffer, [](const PDFObject& a, uint64 offset) { return a.startBuffer < offset; });
+    for (; it != objects->end() && it->startBuffer == startBuffer; ++it) {
+        if (it->number == key.obj && it->generation == key.gen) {
+            return static_cast<size_t>(it - objects->begin());
+        }
+    }
+    return NOT_FOUND;
+}
+
+bool DecodedStreamsCache::Get(uint64 streamOffset, Buffer& output)
+{
+    const auto it = index.find(streamOffset);
+    if (it == index.end()) {
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    output = it->second->data;
+    return true;
+}
+
+void DecodedStreamsCache::Add(uint64 streamOffset, const Buffer& data)
+{
+    if (data.GetLength() > maxSize || index.contains(streamOffset)) {
+        return;
+    }
+    while (!entries.empty() && totalSize + data.GetLength() > maxSize) {
+        totalSize -= entries.back().data.GetLength();
+        index.erase(entries.back().streamOffset);
+        entries.pop_back();
+    }
+    entries.push_front({ streamOffset, data });
+    index[streamOffset] = entries.begin();
+    totalSize += data.GetLength();
+}
+
+void DecodedStreamsCache::Clear()
+{
+    entries.clear();
+    index.clear();
+    totalSize = 0;
+}
+
 bool PDFFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
 {
     this->currentPath = path;
@@ -192,8 +267,9 @@ static bool IsValidXML(const std::vector<std::string>& dictionarySubtypes)
     return std::find(dictionarySubtypes.begin(), dictionarySubtypes.end(), KEY::PDF_XML) != dictionarySubtypes.end();
 }
 
-void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
+bool PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
 {
+    bool decoded = true;
     // decompress the stream
     // /DCTDecode -> LoadJPGToImage from JPG
     if (!node->decodeObj.filters.empty()) {
@@ -214,6 +290,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = decompressedData;
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::RUNLENGTH) {
                 Buffer runLengthDecompressed;
@@ -222,6 +299,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = runLengthDecompressed;
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::ASCIIHEX) {
                 String message;
@@ -233,6 +311,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = asciiHexDecompressed;
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::ASCII85) {
                 String message;
@@ -244,6 +323,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = ascii85Decompressed;
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::JPX) {
                 // this one has to be a separate plugin for JPEG2000
@@ -256,6 +336,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = jpxDecompressed;
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::LZW) {
                 Buffer lzwDecompressed;
@@ -271,6 +352,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = std::move(lzwDecompressed);
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             } else if (filter == PDF::FILTER::JBIG2) {
                 Buffer jbig2Decompressed;
@@ -279,10 +361,37 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     buffer = std::move(jbig2Decompressed);
                 } else {
                     Dialogs::MessageBox::ShowError("Error!", message);
+                    decoded = false;
                 }
             }
         }
     }
+    return decoded;
+}
+
+bool PDFFile::ReadStream(ObjectNode* node, Buffer& buffer)
+{
+    const uint64 start = node->decodeObj.streamOffsetStart;
+    const uint64 end   = node->decodeObj.streamOffsetEnd;
+    CHECK(end > start && end - start < 0xFFFFFFFF, false, "");
+
+    // not Get(): a stream can be larger than the cache of the file
+    buffer = this->obj->GetData().CopyToBuffer(start, static_cast<uint32>(end - start));
+    return buffer.IsValid();
+}
+
+bool PDFFile::GetDecodedStream(ObjectNode* node, Buffer& buffer)
+{
+    const uint64 key = node->decodeObj.streamOffsetStart;
+    if (decodedStreams.Get(key, buffer)) {
+        return true;
+    }
+    CHECK(ReadStream(node, buffer), false, "");
+    // a stream that failed to decode is not cached => the error is reported again next time
+    if (DecodeStream(node, buffer, buffer.GetLength())) {
+        decodedStreams.Add(key, buffer);
+    }
+    return true;
 }
 
 void PDFFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
@@ -297,37 +406,27 @@ void PDFFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
         return;
     }
 
-    const uint64 start = node->decodeObj.streamOffsetStart;
-    const uint64 end   = node->decodeObj.streamOffsetEnd;
-
-    if (end <= start) {
-        return;
-    }
-
-    const size_t size     = static_cast<size_t>(end - start);
-    const auto streamView = this->obj->GetData().Get(static_cast<uint32>(start), static_cast<uint32>(size), true);
-
-    if (!streamView.IsValid() || streamView.GetLength() < size) {
-        return;
-    }
-
-    Buffer buffer;
-    buffer = streamView;
-
     std::u16string tmpName = u"Stream ";
     tmpName += to_u16string((uint32_t) node->pdfObject.number);
 
     LocalUnicodeStringBuilder<64> streamName;
     CHECKRET(streamName.Set(tmpName), "");
 
+    Buffer buffer;
+
     // Encrypted fallback
     if (pdfStats.isEncrypted) {
+        if (!ReadStream(node, buffer)) {
+            return;
+        }
         Dialogs::MessageBox::ShowWarning("Warning!", "Unable to decompress the stream because the PDF is encrypted! Raw data will be displayed instead.");
         GView::App::OpenBuffer(buffer, streamName.ToStringView(), streamName.ToStringView(), GView::App::OpenMethod::BestMatch);
         return;
     }
 
-    DecodeStream(node, buffer, size);
+    if (!GetDecodedStream(node, buffer)) {
+        return;
+    }
 
     // PDF inside PDF
     constexpr const char pdfSig[] = "%PDF-";
@@ -1301,7 +1301,8 @@ bool GetObjectReference(
       uint8& buffer,
       std::vector<PDF::ObjectNums>& objectNums,
       uint64& outObjectNumber,
-      uint16& outGeneration)
+      uint16& outGeneration,
+      GView::Utils::ErrorList& errList)
 {
     uint64 pos            = objectOffset;
     const uint64 objStart = pos;
@@ -1329,12 +1330,6 @@ bool GetObjectReference(
         return false;
     }
 
-    if (gen64 > 65535) {
-        Dialogs::MessageBox::ShowError("Error!", "GetObjectReference - generation exceeds 65535");
-        return false;
-    }
-
-    uint16 gen = static_cast<uint16>(gen64);
     while (pos < dataSize && data.Copy(pos, buffer) && IsWhitespace(buffer)) {
         ++pos;
     }
@@ -1343,14 +1338,21 @@ bool GetObjectReference(
     }
 
     if (!data.Copy(pos, buffer)) {
-        Dialogs::MessageBox::ShowError("Error!", "GetObjectReference - Copy buffer error");
+        errList.AddError("Unable to read the reference to Object %llu (0x%llX)", (uint64_t) obj, (uint64_t) pos);
         return false;
     }
 
+    // two numbers that are not followed by 'R' are not a reference (e.g. the values of an array)
     if (buffer != PDF::KEY::PDF_INDIRECTOBJ) {
         return false;
     }
 
+    if (gen64 > 65535) {
+        errList.AddError("The generation number of the reference to Object %llu exceeds 65535 (0x%llX)", (uint64_t) obj, (uint64_t) genStart);
+        return false;
+    }
+
+    const uint16 gen = static_cast<uint16>(gen64);
     ++pos;
     outObjectNumber = obj;
     outGeneration   = gen;
@@ -1384,9 +1386,9 @@ uint64 GetLengthNumber(
       GView::Utils::DataCache& data,
       uint64& objectOffset,
       const uint64& dataSize,
-      std::vector<PDF::PDFObject>& pdfObjects,
-      const std::vector<PDF::ObjectNums>& processedObjects,
-      std::vector<PDF::ObjectNums>& objectNums)
+      const PDF::ObjectsIndex& objectsIndex,
+      std::vector<PDF::ObjectNums>& objectNums,
+      GView::Utils::ErrorList& errList)
 {
     uint64 numberLength = 0;
     uint8 buffer;
@@ -1397,18 +1399,18 @@ uint64 GetLengthNumber(
     uint64 copyOffset = objectOffset;
 
     if (!data.Copy(copyOffset, buffer)) {
-        Dialogs::MessageBox::ShowError("Error!", "Buffer copy failed!");
+        errList.AddError("Unable to read the /Length value (0x%llX)", (uint64_t) copyOffset);
     }
     copyOffset++;
     if (!data.Copy(copyOffset, buffer)) {
-        Dialogs::MessageBox::ShowError("Error!", "Buffer copy failed!");
+        errList.AddError("Unable to read the /Length value (0x%llX)", (uint64_t) copyOffset);
     }
 
     uint64 generation = 0;
     if (buffer == '0') {
         copyOffset += 2;
         if (!data.Copy(copyOffset, buffer)) {
-            Dialogs::MessageBox::ShowError("Error!", "Buffer copy failed!");
+            errList.AddError("Unable to read the /Length value (0x%llX)", (uint64_t) copyOffset);
         }
         if (buffer == PDF::KEY::PDF_INDIRECTOBJ) {
             foundRef = true;
@@ -1417,30 +1419,25 @@ uint64 GetLengthNumber(
 
     if (foundRef) {
         PDF::ObjectNums ref{ static_cast<uint32_t>(numberLength), static_cast<uint16_t>(generation) };
-        if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-            if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                objectNums.push_back(ref);
-            }
+        if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
+            objectNums.push_back(ref);
         }
     }
 
     if (foundRef) {
-        for (auto& object : pdfObjects) {
-            if (object.number == numberLength) {
-                uint64 refObjectOffset = object.startBuffer;
-                while (refObjectOffset <= object.endBuffer) {
-                    if (CheckType(data, refObjectOffset, PDF::KEY::PDF_OBJ_SIZE, PDF::KEY::PDF_OBJ)) {
-                        refObjectOffset += PDF::KEY::PDF_OBJ_SIZE;
-                        while (data.Copy(refObjectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
-                            refObjectOffset++;
-                        }
-                        numberLength = GetTypeValue(data, refObjectOffset, dataSize);
-                        break;
-                    } else {
+        if (const auto* object = objectsIndex.Find({ numberLength, static_cast<uint16>(generation) })) {
+            uint64 refObjectOffset = object->startBuffer;
+            while (refObjectOffset <= object->endBuffer) {
+                if (CheckType(data, refObjectOffset, PDF::KEY::PDF_OBJ_SIZE, PDF::KEY::PDF_OBJ)) {
+                    refObjectOffset += PDF::KEY::PDF_OBJ_SIZE;
+                    while (data.Copy(refObjectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
                         refObjectOffset++;
                     }
+                    numberLength = GetTypeValue(data, refObjectOffset, dataSize);
+                    break;
+                } else {
+                    refObjectOffset++;
                 }
-                break;
             }
         }
         objectOffset = copyOffset;
@@ -1457,16 +1454,6 @@ void InsertValuesIntoStats(std::vector<std::string>& stats, const std::vector<st
     stats.assign(uniqueFilters.begin(), uniqueFilters.end());
 }
 
-static PDF::PDFObject* FindObjectByNumber(std::vector<PDF::PDFObject>& pdfObjects, const uint64 number, const uint64 generation, const uint64 start)
-{
-    for (auto& obj : pdfObjects) {
-        if (obj.number == number && obj.generation == generation && obj.startBuffer == start) {
-            return &obj;
-        }
-    }
-    return nullptr;
-}
-
 static std::string MakeXMPDateReadable(const std::string& xmpDate)
 {
     if (xmpDate.size() < 19) {
@@ -1633,30 +1620,21 @@ void ExtractXMPMetadata(const Buffer& buffer, PDF::Metadata& pdfMetadata)
     }
 }
 
-void ProcessMetadataStream(Reference<GView::Type::PDF::PDFFile> pdf, GView::Utils::DataCache& data, PDF::ObjectNode* objectNode, PDF::Metadata& pdfMetadata)
+void ProcessMetadataStream(Reference<GView::Type::PDF::PDFFile> pdf, PDF::ObjectNode* objectNode, PDF::Metadata& pdfMetadata)
 {
     if (objectNode->pdfObject.hasStream) {
-        const uint64 offset = objectNode->decodeObj.streamOffsetStart;
-        const uint64 end    = objectNode->decodeObj.streamOffsetEnd;
-
-        if (end <= offset || end > data.GetEntireFile().GetLength()) {
-            return;
-        }
-        const size_t size = static_cast<size_t>(end - offset);
-
-        Buffer buffer;
-        buffer.Resize(size);
-        memcpy(buffer.GetData(), data.GetEntireFile().GetData() + offset, size);
-
         // encrypted -> can't open the stream, for now
         if (pdf->pdfStats.isEncrypted) {
             Dialogs::MessageBox::ShowWarning("Warning!", "Unable to decompress the stream because the PDF is encrypted! Raw data will be displayed instead.");
-            pdf->errList.AddError("Unable to decompress the stream because the PDF is encrypted (0x%llX)", (uint64_t) offset);
+            pdf->errList.AddError(
+                  "Unable to decompress the stream because the PDF is encrypted (0x%llX)", (uint64_t) objectNode->decodeObj.streamOffsetStart);
             return;
         }
-        // Decode the content of the stream based on the filters
-        pdf->DecodeStream(objectNode, buffer, size);
-        ExtractXMPMetadata(buffer, pdfMetadata);
+        // Decode the content of the stream based on the filters (this is the only stream decoded while the file is processed)
+        Buffer buffer;
+        if (pdf->GetDecodedStream(objectNode, buffer)) {
+            ExtractXMPMetadata(buffer, pdfMetadata);
+        }
     }
 }
 
@@ -1953,7 +1931,7 @@ static void FindAndProcessMetadataObjects(Reference<GView::Type::PDF::PDFFile> p
                 ProcessMetadataObject(data, node, pdf->pdfMetadata, pdf->errList);
             } else {
                 // stream <XML data> endstream
-                ProcessMetadataStream(pdf, data, &node, pdf->pdfMetadata);
+                ProcessMetadataStream(pdf, &node, pdf->pdfMetadata);
             }
             toFind.erase(it);
             if (toFind.empty()) {
@@ -1971,24 +1949,46 @@ static void FindAndProcessMetadataObjects(Reference<GView::Type::PDF::PDFFile> p
     searchTree(pdf->objectNodeRoot);
 }
 
-void ProcessPDFTree(
-      const uint64& dataSize,
-      GView::Utils::DataCache& data,
-      PDF::ObjectNode& objectNode,
-      vector<PDF::PDFObject>& pdfObjects,
-      vector<PDF::ObjectNums>& processedObjects,
-      PDF::PDFStats& pdfStats,
-      vector<PDF::ObjectNums>& metadataObjectNumbers,
-      GView::Utils::ErrorList& errList)
+struct ParsedReference {
+    PDF::ObjectNums nums;
+    bool ifNotProcessed; // dropped if the object was already processed when the parent is linked
+};
+
+// everything found in the dictionary of one object definition
+struct ParsedObject {
+    PDF::ObjectNode node; // the object, its decoding parameters and its stream (as a child)
+    std::vector<ParsedReference> references;
+    std::vector<PDF::ObjectNums> metadataReferences;
+    GView::Utils::ErrorList messages;
+    bool parsed = false;
+
+    ParsedObject()                    = default;
+    ParsedObject(const ParsedObject&) = delete;
+};
+
+static void AddParsedReferences(std::vector<PDF::ObjectNums>& found, std::vector<ParsedReference>& references, bool ifNotProcessed)
+{
+    for (const auto& ref : found) {
+        references.push_back({ ref, ifNotProcessed });
+    }
+    found.clear();
+}
+
+// parses the dictionary of an object definition (and locates its stream) - it only reads the file and the objects index
+// => the definitions can be parsed on different threads, each one with its own view of the data
+void ParsePDFObject(
+      const uint64& dataSize, GView::Utils::DataCache& data, const PDF::PDFObject& pdfObject, const PDF::ObjectsIndex& objectsIndex, ParsedObject& parsed)
 {
     // TODO: treat the other particular cases for getting the references of the objects
-    uint64 objectOffset = objectNode.pdfObject.startBuffer;
+    auto& objectNode    = parsed.node;
+    auto& errList       = parsed.messages;
+    uint64 objectOffset = pdfObject.startBuffer;
     uint8 buffer;
     uint64 streamLength = 0;
     bool foundLength    = false;
-    std::vector<PDF::ObjectNums> objectNums;
-    PDF::ObjectNums key{ objectNode.pdfObject.number, objectNode.pdfObject.generation };
-    processedObjects.push_back(key);
+    std::vector<PDF::ObjectNums> found; // references reported by the helpers
+
+    objectNode.pdfObject           = pdfObject;
     objectNode.pdfObject.hasStream = false;
 
     while (objectOffset < objectNode.pdfObject.endBuffer) {
@@ -2029,8 +2029,9 @@ void ProcessPDFTree(
                     break;
                 }
                 if (IsWhitespace(buffer)) {
-                    streamLength = GetLengthNumber(data, objectOffset, dataSize, pdfObjects, processedObjects, objectNums);
-                    foundLength  = true;
+                    streamLength = GetLengthNumber(data, objectOffset, dataSize, objectsIndex, found, errList);
+                    AddParsedReferences(found, parsed.references, true);
+                    foundLength = true;
                 } else {
                     objectOffset = copyObjectOffset;
                 }
@@ -2050,7 +2051,6 @@ void ProcessPDFTree(
             // /Filter
             else if (IsEqualType(decodedName, PDF::KEY::PDF_FILTER_SIZE, PDF::KEY::PDF_FILTER)) {
                 GetFilters(data, objectOffset, dataSize, objectNode.decodeObj.filters, errList);
-                InsertValuesIntoStats(pdfStats.filtersTypes, objectNode.decodeObj.filters);
             } else if (IsEqualType(decodedName, PDF::KEY::PDF_DECODEPARMS_SIZE, PDF::KEY::PDF_DECODEPARMS)) {
                 objectNode.decodeObj.decodeParams.hasDecodeParms = true;
             } else if (IsEqualType(decodedName, PDF::KEY::PDF_COLUMNS_SIZE, PDF::KEY::PDF_COLUMNS) && objectNode.decodeObj.decodeParams.hasDecodeParms) {
@@ -2141,11 +2141,9 @@ void ProcessPDFTree(
                           (uint64_t) objectNode.pdfObject.number,
                           (uint64_t) (copyTypeOffset));
                 }
-                InsertValuesIntoStats(pdfStats.dictionaryTypes, objectNode.pdfObject.dictionaryTypes);
                 objectOffset--;
             } else if (IsEqualType(decodedName, PDF::KEY::PDF_SUBTYPE_SIZE, PDF::KEY::PDF_SUBTYPE)) {
                 GetDictionaryType(data, objectOffset, dataSize, objectNode.pdfObject.dictionarySubtypes);
-                InsertValuesIntoStats(pdfStats.dictionarySubtypes, objectNode.pdfObject.dictionarySubtypes);
                 objectOffset--;
             } else if (IsEqualType(decodedName, PDF::KEY::PDF_JS_SIZE, PDF::KEY::PDF_JS)) {
                 objectOffset++;
@@ -2155,7 +2153,8 @@ void ProcessPDFTree(
                 if (IsDigit(buffer)) {
                     uint64 number     = 0;
                     uint16 generation = 0;
-                    GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation);
+                    GetObjectReference(dataSize, data, objectOffset, buffer, found, number, generation, errList);
+                    AddParsedReferences(found, parsed.references, false);
                     errList.AddWarning("Contains a JavaScript block (/JS) in the Object %llu", (uint64_t) number);
                 } else {
                     errList.AddWarning("Contains a JavaScript block (/JS) (0x%llX)", (uint64_t) objectOffset);
@@ -2220,17 +2219,11 @@ void ProcessPDFTree(
 
                 uint64 number     = 0;
                 uint16 generation = 0;
-                GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation);
+                GetObjectReference(dataSize, data, objectOffset, buffer, found, number, generation, errList);
+                AddParsedReferences(found, parsed.references, false);
                 PDF::ObjectNums ref{ number, generation };
-                if (std::find(metadataObjectNumbers.begin(), metadataObjectNumbers.end(), ref) == metadataObjectNumbers.end()) {
-                    metadataObjectNumbers.push_back(ref);
-                }
-
-                if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-                    if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                        objectNums.push_back(ref);
-                    }
-                }
+                parsed.metadataReferences.push_back(ref);
+                parsed.references.push_back({ ref, true });
             } else {
                 objectOffset--;
             }
@@ -2315,12 +2308,7 @@ void ProcessPDFTree(
                 }
             }
             if (foundObjRef) {
-                PDF::ObjectNums ref{ number, generation };
-                if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-                    if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                        objectNums.push_back(ref);
-                    }
-                }
+                parsed.references.push_back({ { number, generation }, true });
             } else {
                 objectOffset++;
             }
@@ -2329,7 +2317,71 @@ void ProcessPDFTree(
         }
     }
 
-    if (auto* found = FindObjectByNumber(pdfObjects, objectNode.pdfObject.number, objectNode.pdfObject.generation, objectNode.pdfObject.startBuffer)) {
+    parsed.parsed = true;
+}
+
+static ParsedObject* FindParsedObject(const PDF::ObjectsIndex& objectsIndex, std::vector<ParsedObject>& parsedObjects, const PDF::PDFObject& pdfObject)
+{
+    const auto position = objectsIndex.PositionAt({ pdfObject.number, pdfObject.generation }, pdfObject.startBuffer);
+    if (position >= parsedObjects.size() || !parsedObjects[position].parsed) {
+        return nullptr;
+    }
+    return &parsedObjects[position];
+}
+
+// links the (already parsed) objects into the tree - serial, the order of the visits decides where an object is placed
+void ProcessPDFTree(
+      const uint64& dataSize,
+      GView::Utils::DataCache& data,
+      PDF::ObjectNode& objectNode,
+      const PDF::ObjectsIndex& objectsIndex,
+      std::vector<ParsedObject>& parsedObjects,
+      std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash>& processedObjects,
+      PDF::PDFStats& pdfStats,
+      vector<PDF::ObjectNums>& metadataObjectNumbers,
+      GView::Utils::ErrorList& errList)
+{
+    PDF::ObjectNums key{ objectNode.pdfObject.number, objectNode.pdfObject.generation };
+    processedObjects.insert(key);
+
+    // a definition that is not part of the objects index is parsed right now
+    ParsedObject localParsed;
+    auto* parsed = FindParsedObject(objectsIndex, parsedObjects, objectNode.pdfObject);
+    if (!parsed) {
+        ParsePDFObject(dataSize, data, objectNode.pdfObject, objectsIndex, localParsed);
+        parsed = &localParsed;
+    }
+
+    objectNode.pdfObject = parsed->node.pdfObject;
+    objectNode.decodeObj = parsed->node.decodeObj;
+    objectNode.children.insert(objectNode.children.end(), parsed->node.children.begin(), parsed->node.children.end());
+
+    InsertValuesIntoStats(pdfStats.filtersTypes, objectNode.decodeObj.filters);
+    InsertValuesIntoStats(pdfStats.dictionaryTypes, objectNode.pdfObject.dictionaryTypes);
+    InsertValuesIntoStats(pdfStats.dictionarySubtypes, objectNode.pdfObject.dictionarySubtypes);
+    for (uint32 i = 0; i < parsed->messages.GetErrorsCount(); i++) {
+        errList.AddError("%s", parsed->messages.GetError(i).data());
+    }
+    for (uint32 i = 0; i < parsed->messages.GetWarningsCount(); i++) {
+        errList.AddWarning("%s", parsed->messages.GetWarning(i).data());
+    }
+    for (const auto& ref : parsed->metadataReferences) {
+        if (std::find(metadataObjectNumbers.begin(), metadataObjectNumbers.end(), ref) == metadataObjectNumbers.end()) {
+            metadataObjectNumbers.push_back(ref);
+        }
+    }
+
+    std::vector<PDF::ObjectNums> objectNums;
+    for (const auto& ref : parsed->references) {
+        if (ref.ifNotProcessed && processedObjects.contains(ref.nums)) {
+            continue;
+        }
+        if (std::find(objectNums.begin(), objectNums.end(), ref.nums) == objectNums.end()) {
+            objectNums.push_back(ref.nums);
+        }
+    }
+
+    if (auto* found = objectsIndex.FindAt(key, objectNode.pdfObject.startBuffer)) {
         found->hasStream          = objectNode.pdfObject.hasStream;
         found->filters            = objectNode.decodeObj.filters;
         found->dictionaryTypes    = objectNode.pdfObject.dictionaryTypes;
@@ -2338,28 +2390,49 @@ void ProcessPDFTree(
     }
 
     for (const auto& ref : objectNums) {
-        for (const auto& object : pdfObjects) {
-            if (ref.obj == object.number && ref.gen == object.generation) {
-                PDF::ObjectNode newObject;
-                newObject.pdfObject = object;
-                objectNode.children.push_back(newObject);
-            }
+        if (const auto* object = objectsIndex.Find(ref)) {
+            PDF::ObjectNode newObject;
+            newObject.pdfObject = *object;
+            objectNode.children.push_back(newObject);
         }
     }
     for (auto& child : objectNode.children) {
         PDF::ObjectNums key{ child.pdfObject.number, child.pdfObject.generation };
-        if (std::count(processedObjects.begin(), processedObjects.end(), key) == 0) {
-            ProcessPDFTree(dataSize, data, child, pdfObjects, processedObjects, pdfStats, metadataObjectNumbers, errList);
+        if (!processedObjects.contains(key)) {
+            ProcessPDFTree(dataSize, data, child, objectsIndex, parsedObjects, processedObjects, pdfStats, metadataObjectNumbers, errList);
         }
     }
 }
 
+static void ParseObjectsInParallel(Reference<PDF::PDFFile> pdf, std::vector<ParsedObject>& parsedObjects)
+{
+    auto& data            = pdf->obj->GetData();
+    const uint64 dataSize = data.GetSize();
+
+    // every worker reads through its own view of the object's cache
+    std::vector<GView::Utils::DataCache> views(GetWorkersCount());
+    for (auto& view : views) {
+        CHECKRET(view.InitView(data), "");
+    }
+
+    ParallelFor(static_cast<uint32>(pdf->pdfObjects.size()), [&](uint32 index, uint32 workerIndex) {
+        const auto& object = pdf->pdfObjects[index];
+        if (object.type == PDF::SectionPDFObjectType::Object || object.type == PDF::SectionPDFObjectType::CrossRefStream) {
+            ParsePDFObject(dataSize, views[workerIndex], object, pdf->objectsIndex, parsedObjects[index]);
+        }
+    });
+}
+
 static void ProcessPDF(Reference<PDF::PDFFile> pdf)
 {
     auto& data            = pdf->obj->GetData();
     const uint64 dataSize = data.GetSize();
     std::vector<PDF::ObjectNums> objectNums;
 
+    pdf->objectsIndex.Build(pdf->pdfObjects);
+    std::vector<ParsedObject> parsedObjects(pdf->pdfObjects.size());
+    ParseObjectsInParallel(pdf, parsedObjects);
+
     if (pdf->hasXrefTable) {
         bool firstTrailer = false;
         for (const auto& object : pdf->pdfObjects) {
@@ -2384,7 +2457,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                     } else if (IsDigit(buffer)) { // get the next object (nr 0 R)
                         uint64 objNum = 0;
                         uint16 genNum = 0;
-                        if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, objNum, genNum)) {
+                        if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, objNum, genNum, pdf->errList)) {
                             objectOffset++;
                         }
                     } else if (buffer == PDF::DC::SOLIDUS) {
@@ -2395,7 +2468,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                             copyObjectOffset++;
                             uint64 number     = 0;
                             uint16 generation = 0;
-                            if (GetObjectReference(dataSize, data, copyObjectOffset, buffer, objectNums, number, generation)) {
+                            if (GetObjectReference(dataSize, data, copyObjectOffset, buffer, objectNums, number, generation, pdf->errList)) {
                                 // only unique entries
                                 PDF::ObjectNums ref{ number, generation };
                                 if (std::find(pdf->metadataObjectNumbers.begin(), pdf->metadataObjectNumbers.end(), ref) == pdf->metadataObjectNumbers.end()) {
@@ -2451,7 +2524,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                     } else if (IsDigit(buffer)) { // get the next object (nr 0 R)
                         uint64 objNum = 0;
                         uint16 genNum = 0;
-                        if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, objNum, genNum)) {
+                        if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, objNum, genNum, pdf->errList)) {
                             objectOffset++;
                         }
                     } else if (data.Copy(objectOffset, buffer) && buffer == PDF::DC::SOLIDUS) {
@@ -2461,7 +2534,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                             GetFilters(data, objectOffset, dataSize, pdf->objectNodeRoot.decodeObj.filters, pdf->errList);
                             InsertValuesIntoStats(pdf->pdfStats.filtersTypes, pdf->objectNodeRoot.decodeObj.filters);
                         } else if (IsEqualType(decodedName, PDF::KEY::PDF_STREAM_LENGTH_SIZE, PDF::KEY::PDF_STREAM_LENGTH) && !foundLength) {
-                            streamLength = GetLengthNumber(data, objectOffset, dataSize, pdf->pdfObjects, pdf->processedObjects, objectNums);
+                            streamLength = GetLengthNumber(data, objectOffset, dataSize, pdf->objectsIndex, objectNums, pdf->errList);
                             foundLength  = true;
                         } else if (IsEqualType(decodedName, PDF::KEY::PDF_COLUMNS_SIZE, PDF::KEY::PDF_COLUMNS)) {
                             objectOffset += 1;
@@ -2496,7 +2569,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                             if (IsDigit(buffer)) {
                                 uint64 number     = 0;
                                 uint16 generation = 0;
-                                if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation)) {
+                                if (!GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation, pdf->errList)) {
                                     pdf->errList.AddWarning("Contains a JavaScript block (/JS) in the Object %llu", (uint64_t) number);
                                 } else {
                                     objectOffset++;
@@ -2551,7 +2624,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                             objectOffset++;
                             uint64 number     = 0;
                             uint16 generation = 0;
-                            if (GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation)) {
+                            if (GetObjectReference(dataSize, data, objectOffset, buffer, objectNums, number, generation, pdf->errList)) {
                                 // only unique entries
                                 PDF::ObjectNums ref{ number, generation };
                                 if (std::find(pdf->metadataObjectNumbers.begin(), pdf->metadataObjectNumbers.end(), ref) == pdf->metadataObjectNumbers.end()) {
@@ -2601,7 +2674,8 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
         }
     }
 
-    if (auto* found = FindObjectByNumber(pdf->pdfObjects, pdf->objectNodeRoot.pdfObject.number, pdf->objectNodeRoot.pdfObject.generation, pdf->objectNodeRoot.pdfObject.startBuffer)) {
+    const PDF::ObjectNums rootKey{ pdf->objectNodeRoot.pdfObject.number, pdf->objectNodeRoot.pdfObject.generation };
+    if (auto* found = pdf->objectsIndex.FindAt(rootKey, pdf->objectNodeRoot.pdfObject.startBuffer)) {
         found->filters            = pdf->objectNodeRoot.decodeObj.filters;
         found->dictionaryTypes    = pdf->objectNodeRoot.pdfObject.dictionaryTypes;
         found->dictionarySubtypes = pdf->objectNodeRoot.pdfObject.dictionarySubtypes;
@@ -2613,20 +2687,26 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
     std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash> insertedObjectIds;
 
     for (const auto& ref : objectNums) {
-        for (const auto& object : pdf->pdfObjects) {
-            if (ref.obj == object.number && ref.gen == object.generation) {
-                if (insertedObjectIds.insert(ref).second) {
-                    PDF::ObjectNode newObject;
-                    newObject.pdfObject = object;
-                    pdf->objectNodeRoot.children.push_back(newObject);
-                }
+        if (const auto* object = pdf->objectsIndex.Find(ref)) {
+            if (insertedObjectIds.insert(ref).second) {
+                PDF::ObjectNode newObject;
+                newObject.pdfObject = *object;
+                pdf->objectNodeRoot.children.push_back(newObject);
             }
         }
     }
 
     for (uint64 i = 0; i < pdf->objectNodeRoot.children.size(); i++) {
         ProcessPDFTree(
-              dataSize, data, pdf->objectNodeRoot.children[i], pdf->pdfObjects, pdf->processedObjects, pdf->pdfStats, pdf->metadataObjectNumbers, pdf->errList);
+              dataSize,
+              data,
+              pdf->objectNodeRoot.children[i],
+              pdf->objectsIndex,
+              parsedObjects,
+              pdf->processedObjects,
+              pdf->pdfStats,
+              pdf->metadataObjectNumbers,
+              pdf->errList);
     }
 
     // process the rest of the objects that don't have references
@@ -2634,12 +2714,13 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
     for (const auto& object : pdf->pdfObjects) {
         PDF::ObjectNums key{ object.number, object.generation };
         if (object.number != 0 && object.type != PDF::SectionPDFObjectType::CrossRefStream &&
-            std::count(pdf->processedObjects.begin(), pdf->processedObjects.end(), key) == 0) {
+            !pdf->processedObjects.contains(key)) {
             pdf->objectNodeRoot.children.emplace_back();
             auto& childNode = pdf->objectNodeRoot.children.back();
 
             childNode.pdfObject = object;
-            ProcessPDFTree(dataSize, data, childNode, pdf->pdfObjects, pdf->processedObjects, pdf->pdfStats, pdf->metadataObjectNumbers, pdf->errList);
+            ProcessPDFTree(
+                  dataSize, data, childNode, pdf->objectsIndex, parsedObjects, pdf->processedObjects, pdf->pdfStats, pdf->metadataObjectNumbers, pdf->errList);
         }
     }
 